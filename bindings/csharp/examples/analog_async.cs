@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+* In order to build the example, add libm2k-sharp.dll as a reference to the project.
+* For example, in the command line: mcs analog_async.cs -reference:libm2k-sharp.dll
+* Please make sure that libm2k-sharp.dll and libm2k-sharp-cxx-wrap.dll are in your build folder.
+* Please make sure that the location of libm2k is in the PATH.
+*
+* This example assumes the following connections:
+* W1 -> 1+
+* W2 -> 2+
+* GND -> 1-
+* GND -> 2-
+*
+* The application pushes a constant value on W1 and W2 and awaits a few acquisitions,
+* without keeping a thread blocked while the board is busy.
+*/
+
+using System;
+using System.Threading.Tasks;
+
+namespace examples
+{
+    class AnalogAsync
+    {
+        static async Task Run(M2k ctx)
+        {
+            M2kAnalogIn ain = ctx.getAnalogIn();
+            M2kAnalogOut aout = ctx.getAnalogOut();
+
+            ain.enableChannel(0, true);
+            ain.enableChannel(1, true);
+            ain.setSampleRate(100000);
+
+            aout.setSampleRate(0, 750000);
+            aout.setSampleRate(1, 750000);
+            aout.enableChannel(0, true);
+            aout.enableChannel(1, true);
+            aout.setCyclic(true);
+
+            var ch1 = new VectorD();
+            var ch2 = new VectorD();
+            var both = new VectorVectorD();
+            for (int i = 0; i < 1024; i++)
+            {
+                ch1.Add(2.0);
+                ch2.Add(-1.0);
+            }
+            both.Add(ch1);
+            both.Add(ch2);
+
+            await aout.pushAsync(both);
+
+            for (int i = 0; i < 5; i++)
+            {
+                VectorVectorD data = await ain.getSamplesAsync(10000);
+                Console.WriteLine("Buffer " + i + ": " + data[0][0] + " V, " + data[1][0] + " V");
+            }
+
+            aout.stop();
+        }
+
+        static void Main()
+        {
+            M2k ctx = libm2k.m2kOpen();
+            ctx.calibrateADC();
+            ctx.calibrateDAC();
+
+            Run(ctx).Wait();
+
+            libm2k.contextClose(ctx);
+        }
+    }
+}
@@ -273,12 +273,7 @@ void libm2k_analog_get_samples(uintptr_t _m2k_instance, double *analog_samples,
 	}
 	try {
 		libm2k::analog::M2kAnalogIn *analogIn = instance->getAnalogIn();
-		double *samps = (double *)analogIn->getSamplesInterleaved(nb_samples);
-		for (auto i = 0; i < 10; i++) {
-			auto v = samps[i];
-			printf("%f\n", samps[i]);
-		}
-		memcpy(analog_samples, samps, nb_samples * sizeof(double));
+		analogIn->getSamplesInterleavedInto(analog_samples, nb_samples / analogIn->getNbChannels());
 		return;
 	}
 	catch (std::exception &e) {
@@ -593,12 +588,7 @@ void libm2k_digital_get_samples(uintptr_t _m2k_instance, uint16_t *digital_sampl
 	}
 	try {
 		libm2k::digital::M2kDigital *digital = instance->getDigital();
-		uint16_t *samps = (uint16_t *)digital->getSamplesP(nb_samples);
-		for (auto i = 0; i < 10; i++) {
-			auto v = samps[i];
-			printf("%f\n", samps[i]);
-		}
-		memcpy(digital_samples, samps, nb_samples * sizeof(uint16_t));
+		digital->getSamplesInto(digital_samples, nb_samples);
 		return;
 	}
 	catch (std::exception &e) {
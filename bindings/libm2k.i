@@ -28,38 +28,69 @@
 
 %allowexception;
 
+#ifndef SWIGPYTHON
 %ignore pushInterleaved;
 %ignore pushRawInterleaved;
 %ignore pushBytes;
+#endif
 %ignore getVoltageP;
 %ignore getVoltageRawP;
 %ignore getSamplesRawInterleaved_matlab;
 %ignore getSamplesInterleaved_matlab;
+%ignore getSamplesInto;
+%ignore getSamplesInterleavedInto;
+%ignore getSamplesRawInterleavedInto;
+%ignore getSamplesInterleavedInto_matlab;
+%ignore getSamplesRawInterleavedInto_matlab;
+%ignore getSamplesRawInto;
+%ignore getBitPlanesInto;
+%ignore getChannelsInto;
+%ignore extractBitPlanes;
+%ignore extractChannels;
+%ignore subscribeSamples;
+%ignore setMonitorThreshold;
+%ignore watchContexts;
+%ignore libm2k::AsyncOperation::onComplete;
+%ignore libm2k::AsyncOperation::setFinished;
+%ignore libm2k::AsyncResult::setValue;
 %rename(pushBytes) push(unsigned short*, unsigned int);
 
 %ignore buildLoggingMessage;
 
 #ifdef SWIGPYTHON
-%typemap(in) short * {
+/* Accept bytes and any C-contiguous object exporting the buffer protocol
+ * (bytearray, array.array, numpy.ndarray) without copying the data */
+%typemap(in) short * (Py_buffer view, int has_view = 0) {
 	if (PyBytes_Check($input))
 	{
 		$1_ltype data = ($1_ltype)PyBytes_AsString($input);
 		$1 = data;
 	} else if (PyObject_CheckBuffer($input)) {
-		Py_buffer view;
-		if (PyObject_GetBuffer($input, &view, PyBUF_SIMPLE | PyBUF_C_CONTIGUOUS) == -1)
+		if (PyObject_GetBuffer($input, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1)
 		{
 			PyErr_SetString(PyExc_ValueError, "Failed to get buffer.");
-			return NULL;
+			SWIG_fail;
+		}
+		has_view = 1;
+		if (view.itemsize != 1 && view.itemsize != sizeof($*1_ltype)) {
+			PyErr_SetString(PyExc_ValueError, "Buffer item size does not match the expected sample type.");
+			SWIG_fail;
 		}
 		$1 = ($1_ltype)view.buf;
 
 	} else {
 		PyErr_SetString(PyExc_ValueError, "Expecting bytearray\n");
+		SWIG_fail;
+	}
+}
+%typemap(freearg) short * {
+	if (has_view$argnum) {
+		PyBuffer_Release(&view$argnum);
 	}
 }
 /* Apply all of the integer typemaps to double* and unsigned short * */
 %apply short * { unsigned short * };
+%apply short * { double *data };
 
 
 %typemap(out) short * getSamplesRawInterleaved {
@@ -70,19 +101,495 @@
 		char* end = (char*)(iio_buffer_end(buf));
 		auto size = (end - start);
 
-		// This is used when returning double*
-		if (sizeof($*1_ltype) != sizeof(short)) {
-			size = size * sizeof(float);
-		}
 		auto memory_view = PyMemoryView_FromMemory(start, size, PyBUF_WRITE);
 		auto res = PyMemoryView_GetContiguous(memory_view, PyBUF_READ, 'F');
+		Py_XDECREF(memory_view);
 		$result = res;
 	}
 }
 %apply short * getSamplesRawInterleaved {short * getSamplesInterleaved};
-%apply short * getSamplesRawInterleaved {double * getSamplesInterleaved};
 %apply short * getSamplesRawInterleaved {unsigned short * getSamplesP};
 
+/* The converted samples live in a heap array allocated by libm2k, not in the IIO buffer;
+ * the IIO buffer is only used to find out how many values were converted */
+%typemap(out) double * getSamplesInterleaved {
+	auto iio_obj = arg1->getIioObjects();
+	auto buf = iio_obj.buffers_rx[0];
+	if (buf) {
+		char* start = (char*)(iio_buffer_start(buf));
+		char* end = (char*)(iio_buffer_end(buf));
+		auto nb_values = (end - start) / sizeof(short);
+
+		auto bytes = PyBytes_FromStringAndSize((const char*)$1, nb_values * sizeof(double));
+		$result = bytes ? PyMemoryView_FromObject(bytes) : NULL;
+		Py_XDECREF(bytes);
+	}
+	delete[] $1;
+}
+
+%{
+	/* Wrap a bytearray holding samples into a typed (and optionally 2D) memoryview.
+	 * The memoryview keeps the bytearray alive, so the samples live as long as
+	 * any object (e.g. a numpy.ndarray) built on top of it. Steals the reference to mem. */
+	static PyObject *libm2k_samples_view(PyObject *mem, const char *format, Py_ssize_t rows, Py_ssize_t cols)
+	{
+		PyObject *view = PyMemoryView_FromObject(mem);
+		Py_DECREF(mem);
+		if (!view) {
+			return NULL;
+		}
+		PyObject *shaped;
+		if (rows > 0) {
+			shaped = PyObject_CallMethod(view, "cast", "s(nn)", format, rows, cols);
+		} else {
+			shaped = PyObject_CallMethod(view, "cast", "s", format);
+		}
+		Py_DECREF(view);
+		return shaped;
+	}
+
+	/* Release the GIL for the lifetime of the object. The destructor takes it back,
+	 * so the GIL is held again before any catch block touches the Python API. */
+	class LibM2kReleaseGIL {
+	public:
+		LibM2kReleaseGIL() : m_state(PyEval_SaveThread()) {}
+		~LibM2kReleaseGIL() { PyEval_RestoreThread(m_state); }
+	private:
+		LibM2kReleaseGIL(const LibM2kReleaseGIL &);
+		LibM2kReleaseGIL &operator=(const LibM2kReleaseGIL &);
+		PyThreadState *m_state;
+	};
+%}
+
+%extend libm2k::analog::M2kAnalogIn {
+	/**
+	* @brief Retrieve a specific number of samples from each channel as a numpy.ndarray
+	* of shape (channels, nb_samples) and dtype float64 (a memoryview if numpy is not installed)
+	*/
+	PyObject *getSamplesArray(unsigned int nb_samples)
+	{
+		Py_ssize_t nb_channels = $self->getNbChannels();
+		PyObject *mem = PyByteArray_FromStringAndSize(NULL, nb_channels * nb_samples * sizeof(double));
+		if (!mem) {
+			return NULL;
+		}
+		try {
+			LibM2kReleaseGIL nogil;
+			$self->getSamplesInto((double *)PyByteArray_AS_STRING(mem), nb_samples);
+		} catch (...) {
+			Py_DECREF(mem);
+			throw;
+		}
+		return libm2k_samples_view(mem, "d", nb_channels, nb_samples);
+	}
+
+	/**
+	* @brief Retrieve a specific number of raw samples from each channel as a numpy.ndarray
+	* of shape (channels, nb_samples) and dtype int16 (a memoryview if numpy is not installed)
+	*/
+	PyObject *getSamplesRawArray(unsigned int nb_samples)
+	{
+		Py_ssize_t nb_channels = $self->getNbChannels();
+		PyObject *mem = PyByteArray_FromStringAndSize(NULL, nb_channels * nb_samples * sizeof(short));
+		if (!mem) {
+			return NULL;
+		}
+		try {
+			LibM2kReleaseGIL nogil;
+			$self->getSamplesRawInto((short *)PyByteArray_AS_STRING(mem), nb_samples);
+		} catch (...) {
+			Py_DECREF(mem);
+			throw;
+		}
+		return libm2k_samples_view(mem, "h", nb_channels, nb_samples);
+	}
+}
+
+%extend libm2k::digital::M2kDigital {
+	/**
+	* @brief Retrieve a specific number of samples as a numpy.ndarray
+	* of dtype uint16 (a memoryview if numpy is not installed)
+	*/
+	PyObject *getSamplesArray(unsigned int nb_samples)
+	{
+		PyObject *mem = PyByteArray_FromStringAndSize(NULL, (Py_ssize_t)nb_samples * sizeof(unsigned short));
+		if (!mem) {
+			return NULL;
+		}
+		try {
+			LibM2kReleaseGIL nogil;
+			$self->getSamplesInto((unsigned short *)PyByteArray_AS_STRING(mem), nb_samples);
+		} catch (...) {
+			Py_DECREF(mem);
+			throw;
+		}
+		return libm2k_samples_view(mem, "H", 0, 0);
+	}
+
+	/**
+	* @brief Retrieve a specific number of samples as a numpy.ndarray of shape (16, getBitPlaneSize(nb_samples))
+	* and dtype uint64, one packed bitstream for each channel (a memoryview if numpy is not installed)
+	*/
+	PyObject *getBitPlanesArray(unsigned int nb_samples)
+	{
+		Py_ssize_t plane_size = libm2k::digital::getBitPlaneSize(nb_samples);
+		PyObject *mem = PyByteArray_FromStringAndSize(NULL, 16 * plane_size * sizeof(unsigned long long));
+		if (!mem) {
+			return NULL;
+		}
+		try {
+			LibM2kReleaseGIL nogil;
+			$self->getBitPlanesInto((unsigned long long *)PyByteArray_AS_STRING(mem), nb_samples);
+		} catch (...) {
+			Py_DECREF(mem);
+			throw;
+		}
+		return libm2k_samples_view(mem, "Q", 16, plane_size);
+	}
+
+	/**
+	* @brief Retrieve a specific number of samples as a numpy.ndarray of shape (16, nb_samples)
+	* and dtype uint8, holding the value of each channel (a memoryview if numpy is not installed)
+	*/
+	PyObject *getChannelsArray(unsigned int nb_samples)
+	{
+		PyObject *mem = PyByteArray_FromStringAndSize(NULL, (Py_ssize_t)16 * nb_samples);
+		if (!mem) {
+			return NULL;
+		}
+		try {
+			LibM2kReleaseGIL nogil;
+			$self->getChannelsInto((unsigned char *)PyByteArray_AS_STRING(mem), nb_samples);
+		} catch (...) {
+			Py_DECREF(mem);
+			throw;
+		}
+		return libm2k_samples_view(mem, "B", 16, nb_samples);
+	}
+}
+
+%{
+	#include <libm2k/digital/bitplanes.hpp>
+
+	/* Split digital samples given as any C-contiguous uint16 buffer (e.g. a numpy.ndarray returned by
+	 * M2kDigital.getSamplesArray) into one packed bitstream (planes) or one byte array for each channel */
+	static PyObject *libm2k_split_channels(PyObject *samples, bool planes)
+	{
+		Py_buffer view;
+		if (PyObject_GetBuffer(samples, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1) {
+			return NULL;
+		}
+		if (view.itemsize != sizeof(unsigned short)) {
+			PyBuffer_Release(&view);
+			PyErr_SetString(PyExc_ValueError, "Expecting a buffer of 16-bit samples.");
+			return NULL;
+		}
+		unsigned int nb_samples = (unsigned int)(view.len / sizeof(unsigned short));
+		Py_ssize_t cols = planes ? libm2k::digital::getBitPlaneSize(nb_samples) : nb_samples;
+		Py_ssize_t item_size = planes ? sizeof(unsigned long long) : 1;
+		PyObject *mem = PyByteArray_FromStringAndSize(NULL, 16 * cols * item_size);
+		if (!mem) {
+			PyBuffer_Release(&view);
+			return NULL;
+		}
+		{
+			LibM2kReleaseGIL nogil;
+			if (planes) {
+				libm2k::digital::extractBitPlanes((const unsigned short *)view.buf, nb_samples,
+								  (unsigned long long *)PyByteArray_AS_STRING(mem));
+			} else {
+				libm2k::digital::extractChannels((const unsigned short *)view.buf, nb_samples,
+								 (unsigned char *)PyByteArray_AS_STRING(mem));
+			}
+		}
+		PyBuffer_Release(&view);
+		return libm2k_samples_view(mem, planes ? "Q" : "B", 16, cols);
+	}
+%}
+
+%inline %{
+	/**
+	* @brief Split digital samples into a numpy.ndarray of shape (16, getBitPlaneSize(nb_samples))
+	* and dtype uint64, one packed bitstream for each channel
+	*/
+	PyObject *extractBitPlanesArray(PyObject *samples)
+	{
+		return libm2k_split_channels(samples, true);
+	}
+
+	/**
+	* @brief Split digital samples into a numpy.ndarray of shape (16, nb_samples)
+	* and dtype uint8, holding the value of each channel
+	*/
+	PyObject *extractChannelsArray(PyObject *samples)
+	{
+		return libm2k_split_channels(samples, false);
+	}
+%}
+
+%{
+	#include <algorithm>
+	#include <memory>
+
+	/* Keep a reference to a Python callable inside a C++ callback; the reference can
+	 * be dropped from any thread, so the GIL is taken first */
+	static std::shared_ptr<PyObject> libm2k_callable_ref(PyObject *callable)
+	{
+		Py_INCREF(callable);
+		return std::shared_ptr<PyObject>(callable, [](PyObject *obj) {
+			PyGILState_STATE state = PyGILState_Ensure();
+			Py_DECREF(obj);
+			PyGILState_Release(state);
+		});
+	}
+
+	/* Call a Python callable from a libm2k background thread. Steals the reference to arg. */
+	static void libm2k_call(PyObject *callable, PyObject *arg)
+	{
+		PyObject *ret = NULL;
+		if (arg) {
+			ret = PyObject_CallFunctionObjArgs(callable, arg, NULL);
+			Py_DECREF(arg);
+		}
+		if (!ret) {
+			PyErr_Print();
+		}
+		Py_XDECREF(ret);
+	}
+%}
+
+%extend libm2k::AsyncOperation {
+	/* Call callback (on the thread finishing the operation, with the GIL held) once the operation is finished */
+	void _notify(PyObject *callback)
+	{
+		std::shared_ptr<PyObject> ref = libm2k_callable_ref(callback);
+		$self->onComplete([ref]() {
+			PyGILState_STATE state = PyGILState_Ensure();
+			libm2k_call(ref.get(), PyTuple_New(0));
+			PyGILState_Release(state);
+		});
+	}
+
+	%pythoncode %{
+	def __await__(self):
+	    return _libm2k_awaitable(self).__await__()
+	%}
+}
+
+%extend libm2k::analog::M2kAnalogIn {
+	libm2k::AsyncOperation _subscribeSamples(unsigned int nb_samples, PyObject *callback)
+	{
+		std::shared_ptr<PyObject> ref = libm2k_callable_ref(callback);
+		return $self->subscribeSamples(nb_samples, [ref](const std::vector<std::vector<double>> &data) {
+			PyGILState_STATE state = PyGILState_Ensure();
+			Py_ssize_t nb_channels = data.size();
+			Py_ssize_t nb = 0;
+			for (auto &chn : data) {
+				nb = std::max(nb, (Py_ssize_t)chn.size());
+			}
+			/* disabled channels come as empty vectors; they are set to 0, as in getSamplesArray */
+			PyObject *mem = PyByteArray_FromStringAndSize(NULL, nb_channels * nb * sizeof(double));
+			if (mem) {
+				double *dst = (double *)PyByteArray_AS_STRING(mem);
+				for (auto &chn : data) {
+					std::copy(chn.begin(), chn.end(), dst);
+					std::fill(dst + chn.size(), dst + nb, 0.0);
+					dst += nb;
+				}
+				mem = libm2k_samples_view(mem, "d", nb_channels, nb);
+			}
+			libm2k_call(ref.get(), mem);
+			PyGILState_Release(state);
+		});
+	}
+
+	%pythoncode %{
+	def streamSamples(self, nb_samples, max_pending=16):
+	    """Asynchronous generator which acquires buffers of nb_samples continuously in the background.
+
+	    Each buffer is an array of shape (channels, nb_samples), as returned by getSamplesArray.
+	    When the consumer falls behind by more than max_pending buffers, the oldest ones are dropped.
+	    """
+	    return _libm2k_stream(self, nb_samples, max_pending)
+	%}
+}
+
+%extend libm2k::digital::M2kDigital {
+	libm2k::AsyncOperation _subscribeSamples(unsigned int nb_samples, PyObject *callback)
+	{
+		std::shared_ptr<PyObject> ref = libm2k_callable_ref(callback);
+		return $self->subscribeSamples(nb_samples, [ref](const std::vector<unsigned short> &data) {
+			PyGILState_STATE state = PyGILState_Ensure();
+			PyObject *mem = PyByteArray_FromStringAndSize((const char *)data.data(),
+								      data.size() * sizeof(unsigned short));
+			if (mem) {
+				mem = libm2k_samples_view(mem, "H", 0, 0);
+			}
+			libm2k_call(ref.get(), mem);
+			PyGILState_Release(state);
+		});
+	}
+
+	%pythoncode %{
+	def streamSamples(self, nb_samples, max_pending=16):
+	    """Asynchronous generator which acquires buffers of nb_samples continuously in the background.
+
+	    When the consumer falls behind by more than max_pending buffers, the oldest ones are dropped.
+	    """
+	    return _libm2k_stream(self, nb_samples, max_pending)
+	%}
+}
+
+%extend libm2k::analog::M2kPowerSupply {
+	void _setMonitorThreshold(unsigned int chn, double min, double max, PyObject *callback)
+	{
+		std::shared_ptr<PyObject> ref = libm2k_callable_ref(callback);
+		$self->setMonitorThreshold(chn, min, max, [ref](unsigned int idx, double value) {
+			PyGILState_STATE state = PyGILState_Ensure();
+			PyObject *args = Py_BuildValue("(Id)", idx, value);
+			if (args) {
+				PyObject *ret = PyObject_CallObject(ref.get(), args);
+				Py_DECREF(args);
+				if (!ret) {
+					PyErr_Print();
+				}
+				Py_XDECREF(ret);
+			} else {
+				PyErr_Print();
+			}
+			PyGILState_Release(state);
+		});
+	}
+
+	%pythoncode %{
+	def setMonitorThreshold(self, chn, min, max, callback):
+	    """Call callback(chn, voltage) from the monitor thread when the voltage of chn leaves [min, max].
+
+	    The callback is called again only after the voltage returned inside the window.
+	    """
+	    return self._setMonitorThreshold(chn, min, max, callback)
+	%}
+}
+
+%pythoncode %{
+try:
+    import numpy as _numpy
+except ImportError:
+    _numpy = None
+
+
+def _libm2k_ndarray(view):
+    if _numpy is None or view is None:
+        return view
+    return _numpy.asarray(view)
+
+
+def _libm2k_interleave(data, dtype):
+    """Interleave a 2D numpy.ndarray (channels, samples) or a list of equally sized
+    1D numpy.ndarray objects; returns None if data is not made of numpy arrays"""
+    if _numpy is None:
+        return None
+    if isinstance(data, _numpy.ndarray) and data.ndim == 2:
+        return _numpy.ascontiguousarray(data.T, dtype=dtype)
+    if isinstance(data, (list, tuple)) and len(data) > 0 and \
+            all(isinstance(d, _numpy.ndarray) and d.ndim == 1 for d in data) and \
+            len(set(d.size for d in data)) == 1:
+        return _numpy.stack(data, axis=-1).astype(dtype, copy=False)
+    return None
+
+
+def _libm2k_awaitable(operation):
+    """asyncio future which completes with the result of a libm2k asynchronous operation"""
+    import asyncio
+    loop = asyncio.get_event_loop()
+    future = loop.create_future()
+
+    def _complete():
+        if future.cancelled():
+            return
+        try:
+            future.set_result(operation.get() if hasattr(operation, 'get') else operation.wait())
+        except Exception as e:
+            future.set_exception(e)
+
+    operation._notify(lambda: loop.call_soon_threadsafe(_complete))
+    return future
+
+
+async def _libm2k_stream(device, nb_samples, max_pending):
+    import asyncio
+    loop = asyncio.get_event_loop()
+    queue = asyncio.Queue()
+    end = object()
+
+    def _put(item):
+        if item is not end and queue.qsize() >= max_pending:
+            queue.get_nowait()
+        queue.put_nowait(item)
+
+    subscription = device._subscribeSamples(
+        nb_samples, lambda samples: loop.call_soon_threadsafe(_put, _libm2k_ndarray(samples)))
+    subscription._notify(lambda: loop.call_soon_threadsafe(_put, end))
+    try:
+        while True:
+            item = await queue.get()
+            if item is end:
+                # raises the error which stopped the acquisition, if any
+                subscription.wait()
+                return
+            yield item
+    finally:
+        device.unsubscribeSamples()
+%}
+
+%feature("pythonappend") libm2k::analog::M2kAnalogIn::getSamplesArray %{
+    val = _libm2k_ndarray(val)
+%}
+%feature("pythonappend") libm2k::analog::M2kAnalogIn::getSamplesRawArray %{
+    val = _libm2k_ndarray(val)
+%}
+%feature("pythonappend") libm2k::digital::M2kDigital::getSamplesArray %{
+    val = _libm2k_ndarray(val)
+%}
+%feature("pythonappend") libm2k::digital::M2kDigital::getBitPlanesArray %{
+    val = _libm2k_ndarray(val)
+%}
+%feature("pythonappend") libm2k::digital::M2kDigital::getChannelsArray %{
+    val = _libm2k_ndarray(val)
+%}
+%feature("pythonappend") extractBitPlanesArray %{
+    val = _libm2k_ndarray(val)
+%}
+%feature("pythonappend") extractChannelsArray %{
+    val = _libm2k_ndarray(val)
+%}
+
+/* Route numpy arrays to the pointer based push methods, so the samples
+ * are read in place instead of being copied into VectorD/VectorVectorD */
+%feature("pythonprepend") libm2k::analog::M2kAnalogOut::push %{
+    if len(args) == 2 and _numpy is not None and isinstance(args[1], _numpy.ndarray):
+        data = _numpy.ascontiguousarray(args[1], dtype=_numpy.float64)
+        return self.pushBytes(args[0], data, data.size)
+    if len(args) == 1:
+        data = _libm2k_interleave(args[0], _numpy.float64 if _numpy is not None else None)
+        if data is not None:
+            return self.pushInterleaved(data, data.shape[1], data.size)
+%}
+%feature("pythonprepend") libm2k::analog::M2kAnalogOut::pushRaw %{
+    if len(args) == 2 and _numpy is not None and isinstance(args[1], _numpy.ndarray):
+        data = _numpy.ascontiguousarray(args[1], dtype=_numpy.int16)
+        return self.pushRawBytes(args[0], data, data.size)
+    if len(args) == 1:
+        data = _libm2k_interleave(args[0], _numpy.int16 if _numpy is not None else None)
+        if data is not None:
+            return self.pushRawInterleaved(data, data.shape[1], data.size)
+%}
+%feature("pythonprepend") libm2k::digital::M2kDigital::push %{
+    if _numpy is not None and isinstance(data, _numpy.ndarray):
+        data = _numpy.ascontiguousarray(data, dtype=_numpy.uint16)
+        return self.pushBytes(data, data.size)
+%}
+
 #endif
 
 
@@ -99,6 +606,7 @@ namespace std {
 	%template(VectorI) vector<int>;
 	%template(VectorS) vector<short>;
 	%template(VectorUS) vector<unsigned short>;
+	%template(VectorULL) vector<unsigned long long>;
 	%template(VectorD) vector<double>;
 	%template(VectorStr) vector<string>;
 	%template(VectorVectorD) vector< vector<double> >;
@@ -118,6 +626,7 @@ namespace std {
 	#include <libm2k/m2kglobal.hpp>
 	#include <libm2k/enums.hpp>
 	#include <libm2k/utils/enums.hpp>
+	#include <libm2k/asyncresult.hpp>
 	#include <libm2k/analog/dmm.hpp>
 	#include <libm2k/analog/enums.hpp>
 	#include <libm2k/analog/genericanalogin.hpp>
@@ -128,6 +637,8 @@ namespace std {
 	#include <libm2k/analog/m2kpowersupply.hpp>
 
 	#include <libm2k/digital/enums.hpp>
+	#include <libm2k/digital/digitaltransitions.hpp>
+	#include <libm2k/digital/bitplanes.hpp>
 	#include <libm2k/digital/m2kdigital.hpp>
 
 	#include <libm2k/context.hpp>
@@ -138,6 +649,8 @@ namespace std {
 	#include <libm2k/m2kexceptions.hpp>
 	#include <libm2k/m2k.hpp>
 	#include <libm2k/generic.hpp>
+	#include <libm2k/tracing.hpp>
+	#include <libm2k/metrics.hpp>
 #ifdef COMMUNICATION
 	#include <libm2k/tools/spi.hpp>
 	#include <libm2k/tools/spi_extra.hpp>
@@ -145,6 +658,7 @@ namespace std {
 	#include <libm2k/tools/i2c_extra.hpp>
 	#include <libm2k/tools/uart.hpp>
 	#include <libm2k/tools/uart_extra.hpp>
+	#include <libm2k/tools/multibus.hpp>
 #endif
 	typedef std::vector<libm2k::analog::DMM_READING> DMMReading;
 	typedef std::vector<libm2k::analog::DMM*> DMMs;
@@ -218,6 +732,76 @@ namespace std {
 			return NULL;
 		}
 	}
+
+	/* Calls which block in libiio (buffer refill/push, calibration, bus transfers)
+	 * run without holding the GIL, so other Python threads keep running meanwhile.
+	 * Only the C++ call is wrapped: arguments are converted before and the result
+	 * after, both with the GIL held. */
+	%define LIBM2K_RELEASE_GIL(method)
+	%exception method {
+		try {
+			LibM2kReleaseGIL nogil;
+			$action
+		} catch (exception_type &e) {
+			std::string s("Module libm2k error: "), s2(e.what());
+			s = s + s2;
+			PyErr_SetString(PyExc_ValueError, s.c_str());
+			return NULL;
+		}
+	}
+	%enddef
+
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogIn::getSamples)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogIn::getSamplesRaw)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogIn::getSamplesInterleaved)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogIn::getSamplesRawInterleaved)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogIn::getVoltage)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogIn::getVoltageRaw)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogIn::getSegments)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogOut::push)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogOut::pushRaw)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogOut::pushBytes)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogOut::pushRawBytes)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogOut::pushInterleaved)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogOut::pushRawInterleaved)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kAnalogOut::pushWaveform)
+	LIBM2K_RELEASE_GIL(libm2k::digital::M2kDigital::getSamples)
+	LIBM2K_RELEASE_GIL(libm2k::digital::M2kDigital::getSamplesP)
+	LIBM2K_RELEASE_GIL(libm2k::digital::M2kDigital::push)
+	LIBM2K_RELEASE_GIL(libm2k::digital::M2kDigital::pushBytes)
+	LIBM2K_RELEASE_GIL(libm2k::digital::M2kDigital::pushPattern)
+	LIBM2K_RELEASE_GIL(libm2k::digital::M2kDigital::getTransitions)
+	LIBM2K_RELEASE_GIL(libm2k::digital::M2kDigital::getSegments)
+	LIBM2K_RELEASE_GIL(libm2k::context::M2k::calibrate)
+	LIBM2K_RELEASE_GIL(libm2k::context::M2k::calibrateADC)
+	LIBM2K_RELEASE_GIL(libm2k::context::M2k::calibrateDAC)
+	LIBM2K_RELEASE_GIL(libm2k::AsyncOperation::wait)
+	LIBM2K_RELEASE_GIL(libm2k::AsyncOperation::waitFor)
+	LIBM2K_RELEASE_GIL(libm2k::AsyncResult::get)
+	/* a Python thread may keep tracing while the trace is exported */
+	LIBM2K_RELEASE_GIL(libm2k::getChromeTrace)
+	LIBM2K_RELEASE_GIL(libm2k::writeChromeTrace)
+	/* closing a context joins the background threads of its instruments */
+	LIBM2K_RELEASE_GIL(libm2k::context::contextClose)
+	LIBM2K_RELEASE_GIL(libm2k::context::contextCloseAll)
+	/* stopping the context watcher joins the thread calling the Python callbacks */
+	LIBM2K_RELEASE_GIL(libm2k::context::unwatchContexts)
+	/* the power supply monitor calls Python threshold callbacks, which need the GIL */
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kPowerSupply::startMonitoring)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kPowerSupply::stopMonitoring)
+	LIBM2K_RELEASE_GIL(libm2k::analog::M2kPowerSupply::reset)
+	LIBM2K_RELEASE_GIL(libm2k::context::M2k::reset)
+#ifdef COMMUNICATION
+	LIBM2K_RELEASE_GIL(spi_write_and_read)
+	LIBM2K_RELEASE_GIL(spi_write_only)
+	LIBM2K_RELEASE_GIL(spi_write_and_read_samples)
+	LIBM2K_RELEASE_GIL(i2c_read)
+	LIBM2K_RELEASE_GIL(i2c_write)
+	LIBM2K_RELEASE_GIL(i2c_write_only)
+	LIBM2K_RELEASE_GIL(uart_read)
+	LIBM2K_RELEASE_GIL(uart_write)
+	LIBM2K_RELEASE_GIL(multibus_run)
+#endif
 #endif
 
 #ifdef SWIGCSHARP
@@ -232,10 +816,62 @@ namespace std {
 	}
 #endif
 
+#ifdef SWIGCSHARP
+/* Make the asynchronous handles awaitable. The state of the operation is polled,
+ * so no thread sits blocked while the operation is in progress. */
+%typemap(cscode) libm2k::AsyncOperation %{
+	public async System.Threading.Tasks.Task AsTask(int pollIntervalMs = 1)
+	{
+		while (!isReady()) {
+			await System.Threading.Tasks.Task.Delay(pollIntervalMs).ConfigureAwait(false);
+		}
+		wait();
+	}
+
+	public System.Runtime.CompilerServices.TaskAwaiter GetAwaiter()
+	{
+		return AsTask().GetAwaiter();
+	}
+%}
+
+%typemap(cscode) libm2k::AsyncResult<std::vector<std::vector<double>>> %{
+	public new async System.Threading.Tasks.Task<VectorVectorD> AsTask(int pollIntervalMs = 1)
+	{
+		while (!isReady()) {
+			await System.Threading.Tasks.Task.Delay(pollIntervalMs).ConfigureAwait(false);
+		}
+		return get();
+	}
+
+	public new System.Runtime.CompilerServices.TaskAwaiter<VectorVectorD> GetAwaiter()
+	{
+		return AsTask().GetAwaiter();
+	}
+%}
+
+%typemap(cscode) libm2k::AsyncResult<std::vector<unsigned short>> %{
+	public new async System.Threading.Tasks.Task<VectorUS> AsTask(int pollIntervalMs = 1)
+	{
+		while (!isReady()) {
+			await System.Threading.Tasks.Task.Delay(pollIntervalMs).ConfigureAwait(false);
+		}
+		return get();
+	}
+
+	public new System.Runtime.CompilerServices.TaskAwaiter<VectorUS> GetAwaiter()
+	{
+		return AsTask().GetAwaiter();
+	}
+%}
+#endif
+
 %include <std_shared_ptr.i>
 %include <libm2k/m2kglobal.hpp>
 %include <libm2k/enums.hpp>
 %include <libm2k/utils/enums.hpp>
+%include <libm2k/asyncresult.hpp>
+%template(AsyncSamples) libm2k::AsyncResult<std::vector<std::vector<double>>>;
+%template(AsyncDigitalSamples) libm2k::AsyncResult<std::vector<unsigned short>>;
 %include <libm2k/analog/dmm.hpp>
 %include <libm2k/analog/enums.hpp>
 %include <libm2k/analog/genericanalogin.hpp>
@@ -246,6 +882,8 @@ namespace std {
 %include <libm2k/analog/m2kpowersupply.hpp>
 
 %include <libm2k/digital/enums.hpp>
+%include <libm2k/digital/digitaltransitions.hpp>
+%include <libm2k/digital/bitplanes.hpp>
 %include <libm2k/digital/m2kdigital.hpp>
 
 %include <libm2k/context.hpp>
@@ -256,6 +894,8 @@ namespace std {
 %include <libm2k/m2kexceptions.hpp>
 %include <libm2k/m2k.hpp>
 %include <libm2k/generic.hpp>
+%include <libm2k/tracing.hpp>
+%include <libm2k/metrics.hpp>
 
 #ifdef COMMUNICATION
 %include <libm2k/tools/spi.hpp>
@@ -264,9 +904,21 @@ namespace std {
 %include <libm2k/tools/i2c_extra.hpp>
 %include <libm2k/tools/uart.hpp>
 %include <libm2k/tools/uart_extra.hpp>
+%include <libm2k/tools/multibus.hpp>
 #endif
 
+%template(CalibrationTimings) std::vector<libm2k::CALIBRATION_TIMING>;
 %template(DMMReading) std::vector<libm2k::analog::DMM_READING>;
+%template(DMMSamples) std::vector<libm2k::analog::DMM_SAMPLE>;
+%template(PowerSupplySamples) std::vector<libm2k::analog::POWER_SUPPLY_SAMPLE>;
+%template(PowerSupplySteps) std::vector<libm2k::analog::POWER_SUPPLY_STEP>;
+%template(WaveformTones) std::vector<libm2k::analog::WAVEFORM_TONE>;
+%template(Waveforms) std::vector<libm2k::analog::WAVEFORM>;
+%template(SequenceSegments) std::vector<libm2k::analog::SEQUENCE_SEGMENT>;
+%template(AnalogSegments) std::vector<libm2k::analog::ANALOG_SEGMENT>;
+%template(DigitalPatternSteps) std::vector<libm2k::digital::DIGITAL_PATTERN_STEP>;
+%template(DigitalTransitionList) std::vector<libm2k::digital::DIGITAL_TRANSITION>;
+%template(DigitalSegments) std::vector<libm2k::digital::DIGITAL_SEGMENT>;
 %template(DMMs) std::vector<libm2k::analog::DMM*>;
 %template(M2kAnalogIns) std::vector<libm2k::analog::M2kAnalogIn*>;
 %template(M2kAnalogOuts) std::vector<libm2k::analog::M2kAnalogOut*>;
@@ -274,9 +926,60 @@ namespace std {
 %template(M2kConditionDigital) std::vector<libm2k::M2K_TRIGGER_CONDITION_DIGITAL>;
 %template(M2kModes) std::vector<libm2k::M2K_TRIGGER_MODE>;
 %template(VectorCtxInfo) std::vector<libm2k::CONTEXT_INFO*>;
+%template(MetricSummaries) std::vector<libm2k::METRIC_SUMMARY>;
 
 #ifdef SWIGPYTHON
 	%template(IioBuffers) std::vector<iio_buffer*>;
 	%template(IioChannels) std::vector<iio_channel*>;
 	%template(IioDevices) std::vector<iio_device*>;
+
+%inline %{
+	unsigned int _watchContexts(PyObject *callback, unsigned int period_ms)
+	{
+		std::shared_ptr<PyObject> ref = libm2k_callable_ref(callback);
+		/* (re)starting the watcher joins the thread calling the Python callbacks */
+		LibM2kReleaseGIL nogil;
+		return libm2k::context::watchContexts([ref](const libm2k::CONTEXT_INFO &info, bool connected) {
+			PyGILState_STATE state = PyGILState_Ensure();
+			PyObject *pyinfo = SWIG_NewPointerObj(new libm2k::CONTEXT_INFO(info),
+							      SWIGTYPE_p_libm2k__CONTEXT_INFO, SWIG_POINTER_OWN);
+			PyObject *args = Py_BuildValue("(NO)", pyinfo, connected ? Py_True : Py_False);
+			if (args) {
+				PyObject *ret = PyObject_CallObject(ref.get(), args);
+				Py_DECREF(args);
+				if (!ret) {
+					PyErr_Print();
+				}
+				Py_XDECREF(ret);
+			} else {
+				PyErr_Print();
+			}
+			PyGILState_Release(state);
+		}, period_ms);
+	}
+%}
+
+%pythoncode %{
+import atexit as _atexit
+
+_libm2k_context_watches = set()
+
+
+def watchContexts(callback, period_ms=1000):
+    """Call callback(info, connected) from a background thread when a USB context is connected or disconnected.
+
+    Returns an identifier for unwatchContexts(). The watches still active are removed when the interpreter exits.
+    """
+    watch = _watchContexts(callback, period_ms)
+    _libm2k_context_watches.add(watch)
+    return watch
+
+
+def _libm2k_unwatch_all():
+    while _libm2k_context_watches:
+        unwatchContexts(_libm2k_context_watches.pop())
+
+
+_atexit.register(_libm2k_unwatch_all)
+%}
 #endif
@@ -1950,6 +1950,19 @@ validate(getSamplesDefinition);
 %    "	 be a multiple of 4 and greater than 16."); % <MLTYPE> can be "clib.array.libm2k.UnsignedShort", or "uint16"
 %validate(getSamplesPDefinition);
 
+%% C++ class method |getSamplesInto| for C++ class |libm2k::digital::M2kDigital| 
+% C++ Signature: void libm2k::digital::M2kDigital::getSamplesInto(unsigned short * data,unsigned int nb_samples)
+
+getSamplesIntoDefinition = addMethod(M2kDigitalDefinition, ...
+   "void libm2k::digital::M2kDigital::getSamplesInto(unsigned short * data,unsigned int nb_samples)", ...
+   "MATLABName", "getSamplesInto", ...
+   "Description", "getSamplesInto Method of C++ class libm2k::digital::M2kDigital." + newline + ...
+   "Retrieve a specific number of samples into a preallocated clib.array.libm2k.UnsignedShort", ...
+   "DetailedDescription", "This content is from the external library documentation."); % Modify help description values as needed.
+defineArgument(getSamplesIntoDefinition, "data", "clib.array.libm2k.UnsignedShort", "input", "nb_samples", "Description", "data Preallocated array that receives the samples");
+defineArgument(getSamplesIntoDefinition, "nb_samples", "uint32", "Description", "nb_samples The number of samples that will be retrieved");
+validate(getSamplesIntoDefinition);
+
 %% C++ class method |enableChannel| for C++ class |libm2k::digital::M2kDigital| 
 % C++ Signature: void libm2k::digital::M2kDigital::enableChannel(unsigned int index,bool enable)
 
@@ -2592,6 +2605,32 @@ validate(getSamplesInterleaved_matlabDefinition);
 %defineOutput(getSamplesRawInterleaved_matlabDefinition, "RetVal", "clib.array.libm2k.Short", <SHAPE>, "Description", "A pointer to the interleaved raw samples"); % <MLTYPE> can be "clib.array.libm2k.Short", or "int16"
 %validate(getSamplesRawInterleaved_matlabDefinition);
 
+%% C++ class method |getSamplesInterleavedInto_matlab| for C++ class |libm2k::analog::M2kAnalogIn| 
+% C++ Signature: void libm2k::analog::M2kAnalogIn::getSamplesInterleavedInto_matlab(double * data,unsigned int nb_samples)
+
+getSamplesInterleavedInto_matlabDefinition = addMethod(M2kAnalogInDefinition, ...
+   "void libm2k::analog::M2kAnalogIn::getSamplesInterleavedInto_matlab(double * data,unsigned int nb_samples)", ...
+   "MATLABName", "getSamplesInterleavedInto_matlab", ...
+   "Description", "getSamplesInterleavedInto_matlab Method of C++ class libm2k::analog::M2kAnalogIn." + newline + ...
+   "Retrieve a specific number of samples from both channels into a preallocated clib.array.libm2k.Double", ...
+   "DetailedDescription", "This content is from the external library documentation."); % Modify help description values as needed.
+defineArgument(getSamplesInterleavedInto_matlabDefinition, "data", "clib.array.libm2k.Double", "input", "nb_samples", "Description", "data Preallocated array that receives the interleaved samples");
+defineArgument(getSamplesInterleavedInto_matlabDefinition, "nb_samples", "uint32", "Description", "nb_samples The number of samples that will be retrieved");
+validate(getSamplesInterleavedInto_matlabDefinition);
+
+%% C++ class method |getSamplesRawInterleavedInto_matlab| for C++ class |libm2k::analog::M2kAnalogIn| 
+% C++ Signature: void libm2k::analog::M2kAnalogIn::getSamplesRawInterleavedInto_matlab(short * data,unsigned int nb_samples)
+
+getSamplesRawInterleavedInto_matlabDefinition = addMethod(M2kAnalogInDefinition, ...
+   "void libm2k::analog::M2kAnalogIn::getSamplesRawInterleavedInto_matlab(short * data,unsigned int nb_samples)", ...
+   "MATLABName", "getSamplesRawInterleavedInto_matlab", ...
+   "Description", "getSamplesRawInterleavedInto_matlab Method of C++ class libm2k::analog::M2kAnalogIn." + newline + ...
+   "Retrieve a specific number of raw samples from both channels into a preallocated clib.array.libm2k.Short", ...
+   "DetailedDescription", "This content is from the external library documentation."); % Modify help description values as needed.
+defineArgument(getSamplesRawInterleavedInto_matlabDefinition, "data", "clib.array.libm2k.Short", "input", "nb_samples", "Description", "data Preallocated array that receives the interleaved raw samples");
+defineArgument(getSamplesRawInterleavedInto_matlabDefinition, "nb_samples", "uint32", "Description", "nb_samples The number of samples that will be retrieved");
+validate(getSamplesRawInterleavedInto_matlabDefinition);
+
 %% C++ class method |getVoltageRaw| for C++ class |libm2k::analog::M2kAnalogIn| 
 % C++ Signature: short libm2k::analog::M2kAnalogIn::getVoltageRaw(unsigned int ch)
 
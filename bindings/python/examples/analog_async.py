@@ -0,0 +1,86 @@
+#
+# Copyright (c) 2026 Analog Devices Inc.
+#
+# This file is part of libm2k
+# (see http://www.github.com/analogdevicesinc/libm2k).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 2.1 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+
+# This example assumes the following connections:
+# W1 -> 1+
+# W2 -> 2+
+# GND -> 1-
+# GND -> 2-
+#
+# The application pushes a sine and a ramp without blocking, then awaits a single acquisition
+# and streams a few buffers, while another coroutine keeps the event loop busy meanwhile.
+
+import asyncio
+import libm2k
+import numpy as np
+
+
+async def heartbeat():
+	while True:
+		print("event loop is responsive")
+		await asyncio.sleep(0.5)
+
+
+async def main(ctx):
+	ain = ctx.getAnalogIn()
+	aout = ctx.getAnalogOut()
+	trig = ain.getTrigger()
+
+	ain.reset()
+	aout.reset()
+	ain.enableChannel(0, True)
+	ain.enableChannel(1, True)
+	ain.setSampleRate(100000)
+	trig.setAnalogMode(0, libm2k.ALWAYS)
+
+	aout.setSampleRate(0, 750000)
+	aout.setSampleRate(1, 750000)
+	aout.enableChannel(0, True)
+	aout.enableChannel(1, True)
+	aout.setCyclic(True)
+
+	beat = asyncio.ensure_future(heartbeat())
+
+	x = np.linspace(-np.pi, np.pi, 1024)
+	await aout.pushAsync([np.sin(x).tolist(), np.linspace(-2.0, 2.0, 1024).tolist()])
+
+	data = await ain.getSamplesAsync(100000)
+	print("single acquisition: %d samples on channel 0" % len(data[0]))
+
+	nb_buffers = 0
+	async for samples in ain.streamSamples(10000):
+		print("stream buffer %d: mean ch0 = %.3f V" % (nb_buffers, np.mean(samples[0])))
+		nb_buffers += 1
+		if nb_buffers == 5:
+			break
+
+	beat.cancel()
+	aout.stop()
+
+
+ctx = libm2k.m2kOpen()
+if ctx is None:
+	print("Connection Error: No ADALM2000 device available/connected to your PC.")
+	exit(1)
+
+ctx.calibrateADC()
+ctx.calibrateDAC()
+asyncio.get_event_loop().run_until_complete(main(ctx))
+libm2k.contextClose(ctx)
@@ -0,0 +1,95 @@
+#
+# Copyright (c) 2026 Analog Devices Inc.
+#
+# This file is part of libm2k
+# (see http://www.github.com/analogdevicesinc/libm2k).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 2.1 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+
+# Requirements: 2x ADALM2000
+#
+# The blocking libm2k calls (getSamples, push, SPI/I2C transfers, calibration) release the Python GIL
+# while they wait for the hardware. This benchmark acquires the same number of buffers from two M2Ks,
+# first one board after the other, then one thread per board, and prints the time taken by each run.
+# With the GIL released the threaded run takes roughly as long as a single board does.
+
+import libm2k
+import threading
+import time
+
+NB_BUFFERS = 20
+BUFFER_SIZE = 100000
+SAMPLERATE = 10000000
+
+
+def setup(ctx):
+	ain = ctx.getAnalogIn()
+	ain.reset()
+	ain.enableChannel(0, True)
+	ain.enableChannel(1, True)
+	ain.setSampleRate(SAMPLERATE)
+	ain.getTrigger().setAnalogMode(0, libm2k.ALWAYS)
+	return ain
+
+
+def acquire(ain, results, idx):
+	for i in range(NB_BUFFERS):
+		ain.getSamplesRaw(BUFFER_SIZE)
+	ain.stopAcquisition()
+	results[idx] = True
+
+
+uris = libm2k.getAllContexts()
+if len(uris) < 2:
+	print("This benchmark requires two ADALM2000 devices, found " + str(len(uris)))
+	exit(1)
+
+ctxs = [libm2k.m2kOpen(uri) for uri in uris[:2]]
+if None in ctxs:
+	print("Connection Error: could not open both ADALM2000 devices.")
+	exit(1)
+
+# Calibrating both boards at once is the first place where the released GIL pays off
+threads = [threading.Thread(target=ctx.calibrateADC) for ctx in ctxs]
+for t in threads:
+	t.start()
+for t in threads:
+	t.join()
+
+ains = [setup(ctx) for ctx in ctxs]
+results = [False, False]
+
+start = time.perf_counter()
+for idx, ain in enumerate(ains):
+	acquire(ain, results, idx)
+sequential = time.perf_counter() - start
+
+results = [False, False]
+threads = [threading.Thread(target=acquire, args=(ain, results, idx)) for idx, ain in enumerate(ains)]
+start = time.perf_counter()
+for t in threads:
+	t.start()
+for t in threads:
+	t.join()
+concurrent = time.perf_counter() - start
+
+nb_samples = NB_BUFFERS * BUFFER_SIZE * len(ains)
+print("Sequential: %.3f s (%.2f MS/s total)" % (sequential, nb_samples / sequential / 1e6))
+print("Threaded:   %.3f s (%.2f MS/s total)" % (concurrent, nb_samples / concurrent / 1e6))
+print("Speedup:    %.2fx" % (sequential / concurrent))
+if not all(results):
+	print("Warning: one of the acquisition threads did not finish")
+
+libm2k.contextCloseAll()
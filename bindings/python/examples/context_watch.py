@@ -0,0 +1,36 @@
+#
+# Copyright (c) 2026 Analog Devices Inc.
+#
+# This file is part of libm2k
+# (see http://www.github.com/analogdevicesinc/libm2k).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 2.1 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+
+
+# This example lists the ADALM2000 boards connected over USB and reports
+# the boards plugged in or unplugged during the next 30 seconds
+
+import time
+import libm2k
+
+for info in libm2k.getContextsInfo():
+	print("Found %s (serial %s) at %s" % (info.product, info.serial, info.uri))
+
+def on_change(info, connected):
+	print("%s %s (serial %s)" % ("Connected" if connected else "Disconnected", info.uri, info.serial))
+
+watch=libm2k.watchContexts(on_change, 500)
+time.sleep(30)
+libm2k.unwatchContexts(watch)
@@ -0,0 +1,54 @@
+#
+# Copyright (c) 2026 Analog Devices Inc.
+#
+# This file is part of libm2k
+# (see http://www.github.com/analogdevicesinc/libm2k).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 2.1 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+
+# This example assumes connection:
+# V+ to a load
+# This example turns on the positive supply, monitors it in the background
+# and reports when the output droops below 4.8V
+
+import time
+import libm2k
+
+ctx=libm2k.m2kOpen()
+if ctx is None:
+	print("Connection Error: No ADALM2000 device available/connected to your PC.")
+	exit(1)
+
+ctx.calibrateADC()
+ps=ctx.getPowerSupply()
+ps.reset()
+ps.enableChannel(0,True)
+ps.pushChannel(0,5)
+
+def on_droop(chn, voltage):
+	print("Channel %d left the window: %.3f V" % (chn, voltage))
+
+ps.setMonitorThreshold(0, 4.8, 5.2, on_droop)
+ps.startMonitoring(10)
+for i in range(10):
+	time.sleep(1)
+	samples=ps.readMonitorSamples()
+	stats=ps.getMonitorStatistics(0)
+	print("V+ min %.3f max %.3f mean %.3f, %d new samples" % (stats.min, stats.max, stats.mean, len(samples)))
+	if len(samples) > 0:
+		print("Last sample at %f: %.3f V" % (samples[-1].timestamp, samples[-1].values[0]))
+ps.stopMonitoring()
+
+libm2k.contextClose(ctx)
@@ -0,0 +1,64 @@
+#
+# Copyright (c) 2026 Analog Devices Inc.
+#
+# This file is part of libm2k
+# (see http://www.github.com/analogdevicesinc/libm2k).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 2.1 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+
+# This example assumes connection:
+# V+ and V- to the supply pins of a DUT
+# This example powers up a dual supply DUT: V+ ramps to 3.3V, then V- ramps to -3.3V
+# once V+ is in regulation; afterwards both rails ramp down in the reverse order
+
+import libm2k
+
+def step(channel, target, slew_rate, dwell=0, tolerance=0, settle_timeout=0):
+	s=libm2k.POWER_SUPPLY_STEP()
+	s.channel=channel
+	s.target=target
+	s.slew_rate=slew_rate
+	s.dwell=dwell
+	s.tolerance=tolerance
+	s.settle_timeout=settle_timeout
+	return s
+
+ctx=libm2k.m2kOpen()
+if ctx is None:
+	print("Connection Error: No ADALM2000 device available/connected to your PC.")
+	exit(1)
+
+ctx.calibrateADC()
+ps=ctx.getPowerSupply()
+ps.reset()
+ps.pushChannel(0,0)
+ps.pushChannel(1,0)
+ps.enableChannel(0,True)
+ps.enableChannel(1,True)
+
+power_up=[step(0, 3.3, 5, dwell=0.05, tolerance=0.1, settle_timeout=0.5),
+	  step(1, -3.3, 5, dwell=0.05, tolerance=0.1, settle_timeout=0.5)]
+try:
+	ps.runSequence(power_up).wait()
+	print("DUT powered: V+ %.3f V, V- %.3f V" % (ps.readChannel(0), ps.readChannel(1)))
+except Exception as e:
+	print("Power up failed: %s" % e)
+	ps.cancelSequence()
+
+ps.runSequence([step(1, 0, 5), step(0, 0, 5)]).wait()
+ps.enableChannel(0,False)
+ps.enableChannel(1,False)
+
+libm2k.contextClose(ctx)
@@ -0,0 +1,81 @@
+#
+# Copyright (c) 2026 Analog Devices Inc.
+#
+# This file is part of libm2k
+# (see http://www.github.com/analogdevicesinc/libm2k).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 2.1 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+
+
+
+# This benchmark measures the latency of SPI register reads, as done by firmware bring-up scripts.
+# Connect DIO 2 (MOSI) to DIO 7 (MISO): each transfer reads back the bytes it sends.
+# The latency of each transaction is measured on the host and by libm2k (spi_transfer metric).
+
+import time
+import libm2k
+
+TRANSFERS = 1000
+SPI_SPEED = 1000000
+
+ctx=libm2k.m2kOpen()
+if ctx is None:
+	print("Connection Error: No ADALM2000 device available/connected to your PC.")
+	exit(1)
+
+m2k_spi_init = libm2k.m2k_spi_init()
+m2k_spi_init.clock = 1
+m2k_spi_init.mosi = 2
+m2k_spi_init.miso = 7
+m2k_spi_init.bit_numbering = libm2k.MSB
+m2k_spi_init.cs_polarity = libm2k.ACTIVE_LOW
+m2k_spi_init.context = ctx
+
+spi_init_param = libm2k.spi_init_param()
+spi_init_param.max_speed_hz = SPI_SPEED
+spi_init_param.mode = libm2k.SPI_MODE_0
+spi_init_param.chip_select = 0
+spi_init_param.extra = m2k_spi_init
+
+spi_desc = libm2k.spi_init(spi_init_param)
+if spi_desc is None:
+	print("SPI Error: Could not configure SPI")
+	exit(1)
+
+libm2k.resetMetrics()
+latencies = []
+errors = 0
+for i in range(TRANSFERS):
+	sent = bytearray([0x80 | (i & 0x7F), i & 0xFF])
+	data = bytearray(sent)
+	start = time.perf_counter()
+	libm2k.spi_write_and_read(spi_desc, data)
+	latencies.append(time.perf_counter() - start)
+	if data != sent:
+		errors += 1
+
+latencies.sort()
+print("%d transfers, %d mismatches, %.1f transfers/s" % (TRANSFERS, errors, TRANSFERS / sum(latencies)))
+print("Host latency: min %.3f ms, median %.3f ms, p99 %.3f ms, max %.3f ms" % (
+	latencies[0] * 1e3, latencies[len(latencies) // 2] * 1e3,
+	latencies[int(len(latencies) * 0.99)] * 1e3, latencies[-1] * 1e3))
+
+for metric in libm2k.getMetrics():
+	if metric.name == "spi_transfer":
+		print("libm2k spi_transfer: median %.3f ms, p99 %.3f ms, %d errors" % (
+			metric.p50 * 1e3, metric.p99 * 1e3, metric.errors))
+
+libm2k.spi_remove(spi_desc)
+libm2k.contextClose(ctx)
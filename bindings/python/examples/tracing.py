@@ -0,0 +1,43 @@
+#
+# Copyright (c) 2026 Analog Devices Inc.
+#
+# This file is part of libm2k
+# (see http://www.github.com/analogdevicesinc/libm2k).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 2.1 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+
+
+
+# This example traces the buffer transfers and the attribute accesses of one
+# acquisition and saves them in the Chrome trace format.
+# Open m2k_trace.json in chrome://tracing or https://ui.perfetto.dev
+
+import libm2k
+
+ctx=libm2k.m2kOpen()
+if ctx is None:
+	print("Connection Error: No ADALM2000 device available/connected to your PC.")
+	exit(1)
+
+libm2k.enableTracing(libm2k.TRACE_ALL)
+
+ain=ctx.getAnalogIn()
+ain.enableChannel(0, True)
+ain.setSampleRate(1000000)
+ain.getSamples(4096)
+
+libm2k.enableTracing(libm2k.TRACE_NONE)
+libm2k.writeChromeTrace("m2k_trace.json")
+libm2k.contextClose(ctx)
@@ -48,6 +48,7 @@
 #include <libm2k/contextbuilder.hpp>
 #include <libm2k/analog/m2kanalogin.hpp>
 #include <libm2k/analog/m2kanalogout.hpp>
+#include <libm2k/m2kexceptions.hpp>
 #include <bitset>
 #include <queue>
 
@@ -117,6 +118,12 @@ void refill_thread(M2kAnalogIn *ain) {
 
 		cv_process.wait(lock, ([](){return (tmp_buffer_p == nullptr); }));
 		tmp_buffer_p = ain->getSamplesRawInterleaved(IN_NO_SAMPLES);
+		STREAM_BLOCK_INFO block = ain->getLastBlockInfo();
+		if (block.gap) {
+			std::cout << std::endl << "GAP before buffer " << block.sequence
+				  << " @ index " << block.first_sample
+				  << (block.overflow ? " (hardware overflow)" : " (acquisition restarted)") << std::endl;
+		}
 
 		lock.unlock();
 		cv_process.notify_one();
@@ -358,6 +365,14 @@ int main(int argc, char **argv)
 	trig->setAnalogStreamingFlag(false);
 	trig->setAnalogStreamingFlag(true);
 
+	// Number the buffers from here and let the hardware report the dropped samples
+	ain->resetStreamInfo();
+	__try {
+		ain->setOverflowDetection(true);
+	} __catch (exception_type &e) {
+		std::cout << "Overflow detection not available: " << e.what() << std::endl;
+	}
+
 	// Startup refill threads
 	std::thread producer = std::thread([](M2kAnalogIn *ain){ refill_thread(ain); }, ain);
 	std::thread consumer = std::thread([](M2kAnalogIn *ain){ process_thread(ain); }, ain);
@@ -376,6 +391,7 @@ int main(int argc, char **argv)
 	consumer.join();
 	analyzer_ch0.join();
 	analyzer_ch1.join();
+	std::cout << "Gaps detected: " << ain->getGapCount() << std::endl;
 
 
 	ain->cancelAcquisition();
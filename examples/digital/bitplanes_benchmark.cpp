@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// This example measures how fast the digital samples are split into per-channel data,
+// compared to a loop reading one bit of one sample at a time - no device required
+//
+// Running example: ./digital_bitplanes_benchmark no_samples=1048576 iterations=50
+//
+// Help:
+// -no_samples : integer number of 16-bit samples split at each iteration
+// -iterations : integer number of times each method runs
+
+#include <iostream>
+#include <libm2k/digital/bitplanes.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace libm2k::digital;
+
+static unsigned int NO_SAMPLES = 1 << 20;
+static unsigned int ITERATIONS = 50;
+
+static bool getBit(unsigned short sample, unsigned int bit)
+{
+	return (sample >> bit) & 1;
+}
+
+template <typename F>
+static double measure(F method)
+{
+	auto start = chrono::steady_clock::now();
+	for (unsigned int i = 0; i < ITERATIONS; i++) {
+		method();
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return (double)NO_SAMPLES * ITERATIONS / seconds / 1e6;
+}
+
+static void report(const string &name, double naive, double kernel, bool same)
+{
+	cout << name << ": naive loop " << naive << " MS/s, kernel " << kernel << " MS/s, "
+	     << kernel / naive << "x faster" << (same ? "" : " - RESULTS DIFFER") << endl;
+}
+
+int main(int argc, char **argv)
+{
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		size_t pos = arg.find('=');
+		if (pos == string::npos) {
+			continue;
+		}
+		string key = arg.substr(0, pos);
+		unsigned int value = (unsigned int)strtoul(arg.substr(pos + 1).c_str(), nullptr, 10);
+		if (key == "no_samples") {
+			NO_SAMPLES = value;
+		} else if (key == "iterations") {
+			ITERATIONS = value;
+		}
+	}
+
+	vector<unsigned short> samples(NO_SAMPLES);
+	mt19937 gen(0);
+	for (auto &sample : samples) {
+		sample = (unsigned short)gen();
+	}
+
+	unsigned int plane_size = getBitPlaneSize(NO_SAMPLES);
+	vector<unsigned char> channels_naive(16 * NO_SAMPLES), channels(16 * NO_SAMPLES);
+	vector<unsigned long long> planes_naive(16 * plane_size), planes(16 * plane_size);
+
+	double naive = measure([&]() {
+		for (unsigned int i = 0; i < NO_SAMPLES; i++) {
+			for (unsigned int ch = 0; ch < 16; ch++) {
+				channels_naive[ch * NO_SAMPLES + i] = getBit(samples[i], ch);
+			}
+		}
+	});
+	double kernel = measure([&]() {
+		extractChannels(samples.data(), NO_SAMPLES, channels.data());
+	});
+	report("Channels as bytes", naive, kernel, channels == channels_naive);
+
+	naive = measure([&]() {
+		std::fill(planes_naive.begin(), planes_naive.end(), 0);
+		for (unsigned int i = 0; i < NO_SAMPLES; i++) {
+			for (unsigned int ch = 0; ch < 16; ch++) {
+				planes_naive[ch * plane_size + i / 64] |= (unsigned long long)getBit(samples[i], ch) << (i % 64);
+			}
+		}
+	});
+	kernel = measure([&]() {
+		extractBitPlanes(samples.data(), NO_SAMPLES, planes.data());
+	});
+	report("Packed bit planes", naive, kernel, planes == planes_naive);
+	return 0;
+}
@@ -97,6 +97,40 @@ public:
 	*/
 	virtual std::string getName() = 0;
 
+
+	/**
+	* @brief Read all channels periodically on a background thread
+	*
+	* @param period_ms The time between two consecutive samples, in milliseconds
+	* @param buffer_size The number of samples kept until they are retrieved
+	*
+	* @note When the buffer is full, the oldest sample is overwritten
+	* @note Calling this function while sampling restarts the sampler and drops the stored samples
+	*/
+	virtual void startSampling(unsigned int period_ms, unsigned int buffer_size = 1024) = 0;
+
+
+	/**
+	* @brief Stop the periodic sampling; the stored samples can still be retrieved
+	*/
+	virtual void stopSampling() = 0;
+
+
+	/**
+	* @brief Check if the periodic sampling is running
+	*
+	* @return True if the sampler is running
+	*/
+	virtual bool isSampling() = 0;
+
+
+	/**
+	* @brief Retrieve the samples stored by the periodic sampling and remove them from the buffer
+	*
+	* @return A list of timestamped samples, the oldest first
+	*/
+	virtual std::vector<libm2k::analog::DMM_SAMPLE> readSamples() = 0;
+
 };
 }
 }
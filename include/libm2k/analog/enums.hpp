@@ -22,6 +22,7 @@
 #ifndef ENUMS_ANALOG_HPP
 #define ENUMS_ANALOG_HPP
 
+#include <libm2k/enums.hpp>
 #include <vector>
 #include <string>
 #include <memory>
@@ -49,6 +50,121 @@ namespace analog {
 	};
 
 
+	/**
+	* @struct DMM_SAMPLE enums.hpp libm2k/analog/enums.hpp
+	* @brief The readings of all the DMM channels, taken at the same moment
+	*
+	*/
+	struct DMM_SAMPLE {
+		double timestamp; ///< Seconds since the Unix epoch
+		std::vector<DMM_READING> readings; ///< One reading per channel, in the order of getAllChannels()
+	};
+
+
+	/**
+	* @struct POWER_SUPPLY_SAMPLE enums.hpp libm2k/analog/enums.hpp
+	* @brief The voltages of the power supply channels, read at the same moment
+	*
+	*/
+	struct POWER_SUPPLY_SAMPLE {
+		double timestamp; ///< Seconds since the Unix epoch
+		std::vector<double> values; ///< The voltage of each channel
+	};
+
+
+	/**
+	* @struct POWER_SUPPLY_STATS enums.hpp libm2k/analog/enums.hpp
+	* @brief Statistics of the voltages read by the power supply monitor
+	*
+	*/
+	struct POWER_SUPPLY_STATS {
+		double min; ///< The lowest voltage
+		double max; ///< The highest voltage
+		double mean; ///< The average voltage
+		unsigned int count; ///< The number of readings the statistics are computed from
+	};
+
+
+	/**
+	* @struct POWER_SUPPLY_STEP enums.hpp libm2k/analog/enums.hpp
+	* @brief One step of a power supply sequence
+	*
+	*/
+	struct POWER_SUPPLY_STEP {
+		unsigned int channel; ///< The index of the channel
+		double target; ///< The voltage to reach
+		double slew_rate; ///< The ramp speed in V/s; 0 sets the target right away
+		double dwell; ///< The time to wait after the target is reached, in seconds
+		double tolerance; ///< The accepted readback error in volts; 0 skips the readback
+		double settle_timeout; ///< The maximum time to wait for the readback, in seconds
+	};
+
+
+	/**
+	* @enum WAVEFORM_TYPE
+	* @brief Shapes synthesized by the waveform generator of the analog output
+	*
+	*/
+	enum WAVEFORM_TYPE {
+		WAVEFORM_SINE = 0,
+		WAVEFORM_SQUARE = 1,
+		WAVEFORM_TRIANGLE = 2,
+		WAVEFORM_SAWTOOTH = 3,
+		WAVEFORM_NOISE = 4, ///< Uniform white noise
+		WAVEFORM_DC = 5
+	};
+
+
+	/**
+	* @struct WAVEFORM_TONE enums.hpp libm2k/analog/enums.hpp
+	* @brief One component of a waveform
+	*
+	* @note The periodic shapes start at 0 and rise, like the sine; the square starts high
+	*
+	*/
+	struct WAVEFORM_TONE {
+		WAVEFORM_TYPE type; ///< The shape of the component
+		double frequency; ///< The frequency in Hz; ignored by the noise and DC components
+		double amplitude; ///< The peak amplitude in volts; the level of a DC component
+		double phase; ///< The initial phase in degrees
+		double duty_cycle; ///< The fraction of the period the square is high, between 0 and 1
+	};
+
+
+	/**
+	* @struct WAVEFORM enums.hpp libm2k/analog/enums.hpp
+	* @brief A waveform synthesized by the analog output as the sum of its components
+	*
+	*/
+	struct WAVEFORM {
+		std::vector<WAVEFORM_TONE> tones; ///< The components, added together
+		double offset; ///< The DC offset in volts
+	};
+
+
+	/**
+	* @struct SEQUENCE_SEGMENT enums.hpp libm2k/analog/enums.hpp
+	* @brief One segment of a sequence streamed by the analog output
+	*
+	*/
+	struct SEQUENCE_SEGMENT {
+		std::vector<double> samples; ///< The samples of the segment, in volts
+		unsigned int repeat; ///< The number of times the samples are sent; 0 skips the segment
+		bool wait_trigger; ///< Send each repetition on a trigger event, instead of right after the previous samples
+	};
+
+
+	/**
+	* @struct ANALOG_SEGMENT enums.hpp libm2k/analog/enums.hpp
+	* @brief One triggered segment of a segmented acquisition of the analog input
+	*
+	*/
+	struct ANALOG_SEGMENT {
+		std::vector<std::vector<double>> samples; ///< The samples of each channel, in volts; empty for the disabled channels
+		libm2k::STREAM_BLOCK_INFO info; ///< The host timestamp and the continuity of the block holding the segment
+	};
+
+
 	/**
 	* @enum ANALOG_IN_CHANNEL
 	* @brief Indexes of the channels
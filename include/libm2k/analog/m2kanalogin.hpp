@@ -25,6 +25,8 @@
 #include <libm2k/m2kglobal.hpp>
 #include <libm2k/analog/enums.hpp>
 #include <libm2k/m2khardwaretrigger.hpp>
+#include <libm2k/asyncresult.hpp>
+#include <functional>
 #include <vector>
 #include <map>
 #include <memory>
@@ -159,6 +161,64 @@ public:
 	virtual const short* getSamplesRawInterleaved_matlab(unsigned int nb_samples) = 0;
 
 
+	/**
+	* @brief Retrieve a specific number of samples from each channel into a buffer owned by the client
+	*
+	* @param data Pointer to a buffer that can hold getNbChannels() * nb_samples_per_channel values
+	* @param nb_samples_per_channel The number of samples that will be retrieved
+	*
+	* @note Same layout as getSamplesInterleaved, without allocating an intermediate array
+	* @note Before the acquisition, both channels will be automatically enabled
+	* @note After the acquisition is finished, the channels will return to their initial state
+	* @note Due to a hardware limitation, the number of samples must
+	* be a multiple of 4 and greater than 16.
+	*/
+	virtual void getSamplesInterleavedInto(double *data, unsigned int nb_samples_per_channel) = 0;
+
+
+	/**
+	* @brief Retrieve a specific number of raw samples from each channel into a buffer owned by the client
+	*
+	* @param data Pointer to a buffer that can hold getNbChannels() * nb_samples_per_channel values
+	* @param nb_samples_per_channel The number of samples that will be retrieved
+	*
+	* @note Same layout as getSamplesRawInterleaved, without an extra copy on the caller's side
+	* @note Before the acquisition, both channels will be automatically enabled
+	* @note After the acquisition is finished, the channels will return to their initial state
+	* @note Due to a hardware limitation, the number of samples must
+	* be a multiple of 4 and greater than 16.
+	*/
+	virtual void getSamplesRawInterleavedInto(short *data, unsigned int nb_samples_per_channel) = 0;
+
+
+	/**
+	* @brief Retrieve a specific number of samples from both channels into a buffer owned by the client
+	*
+	* @param data Pointer to a buffer that can hold nb_samples values
+	* @param nb_samples The number of samples that will be retrieved
+	*
+	* @note MATLAB specific API wrapper
+	* @note The data array will contain nb_samples/2 for each channel
+	* @note Due to a hardware limitation, the number of samples must
+	* be a multiple of 4 and greater than 16.
+	*/
+	virtual void getSamplesInterleavedInto_matlab(double *data, unsigned int nb_samples) = 0;
+
+
+	/**
+	* @brief Retrieve a specific number of raw samples from both channels into a buffer owned by the client
+	*
+	* @param data Pointer to a buffer that can hold nb_samples values
+	* @param nb_samples The number of samples that will be retrieved
+	*
+	* @note MATLAB specific API wrapper
+	* @note The data array will contain nb_samples/2 for each channel
+	* @note Due to a hardware limitation, the number of samples must
+	* be a multiple of 4 and greater than 16.
+	*/
+	virtual void getSamplesRawInterleavedInto_matlab(short *data, unsigned int nb_samples) = 0;
+
+
 	/**
 	* @brief Retrieve the average raw value of the given channel
 	*
@@ -487,6 +547,52 @@ public:
 	*/
 	virtual void getSamples(std::vector<std::vector<double>> &data, unsigned int nb_samples) = 0;
 
+	/**
+	* @brief Retrieve a specific number of samples from each channel into a buffer owned by the client
+	*
+	* @param data Pointer to a buffer that can hold getNbChannels() * nb_samples values
+	* @param nb_samples The number of samples that will be retrieved for each channel
+	*
+	* @note The samples are stored channel after channel: data[channel * nb_samples + index]
+	* @note The samples of a disabled channel are set to 0
+	* @note Due to a hardware limitation, the number of samples must
+	* be a multiple of 4 and greater than 16.
+	*/
+	virtual void getSamplesInto(double *data, unsigned int nb_samples) = 0;
+
+
+	/**
+	* @brief Retrieve a specific number of raw samples from each channel into a buffer owned by the client
+	*
+	* @param data Pointer to a buffer that can hold getNbChannels() * nb_samples values
+	* @param nb_samples The number of samples that will be retrieved for each channel
+	*
+	* @note The samples are stored channel after channel: data[channel * nb_samples + index]
+	* @note The samples of a disabled channel are set to 0
+	* @note Due to a hardware limitation, the number of samples must
+	* be a multiple of 4 and greater than 16.
+	*/
+	virtual void getSamplesRawInto(short *data, unsigned int nb_samples) = 0;
+
+
+	/**
+	* @brief Acquire a number of triggered segments back to back
+	*
+	* @param nb_segments The number of segments
+	* @param nb_samples The number of samples of each segment, for each channel
+	* @return The segments, each with the host timestamp of its block
+	* @throw EXC_INVALID_PARAMETER if nb_segments is 0
+	*
+	* @note Each segment waits for its own trigger event: the streaming flag of the analog
+	* trigger is cleared during the acquisition and restored afterwards
+	* @note The buffer is created once and refilled for each segment; up to getKernelBuffersCount()
+	* segments are armed ahead, so bursts of trigger events are caught while the previous segments
+	* are read. The samples are converted only after the last segment.
+	* @note Due to a hardware limitation, the number of samples must
+	* be a multiple of 4 and greater than 16.
+	*/
+	virtual std::vector<ANALOG_SEGMENT> getSegments(unsigned int nb_segments, unsigned int nb_samples) = 0;
+
 	/**
 	 * @brief Get the channel name for each ADC channel
 	 * @param channel - unsigned int representing the index of the channel
@@ -500,6 +606,89 @@ public:
 	 */
 	virtual double getMaximumSamplerate() = 0;
 
+
+	/**
+	* @brief Retrieve a specific number of samples from each channel without blocking
+	*
+	* @param nb_samples The number of samples that will be retrieved
+	* @return A handle which provides the samples once the acquisition is done
+	*
+	* @note The asynchronous operations of an AnalogIn run one after the other on a
+	* background thread; the AnalogIn should not be used from other threads meanwhile
+	* @note Due to a hardware limitation, the number of samples must
+	* be a multiple of 4 and greater than 16.
+	*/
+	virtual libm2k::AsyncResult<std::vector<std::vector<double>>> getSamplesAsync(unsigned int nb_samples) = 0;
+
+
+	/**
+	* @brief Acquire buffers continuously in the background and pass each of them to a callback
+	*
+	* @param nb_samples The number of samples in each buffer
+	* @param callback Function called from the background thread with each acquired buffer
+	* @return A handle which finishes when the subscription ends; it carries the error that
+	* stopped the acquisition, if any
+	*
+	* @note Only one subscription can be active at a time
+	* @note Due to a hardware limitation, the number of samples must
+	* be a multiple of 4 and greater than 16.
+	*/
+	virtual libm2k::AsyncOperation subscribeSamples(unsigned int nb_samples,
+			std::function<void(const std::vector<std::vector<double>> &)> callback) = 0;
+
+
+	/**
+	* @brief Stop the active subscription, if any
+	*/
+	virtual void unsubscribeSamples() = 0;
+
+
+	/**
+	* @brief Retrieve the position and the continuity of the last block of samples acquired
+	*
+	* @return The sequence number, host timestamp and gap flags of the block
+	*
+	* @note Each buffer refill is one block, whichever method acquired it. A block is
+	* marked as a gap if the hardware reported an overflow or if the buffer was created
+	* again since the previous block (new number of samples, stopped or failed acquisition).
+	* @note Without the analog streaming flag of the trigger, each block is a separate
+	* triggered capture: every block but the first is a gap, and starts at sample 0.
+	*/
+	virtual libm2k::STREAM_BLOCK_INFO getLastBlockInfo() = 0;
+
+
+	/**
+	* @brief Retrieve the number of blocks which did not follow the previous one without loss
+	*
+	* @return The number of gaps since the stream information was reset
+	*/
+	virtual unsigned long long getGapCount() = 0;
+
+
+	/**
+	* @brief Restart the numbering of the blocks and of the samples and clear the gap counter
+	*/
+	virtual void resetStreamInfo() = 0;
+
+
+	/**
+	* @brief Check the overflow flag of the hardware after each acquired block
+	*
+	* @param enable True to check the flag, False to stop
+	* @throw EXC_INVALID_PARAMETER if the device does not report overflows
+	*
+	* @note The check reads a register, which costs one more transfer for each block.
+	* The flag is sticky, so the overflow is reported on the first block received after it happened.
+	*/
+	virtual void setOverflowDetection(bool enable) = 0;
+
+
+	/**
+	* @brief Check if the overflow flag of the hardware is checked after each block
+	*
+	* @return True if the overflows are detected
+	*/
+	virtual bool getOverflowDetection() = 0;
 };
 }
 }
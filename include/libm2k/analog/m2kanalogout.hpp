@@ -24,7 +24,9 @@
 
 #include <libm2k/m2kglobal.hpp>
 #include <libm2k/enums.hpp>
+#include <libm2k/analog/enums.hpp>
 #include <libm2k/m2khardwaretrigger.hpp>
+#include <libm2k/asyncresult.hpp>
 #include <vector>
 #include <memory>
 #include <map>
@@ -338,6 +340,61 @@ public:
 	virtual void pushRaw(std::vector<std::vector<short>> const &data) = 0;
 
 
+	/**
+	* @brief Synthesize a waveform and send it to the given channel
+	*
+	* @param chnIdx The index corresponding to the channel
+	* @param waveform The waveform to be generated
+	*
+	* @note The buffer holds a whole number of periods of every component, so the
+	* cyclic output has no phase jump; the frequencies are adjusted to fit, by at most
+	* 1 ppm whenever the buffer size allows it
+	* @note The samples are synthesized at the current sample rate of the channel
+	* @throw EXC_OUT_OF_RANGE No such channel, or a frequency too low for the sample rate
+	* @throw EXC_INVALID_PARAMETER Invalid frequency or duty cycle
+	*/
+	virtual void pushWaveform(unsigned int chnIdx, WAVEFORM const &waveform) = 0;
+
+
+	/**
+	* @brief Synthesize the next samples of a waveform and send them to the given channel
+	*
+	* @param chnIdx The index corresponding to the channel
+	* @param waveform The waveform to be generated
+	* @param nb_samples The number of samples to be sent
+	*
+	* @note Meant for streaming in non-cyclic mode: consecutive calls with the same waveform
+	* continue its phase, while a different waveform or sample rate, or stopping the
+	* channel, restarts it
+	* @throw EXC_OUT_OF_RANGE No such channel
+	* @throw EXC_INVALID_PARAMETER Invalid frequency or duty cycle
+	*/
+	virtual void pushWaveform(unsigned int chnIdx, WAVEFORM const &waveform, unsigned int nb_samples) = 0;
+
+
+	/**
+	* @brief Synthesize a waveform for each channel and send them together
+	*
+	* @param waveforms A list containing the waveform of each channel
+	*
+	* @note The index of each waveform represents the channel's index
+	* @note Each buffer holds a whole number of periods, as for a single channel
+	*/
+	virtual void pushWaveform(std::vector<WAVEFORM> const &waveforms) = 0;
+
+
+	/**
+	* @brief Synthesize the next samples of a waveform for each channel and send them together
+	*
+	* @param waveforms A list containing the waveform of each channel
+	* @param nb_samples The number of samples to be sent on each channel
+	*
+	* @note The index of each waveform represents the channel's index
+	* @note The phase of each channel continues as for a single channel
+	*/
+	virtual void pushWaveform(std::vector<WAVEFORM> const &waveforms, unsigned int nb_samples) = 0;
+
+
 	/**
 	* @brief Stop all channels from sending the signals.
 	*
@@ -527,6 +584,91 @@ public:
 	* @return A boolean value corresponding to the state of the rearm on trigger.
 	*/
 	virtual bool getBufferRearmOnTrigger() const = 0;
+
+
+	/**
+	* @brief Send samples to all the enabled channels without blocking
+	*
+	* @param data A list of vectors containing the samples
+	* @return A handle which finishes once the samples were pushed
+	*
+	* @note The samples are copied, so the data can be reused right away
+	* @note The asynchronous operations of an AnalogOut run one after the other on a
+	* background thread; the AnalogOut should not be used from other threads meanwhile
+	*/
+	virtual libm2k::AsyncOperation pushAsync(std::vector<std::vector<double>> const &data) = 0;
+
+
+	/**
+	* @brief Stream a sequence of segments to the given channel in the background
+	*
+	* @param chnIdx The index corresponding to the channel
+	* @param segments The segments, sent in order, each as many times as its repeat count
+	* @param buffer_size The number of samples in each buffer pushed; a multiple of 4, at least 16
+	* @return A handle which finishes once the whole sequence was pushed, or stopped
+	*
+	* @note The channel is set to non-cyclic mode. Each segment is converted once and its
+	* repetitions are expanded while the buffers are filled, so the memory used depends on
+	* the segments, not on the duration of the sequence
+	* @note The consecutive segments which do not wait for a trigger are sent back to back;
+	* the last buffer before a pause is completed with the last sample of the segment
+	* @note The segments which wait for a trigger are pushed one buffer per repetition, with
+	* the buffer rearm on trigger enabled; the hardware trigger of the analog output must be
+	* configured beforehand. The sequence waits for the samples already queued to be sent
+	* before enabling or disabling the rearm and before changing the buffer size
+	* @note The sequence runs on the background thread of the asynchronous operations; only
+	* one sequence can run at a time
+	* @throw EXC_OUT_OF_RANGE No such channel
+	* @throw EXC_INVALID_PARAMETER Invalid buffer size, or a sequence is already running
+	* @throw EXC_INVALID_FIRMWARE_VERSION A segment waits for a trigger and the firmware is older than v0.33
+	*/
+	virtual libm2k::AsyncOperation runSequence(unsigned int chnIdx, std::vector<SEQUENCE_SEGMENT> const &segments,
+						   unsigned int buffer_size) = 0;
+
+
+	/**
+	* @brief Stop the running sequence, if any
+	*
+	* @note The sequence ends once the buffer being pushed is accepted; the samples already
+	* queued are still sent, call stop() to cancel them as well
+	*/
+	virtual void stopSequence() = 0;
+
+
+	/**
+	* @brief Set the size of the cache holding the raw buffers of the cyclic waveforms
+	*
+	* @param bytes The maximum size of the cached buffers, in bytes; 0 disables the cache
+	*
+	* @note Pushing a cyclic waveform in volts, or with pushWaveform, reuses the raw buffer
+	* of an identical waveform pushed earlier at the same sample rate and calibration,
+	* instead of converting the samples again
+	* @note The least recently used buffers are dropped to stay within the limit; the
+	* default limit is 16 MiB
+	*/
+	virtual void setWaveformCacheSize(unsigned int bytes) = 0;
+
+
+	/**
+	* @brief Retrieve the size of the cache holding the raw buffers of the cyclic waveforms
+	*
+	* @return The maximum size of the cached buffers, in bytes
+	*/
+	virtual unsigned int getWaveformCacheSize() = 0;
+
+
+	/**
+	* @brief Retrieve the use of the waveform cache since it was last cleared
+	*
+	* @return The number of hits and misses, and the content of the cache
+	*/
+	virtual libm2k::WAVEFORM_CACHE_STATS getWaveformCacheStats() = 0;
+
+
+	/**
+	* @brief Drop all the cached buffers and reset the statistics
+	*/
+	virtual void clearWaveformCache() = 0;
 };
 }
 }
@@ -23,6 +23,9 @@
 #define M2KPOWERSUPPLY_HPP
 
 #include <libm2k/m2kglobal.hpp>
+#include <libm2k/analog/enums.hpp>
+#include <libm2k/asyncresult.hpp>
+#include <functional>
 #include <vector>
 #include <memory>
 
@@ -107,6 +110,119 @@ public:
 	* @return Otherwise, false
 	*/
 	virtual bool anyChannelEnabled() = 0;
+
+
+	/**
+	* @brief Read both channels periodically on a background thread
+	*
+	* @param period_ms The time between two consecutive samples, in milliseconds
+	* @param buffer_size The number of samples kept until they are retrieved
+	*
+	* @note When the buffer is full, the oldest sample is overwritten
+	* @note The statistics are reset when the monitor is started
+	*/
+	virtual void startMonitoring(unsigned int period_ms, unsigned int buffer_size = 1024) = 0;
+
+
+	/**
+	* @brief Stop the monitor; the samples and the statistics can still be retrieved
+	*/
+	virtual void stopMonitoring() = 0;
+
+
+	/**
+	* @brief Check if the monitor is running
+	*
+	* @return True if the monitor is running
+	*/
+	virtual bool isMonitoring() = 0;
+
+
+	/**
+	* @brief Retrieve the samples stored by the monitor and remove them from the buffer
+	*
+	* @return A list of timestamped samples, the oldest first
+	*/
+	virtual std::vector<libm2k::analog::POWER_SUPPLY_SAMPLE> readMonitorSamples() = 0;
+
+
+	/**
+	* @brief Retrieve the statistics of the given channel since the monitor was started
+	*
+	* @param chn The index corresponding to the channel
+	* @return The minimum, maximum and mean voltage
+	*/
+	virtual libm2k::analog::POWER_SUPPLY_STATS getMonitorStatistics(unsigned int chn) = 0;
+
+
+	/**
+	* @brief Reset the statistics of all channels
+	*/
+	virtual void resetMonitorStatistics() = 0;
+
+
+	/**
+	* @brief Call a function when the voltage of the given channel leaves a window
+	*
+	* @param chn The index corresponding to the channel
+	* @param min The lowest accepted voltage
+	* @param max The highest accepted voltage
+	* @param callback Function called from the monitor thread with the channel and the voltage
+	*
+	* @note The callback is called once when the voltage leaves the window, and again only
+	* after the voltage returned inside the window
+	*/
+	virtual void setMonitorThreshold(unsigned int chn, double min, double max,
+					 std::function<void(unsigned int, double)> callback) = 0;
+
+
+	/**
+	* @brief Remove the threshold of the given channel
+	*
+	* @param chn The index corresponding to the channel
+	*/
+	virtual void clearMonitorThreshold(unsigned int chn) = 0;
+
+
+	/**
+	* @brief Run a list of steps on a background thread
+	*
+	* Each step ramps a channel to its target at the given slew rate, optionally waits
+	* until the readback is within the tolerance, then waits for the dwell time.
+	*
+	* @param steps The steps, run in the given order
+	* @param calibrated Whether the written and read values use the calibration coefficients
+	* @return A handle which finishes once the last step is done
+	*
+	* @note The handle rethrows the error of a failed step, e.g. a readback timeout;
+	* the remaining steps are not run
+	* @note The sequences run one after the other; the channels should not be changed
+	* from other threads meanwhile
+	*/
+	virtual libm2k::AsyncOperation runSequence(std::vector<libm2k::analog::POWER_SUPPLY_STEP> const &steps,
+						   bool calibrated = true) = 0;
+
+
+	/**
+	* @brief Ramp a channel to the given voltage on a background thread
+	*
+	* @param chn The index corresponding to the channel
+	* @param target The voltage to reach (up to 5V)
+	* @param slew_rate The ramp speed in V/s; 0 sets the target right away
+	* @param calibrated Whether the written values use the calibration coefficients
+	* @return A handle which finishes once the target is reached
+	*/
+	virtual libm2k::AsyncOperation rampChannel(unsigned int chn, double target, double slew_rate,
+						   bool calibrated = true) = 0;
+
+
+	/**
+	* @brief Stop the running sequence and drop the pending ones
+	*
+	* The channels keep the last written voltage. The handles of the cancelled
+	* sequences finish with an error.
+	*/
+	virtual void cancelSequence() = 0;
 };
 }
 }
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ASYNCRESULT_HPP
+#define ASYNCRESULT_HPP
+
+#include <libm2k/m2kglobal.hpp>
+#include <exception>
+#include <functional>
+#include <memory>
+
+namespace libm2k {
+
+/**
+ * @addtogroup m2k
+ * @{
+ */
+
+/**
+ * @brief Handle to an operation that runs in the background
+ *
+ * All the copies of a handle refer to the same operation.
+ */
+class LIBM2K_API AsyncOperation
+{
+public:
+	/**
+	* @private
+	*/
+	AsyncOperation();
+
+
+	/**
+	* @private
+	*/
+	virtual ~AsyncOperation();
+
+
+	/**
+	* @brief Check if the operation is finished
+	*
+	* @return True if the operation finished, successfully or not
+	*/
+	bool isReady() const;
+
+
+	/**
+	* @brief Wait for the operation to finish
+	*
+	* @throws The exception raised by the operation, if it failed
+	*/
+	void wait() const;
+
+
+	/**
+	* @brief Wait for the operation to finish, at most timeout_ms milliseconds
+	*
+	* @param timeout_ms The maximum time to wait, in milliseconds
+	* @return True if the operation finished, False if the timeout expired
+	*/
+	bool waitFor(unsigned int timeout_ms) const;
+
+
+	/**
+	* @brief Register a function to be called once the operation is finished
+	*
+	* @param callback The function to be called
+	*
+	* @note The callback runs on the thread which finishes the operation, or right away
+	* on the calling thread if the operation is already finished
+	*/
+	void onComplete(std::function<void()> callback);
+
+
+	/**
+	* @private
+	*/
+	void setFinished(std::exception_ptr error = nullptr);
+
+private:
+	class State;
+	std::shared_ptr<State> m_state;
+};
+
+
+/**
+ * @brief Handle to an operation that produces a value in the background
+ */
+template <typename T>
+class AsyncResult : public AsyncOperation
+{
+public:
+	/**
+	* @private
+	*/
+	AsyncResult() : m_value(std::make_shared<T>()) {}
+
+
+	/**
+	* @brief Wait for the operation to finish and retrieve its result
+	*
+	* @return The value produced by the operation
+	* @throws The exception raised by the operation, if it failed
+	*/
+	T get() const
+	{
+		wait();
+		return *m_value;
+	}
+
+
+	/**
+	* @private
+	*/
+	void setValue(const T &value)
+	{
+		*m_value = value;
+		setFinished();
+	}
+
+private:
+	std::shared_ptr<T> m_value;
+};
+
+/** @} */
+}
+
+#endif //ASYNCRESULT_HPP
@@ -29,6 +29,7 @@
 #include <libm2k/enums.hpp>
 #include <unordered_set>
 #include <map>
+#include <functional>
 
 enum ContextTypes {
 	CtxFMCOMMS,
@@ -94,6 +95,20 @@ public:
 
 	static void contextCloseAll();
 
+	/**
+	* @private
+	*/
+	static void setContextsCacheTimeout(unsigned int timeout_ms);
+	/**
+	* @private
+	*/
+	static unsigned int watchContexts(std::function<void(const libm2k::CONTEXT_INFO &, bool)> callback,
+					  unsigned int period_ms = 1000);
+	/**
+	* @private
+	*/
+	static void unwatchContexts(unsigned int id);
+
 	static std::string getVersion();
 
 	/**
@@ -193,6 +208,39 @@ LIBM2K_API std::vector<struct libm2k::CONTEXT_INFO*> getContextsInfo();
 LIBM2K_API std::vector<std::string> getAllContexts();
 
 
+/**
+ * @brief Set for how long the list of available contexts is reused before scanning again
+ * @param timeout_ms The lifetime of the list, in milliseconds; 0 scans on every call
+ *
+ * @note getContextsInfo(), getAllContexts() and m2kOpen() without uri share the same list.
+ * The default lifetime is 500 ms.
+ */
+LIBM2K_API void setContextsCacheTimeout(unsigned int timeout_ms);
+
+
+/**
+ * @brief Get notified when a USB context is connected or disconnected
+ * @param callback The function called with the context info and True if the context
+ * was connected, False if it was disconnected
+ * @param period_ms The time between two scans, in milliseconds
+ * @return An identifier which stops the notifications when passed to unwatchContexts()
+ *
+ * @note The contexts are scanned on a background thread, which also calls the callback.
+ * Only the changes after this call are reported; use getContextsInfo() for the current list.
+ */
+LIBM2K_API unsigned int watchContexts(std::function<void(const libm2k::CONTEXT_INFO &info, bool connected)> callback,
+				      unsigned int period_ms = 1000);
+
+
+/**
+ * @brief Stop the notifications registered with watchContexts()
+ * @param id The identifier returned by watchContexts()
+ *
+ * @note The scans stop once no callback is registered
+ */
+LIBM2K_API void unwatchContexts(unsigned int id);
+
+
 /**
  * @brief Destroy the given context
  * @param ctx The context to be destroyed
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BITPLANES_HPP
+#define BITPLANES_HPP
+
+#include <libm2k/m2kglobal.hpp>
+
+namespace libm2k {
+namespace digital {
+
+/**
+ * @addtogroup digital
+ * @{
+ */
+
+/**
+ * @brief Retrieve the number of 64-bit words holding the bit plane of one channel
+ *
+ * @param nb_samples The number of samples
+ * @return The number of words, nb_samples / 64 rounded up
+ */
+LIBM2K_API unsigned int getBitPlaneSize(unsigned int nb_samples);
+
+
+/**
+ * @brief Split digital samples into one packed bitstream for each of the 16 channels
+ *
+ * @param samples The samples
+ * @param nb_samples The number of samples
+ * @param planes Pointer to a buffer of 16 * getBitPlaneSize(nb_samples) words, which receives
+ * the bit plane of channel 0, then the one of channel 1 and so on
+ *
+ * @note Bit j of word k of a plane holds the value of the channel in sample 64 * k + j.
+ * The bits after the last sample are 0.
+ */
+LIBM2K_API void extractBitPlanes(const unsigned short *samples, unsigned int nb_samples,
+				 unsigned long long *planes);
+
+
+/**
+ * @brief Split digital samples into one array of bytes for each of the 16 channels
+ *
+ * @param samples The samples
+ * @param nb_samples The number of samples
+ * @param channels Pointer to a buffer of 16 * nb_samples bytes, which receives the values (0 or 1)
+ * of channel 0 for all the samples, then the ones of channel 1 and so on
+ */
+LIBM2K_API void extractChannels(const unsigned short *samples, unsigned int nb_samples,
+				unsigned char *channels);
+
+/** @} */
+}
+}
+
+#endif //BITPLANES_HPP
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DIGITALTRANSITIONS_HPP
+#define DIGITALTRANSITIONS_HPP
+
+#include <libm2k/m2kglobal.hpp>
+#include <libm2k/enums.hpp>
+#include <libm2k/digital/enums.hpp>
+#include <vector>
+
+namespace libm2k {
+namespace digital {
+
+/**
+ * @addtogroup digital
+ * @{
+ */
+
+/**
+ * @class DigitalTransitions digitaltransitions.hpp libm2k/digital/digitaltransitions.hpp
+ * @brief Digital samples stored as the list of their changes
+ *
+ * The first transition holds the value of the first sample; each of the following ones
+ * holds a new value and the index of the sample where it appears. The memory used depends
+ * on the number of changes, not on the number of samples.
+ */
+class LIBM2K_API DigitalTransitions
+{
+public:
+	/**
+	* @brief Create an empty list
+	*
+	* @param sample_rate The sample rate of the samples, used to convert the times to sample indexes
+	*/
+	DigitalTransitions(double sample_rate = 0);
+
+
+	/**
+	* @brief Append the changes of the next samples
+	*
+	* @param samples The samples, following the ones already appended
+	* @param nb_samples The number of samples
+	*/
+	void append(const unsigned short *samples, unsigned int nb_samples);
+
+
+	/**
+	* @brief Append the changes of the next samples
+	*
+	* @param samples The samples, following the ones already appended
+	*/
+	void append(std::vector<unsigned short> const &samples);
+
+
+	/**
+	* @brief Remove all the samples
+	*/
+	void clear();
+
+
+	/**
+	* @brief Retrieve the sample rate of the samples
+	*
+	* @return The sample rate, in samples per second
+	*/
+	double getSampleRate() const;
+
+
+	/**
+	* @brief Retrieve the number of samples appended
+	*
+	* @return The number of samples
+	*/
+	unsigned long long getNbSamples() const;
+
+
+	/**
+	* @brief Retrieve the transitions
+	*
+	* @return The transitions, in order; the first one is at sample 0
+	*/
+	std::vector<DIGITAL_TRANSITION> const &getTransitions() const;
+
+
+	/**
+	* @brief Retrieve the value of the channels at the given sample
+	*
+	* @param sample The index of the sample
+	* @return The value of the 16 digital channels
+	* @throw EXC_OUT_OF_RANGE No such sample
+	*/
+	unsigned short getValue(unsigned long long sample) const;
+
+
+	/**
+	* @brief Retrieve the value of the channels at the given time
+	*
+	* @param time The time since the first sample, in seconds
+	* @return The value of the 16 digital channels
+	* @throw EXC_OUT_OF_RANGE The time is outside the samples, or the sample rate is unknown
+	*/
+	unsigned short getValueAt(double time) const;
+
+
+	/**
+	* @brief Retrieve the edges of one channel
+	*
+	* @param channel The index of the channel
+	* @param edge RISING_EDGE_DIGITAL, FALLING_EDGE_DIGITAL or ANY_EDGE_DIGITAL
+	* @return The indexes of the samples where the channel changed
+	* @throw EXC_INVALID_PARAMETER The condition is not an edge
+	*/
+	std::vector<unsigned long long> getEdges(DIO_CHANNEL channel, libm2k::M2K_TRIGGER_CONDITION_DIGITAL edge) const;
+
+
+	/**
+	* @brief Expand a range of samples
+	*
+	* @param first The index of the first sample
+	* @param nb_samples The number of samples
+	* @return The samples
+	* @throw EXC_OUT_OF_RANGE The range exceeds the samples
+	*/
+	std::vector<unsigned short> getSamples(unsigned long long first, unsigned int nb_samples) const;
+
+private:
+	double m_sample_rate;
+	unsigned long long m_nb_samples;
+	std::vector<DIGITAL_TRANSITION> m_transitions;
+};
+
+/** @} */
+}
+}
+
+#endif //DIGITALTRANSITIONS_HPP
@@ -23,6 +23,8 @@
 #define ENUMS_DIGITAL_HPP
 
 #include <iio.h>
+#include <libm2k/enums.hpp>
+#include <vector>
 
 /**
  * @file digital/enums.hpp
@@ -108,6 +110,39 @@ namespace digital {
 	};
 
 
+	/**
+	* @struct DIGITAL_PATTERN_STEP enums.hpp libm2k/digital/enums.hpp
+	* @brief One step of a digital pattern: a value held for a number of samples
+	*
+	*/
+	struct DIGITAL_PATTERN_STEP {
+		unsigned short value; ///< The value of the 16 digital channels, one bit per channel
+		unsigned long long duration; ///< The number of samples for which the value is held
+	};
+
+
+	/**
+	* @struct DIGITAL_TRANSITION enums.hpp libm2k/digital/enums.hpp
+	* @brief A change of the digital channels
+	*
+	*/
+	struct DIGITAL_TRANSITION {
+		unsigned long long sample; ///< The index of the first sample with the new value
+		unsigned short value; ///< The value of the 16 digital channels from this sample on
+	};
+
+
+	/**
+	* @struct DIGITAL_SEGMENT enums.hpp libm2k/digital/enums.hpp
+	* @brief One triggered segment of a segmented acquisition of the digital input
+	*
+	*/
+	struct DIGITAL_SEGMENT {
+		std::vector<unsigned short> samples; ///< The samples of the segment
+		libm2k::STREAM_BLOCK_INFO info; ///< The host timestamp and the continuity of the block holding the segment
+	};
+
+
 	/**
 	* @private
 	*/
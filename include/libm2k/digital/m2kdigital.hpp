@@ -24,8 +24,12 @@
 
 #include <libm2k/m2kglobal.hpp>
 #include <libm2k/digital/enums.hpp>
+#include <libm2k/digital/digitaltransitions.hpp>
+#include <libm2k/digital/bitplanes.hpp>
 #include <libm2k/analog/enums.hpp>
 #include <libm2k/m2khardwaretrigger.hpp>
+#include <libm2k/asyncresult.hpp>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -135,6 +139,31 @@ public:
 	virtual void push(unsigned short *data, unsigned int nb_samples) = 0;
 
 
+	/**
+	* @brief Send a pattern, given as a list of values and durations, to all digital channels
+	*
+	* @param pattern The steps of the pattern, in order
+	* @note The steps are expanded straight into the buffer, which holds the whole pattern;
+	* meant for the cyclic mode
+	* @note Due to a hardware limitation, the total duration must
+	* be a multiple of 4 and greater than 16.
+	*/
+	virtual void pushPattern(std::vector<DIGITAL_PATTERN_STEP> const &pattern) = 0;
+
+
+	/**
+	* @brief Stream a pattern, given as a list of values and durations, to all digital channels
+	*
+	* @param pattern The steps of the pattern, in order
+	* @param buffer_size The number of samples in each buffer pushed; a multiple of 4, at least 16
+	* @note Only available in non-cyclic mode. The steps are expanded straight into each buffer
+	* while it is pushed, so the memory used depends on the number of steps, not on their
+	* durations
+	* @note The last buffer is completed with the value of the last step
+	*/
+	virtual void pushPattern(std::vector<DIGITAL_PATTERN_STEP> const &pattern, unsigned int buffer_size) = 0;
+
+
 	/**
 	* @brief Set the raw value of a given digital channel
 	*
@@ -407,6 +436,66 @@ public:
 	 */
 	virtual void getSamples(std::vector<unsigned short> &data, unsigned int nb_samples) = 0;
 
+	/**
+	 * @brief Retrieve a specific number of samples into a buffer owned by the client
+	 * @param data Pointer to a buffer that can hold nb_samples values
+	 * @param nb_samples The number of samples that will be retrieved
+	 */
+	virtual void getSamplesInto(unsigned short *data, unsigned int nb_samples) = 0;
+
+	/**
+	 * @brief Acquire a specific number of samples and keep only their transitions
+	 * @param nb_samples The number of samples that will be acquired
+	 * @return The transitions of the samples, at the input sample rate
+	 * @note Due to a hardware limitation, the number of samples must
+	 * be a multiple of 4 and greater than 16.
+	 */
+	virtual DigitalTransitions getTransitions(unsigned int nb_samples) = 0;
+
+	/**
+	 * @brief Acquire the next samples and append their transitions to a list, for continuous captures
+	 * @param transitions The list, which receives the samples after the ones it already holds
+	 * @param nb_samples The number of samples that will be acquired
+	 * @note The samples of consecutive buffers are assumed to follow each other; getLastBlockInfo()
+	 * tells if the acquisition restarted in between
+	 * @note Due to a hardware limitation, the number of samples must
+	 * be a multiple of 4 and greater than 16.
+	 */
+	virtual void getTransitions(DigitalTransitions &transitions, unsigned int nb_samples) = 0;
+
+
+	/**
+	 * @brief Retrieve a specific number of samples as one packed bitstream for each channel
+	 * @param planes Pointer to a buffer of 16 * getBitPlaneSize(nb_samples) words, filled as by extractBitPlanes()
+	 * @param nb_samples The number of samples that will be retrieved
+	 */
+	virtual void getBitPlanesInto(unsigned long long *planes, unsigned int nb_samples) = 0;
+
+
+	/**
+	 * @brief Retrieve a specific number of samples as one array of bytes for each channel
+	 * @param data Pointer to a buffer of 16 * nb_samples bytes, filled as by extractChannels()
+	 * @param nb_samples The number of samples that will be retrieved
+	 */
+	virtual void getChannelsInto(unsigned char *data, unsigned int nb_samples) = 0;
+
+
+	/**
+	 * @brief Acquire a number of triggered segments back to back
+	 * @param nb_segments The number of segments
+	 * @param nb_samples The number of samples of each segment
+	 * @return The segments, each with the host timestamp of its block
+	 * @throw EXC_INVALID_PARAMETER if nb_segments is 0
+	 * @note Each segment waits for its own trigger event: the streaming flag of the digital
+	 * trigger is cleared during the acquisition and restored afterwards
+	 * @note The buffer is created once and refilled for each segment; up to the number of
+	 * kernel buffers set by setKernelBuffersCountIn() segments are armed ahead, so bursts
+	 * of trigger events are caught while the previous segments are read
+	 * @note Due to a hardware limitation, the number of samples must
+	 * be a multiple of 4 and greater than 16.
+	 */
+	virtual std::vector<DIGITAL_SEGMENT> getSegments(unsigned int nb_segments, unsigned int nb_samples) = 0;
+
 
 	/**
 	 * @brief Force the digital interface to use the analogical rate
@@ -440,6 +529,84 @@ public:
 	 * @note Only available from firmware v0.26.
 	 */
 	virtual bool isClocksourceExternal() = 0;
+
+	/**
+	 * @brief Retrieve a specific number of samples without blocking
+	 * @param nb_samples The number of samples that will be retrieved
+	 * @return A handle which provides the samples once the acquisition is done
+	 *
+	 * @note The asynchronous operations of the Digital segment run one after the other on a
+	 * background thread; the Digital segment should not be used from other threads meanwhile
+	 * @note Due to a hardware limitation, the number of samples must
+	 * be a multiple of 4 and greater than 16.
+	 */
+	virtual libm2k::AsyncResult<std::vector<unsigned short>> getSamplesAsync(unsigned int nb_samples) = 0;
+
+	/**
+	 * @brief Send the samples to all the digital channels without blocking
+	 * @param data The vector containing all the samples; it is copied
+	 * @return A handle which finishes once the samples were pushed
+	 */
+	virtual libm2k::AsyncOperation pushAsync(std::vector<unsigned short> const &data) = 0;
+
+	/**
+	 * @brief Acquire buffers continuously in the background and pass each of them to a callback
+	 * @param nb_samples The number of samples in each buffer
+	 * @param callback Function called from the background thread with each acquired buffer
+	 * @return A handle which finishes when the subscription ends; it carries the error that
+	 * stopped the acquisition, if any
+	 *
+	 * @note Only one subscription can be active at a time
+	 */
+	virtual libm2k::AsyncOperation subscribeSamples(unsigned int nb_samples,
+			std::function<void(const std::vector<unsigned short> &)> callback) = 0;
+
+	/**
+	 * @brief Stop the active subscription, if any
+	 */
+	virtual void unsubscribeSamples() = 0;
+
+	/**
+	 * @brief Retrieve the position and the continuity of the last block of samples acquired
+	 *
+	 * @return The sequence number, host timestamp and gap flags of the block
+	 *
+	 * @note Each buffer refill is one block, whichever method acquired it. A block is
+	 * marked as a gap if the buffer was created again since the previous block
+	 * (new number of samples, stopped or failed acquisition).
+	 * @note Without the digital streaming flag of the trigger, each block is a separate
+	 * triggered capture: every block but the first is a gap, and starts at sample 0.
+	 */
+	virtual libm2k::STREAM_BLOCK_INFO getLastBlockInfo() = 0;
+
+	/**
+	 * @brief Retrieve the number of blocks which did not follow the previous one without loss
+	 *
+	 * @return The number of gaps since the stream information was reset
+	 */
+	virtual unsigned long long getGapCount() = 0;
+
+	/**
+	 * @brief Restart the numbering of the blocks and of the samples and clear the gap counter
+	 */
+	virtual void resetStreamInfo() = 0;
+
+	/**
+	 * @brief Check the overflow flag of the hardware after each acquired block
+	 *
+	 * @param enable True to check the flag, False to stop
+	 * @throw EXC_INVALID_PARAMETER if enabled: the logic analyzer does not report overflows
+	 *
+	 * @note Only the analog input supports the overflow detection for now.
+	 */
+	virtual void setOverflowDetection(bool enable) = 0;
+
+	/**
+	 * @brief Check if the overflow flag of the hardware is checked after each block
+	 *
+	 * @return True if the overflows are detected
+	 */
+	virtual bool getOverflowDetection() = 0;
 };
 }
 }
@@ -66,6 +66,16 @@ namespace libm2k {
 	};
 
 
+	/**
+	* @struct CALIBRATION_TIMING enums.hpp libm2k/enums.hpp
+	* @brief Duration of one phase of the last calibration
+	*/
+	struct CALIBRATION_TIMING {
+		std::string phase; ///< The name of the phase
+		double duration; ///< The duration of the phase, in milliseconds
+	};
+
+
 	/**
 	 * @private
 	 */
@@ -88,6 +98,19 @@ namespace libm2k {
 	};
 
 
+	/**
+	* @enum TRACE_CATEGORY
+	* @brief Groups of events recorded by the tracer, combined as a bit mask
+	*
+	*/
+	enum TRACE_CATEGORY {
+		TRACE_NONE = 0, ///< Nothing is traced
+		TRACE_BUFFER = 1, ///< Buffer pushes and refills
+		TRACE_ATTRIBUTE = 2, ///< Device, channel and buffer attribute reads and writes
+		TRACE_ALL = 3 ///< All the categories
+	};
+
+
 	/**
 	* @enum M2K_TRIGGER_CONDITION_ANALOG for the analog side
 	* @brief Condition of triggering
@@ -242,6 +265,54 @@ namespace libm2k {
 	};
 
 
+	/**
+	* @struct METRIC_SUMMARY enums.hpp libm2k/enums.hpp
+	* @brief Statistics of one operation of one device, as measured by libm2k
+	*/
+	struct METRIC_SUMMARY {
+		std::string name; ///< The operation: buffer_create, buffer_refill, buffer_push, attribute_read, attribute_write, conversion, spi_transfer, i2c_transfer or multibus_transfer
+		std::string device; ///< The name of the IIO device
+		unsigned long long count; ///< The number of operations
+		unsigned long long errors; ///< The number of operations which failed
+		unsigned long long bytes; ///< The number of bytes transferred or converted
+		double sum; ///< The total duration, in seconds
+		double min; ///< The shortest duration, in seconds
+		double max; ///< The longest duration, in seconds
+		double p50; ///< The median duration, in seconds
+		double p90; ///< The 90th percentile of the duration, in seconds
+		double p99; ///< The 99th percentile of the duration, in seconds
+		double p999; ///< The 99.9th percentile of the duration, in seconds
+	};
+
+
+	/**
+	* @struct WAVEFORM_CACHE_STATS enums.hpp libm2k/enums.hpp
+	* @brief Use of the cache holding the raw buffers of the cyclic waveforms pushed recently
+	*/
+	struct WAVEFORM_CACHE_STATS {
+		unsigned long long hits; ///< The number of pushes which reused a cached buffer
+		unsigned long long misses; ///< The number of pushes which converted their samples
+		unsigned long long evictions; ///< The number of buffers dropped to stay within the size limit
+		unsigned int entries; ///< The number of buffers in the cache
+		unsigned long long bytes; ///< The size of the buffers in the cache, in bytes
+	};
+
+
+	/**
+	* @struct STREAM_BLOCK_INFO enums.hpp libm2k/enums.hpp
+	* @brief Position and continuity of one block of samples acquired by an instrument
+	*/
+	struct STREAM_BLOCK_INFO {
+		unsigned long long sequence; ///< The number of the block, counted from 0 since the stream information was reset
+		unsigned long long first_sample; ///< The index of the first sample of the block among the samples streamed since the reset; 0 for a triggered capture
+		unsigned int nb_samples; ///< The number of samples of the block, for each channel
+		double timestamp; ///< The host time at which the block was received, in seconds since the Unix epoch
+		bool restarted; ///< True if the buffer was created again before this block, so the acquisition started over
+		bool overflow; ///< True if the hardware reported samples dropped since the previous block
+		bool gap; ///< True if samples may be missing between the previous block and this one
+	};
+
+
 	/**
 	 * @private
 	 */
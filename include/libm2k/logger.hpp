@@ -46,8 +46,14 @@ namespace libm2k {
 #ifdef LIBM2K_ENABLE_LOG
 #include <glog/logging.h>
 
-#define LIBM2K_LOG(S, M) LOG(S) << (M)
-#define LIBM2K_LOG_IF(S, COND,M) LOG_IF(S, COND) << (M)
+#define LIBM2K_SEVERITY_INFO 0
+#define LIBM2K_SEVERITY_WARNING 1
+#define LIBM2K_SEVERITY_ERROR 2
+#define LIBM2K_SEVERITY_FATAL 3
+
+// The message is only built when its severity passes --minloglevel
+#define LIBM2K_LOG(S, M) LOG_IF(S, LIBM2K_SEVERITY_##S >= FLAGS_minloglevel) << (M)
+#define LIBM2K_LOG_IF(S, COND, M) LOG_IF(S, (LIBM2K_SEVERITY_##S >= FLAGS_minloglevel) && (COND)) << (M)
 
 #else
 
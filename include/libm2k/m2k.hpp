@@ -117,6 +117,77 @@ public:
 	virtual double calibrateFromContext() = 0;
 
 
+	/**
+	 * @brief Calibrate both ADC and DACs using parameters interpolated from the lookup table in context
+	 * @return The board temperature the parameters were interpolated for
+	 *
+	 * @note The parameters are interpolated linearly between the two lookup table entries
+	 * around the board temperature; outside the table the closest entry is used.
+	 * @note Only available from firmware v0.26.
+	 */
+	virtual double calibrateFromContextInterpolated() = 0;
+
+
+	/**
+	 * @brief Follow the board temperature and reapply the interpolated calibration from context
+	 *
+	 * The calibration is applied right away, then the temperature is read every period_ms
+	 * milliseconds on a background thread; once it drifted by at least threshold degrees
+	 * since the last update, the interpolated gains and offsets are written again.
+	 * @param threshold The temperature change which triggers an update, in degrees Celsius
+	 * @param period_ms The time between two temperature readings, in milliseconds
+	 *
+	 * @note The update only writes the calibration registers, so running acquisitions and
+	 * generated signals are not stopped; the vertical offsets of the ADC are kept.
+	 * @note A running calibration delays the update to the next reading.
+	 * @note Only available from firmware v0.26.
+	 */
+	virtual void startTemperatureTracking(double threshold = 1.0, unsigned int period_ms = 5000) = 0;
+
+
+	/**
+	 * @brief Stop following the board temperature
+	 */
+	virtual void stopTemperatureTracking() = 0;
+
+
+	/**
+	 * @brief Check if the board temperature is followed
+	 * @return True if the calibration is updated when the temperature changes
+	 */
+	virtual bool isTemperatureTracking() = 0;
+
+
+	/**
+	* @brief Retrieve the duration of each phase of the last calibration
+	*
+	* @return A list of phases (adc_offset, adc_fine_tune, adc_gain, dac_setup,
+	* dac_offset, dac_gain and total) with their duration in milliseconds
+	*
+	* @note The DAC setup of calibrate() runs while the ADC is being calibrated
+	*/
+	virtual std::vector<libm2k::CALIBRATION_TIMING> getCalibrationTimings() = 0;
+
+
+	/**
+	* @brief Calibrate the board using the parameters of a previous calibration
+	*
+	* The parameters of every successful calibration are stored in a cache file on this host,
+	* for the serial number, the firmware version and the temperature of the board.
+	* If the cache holds parameters for this board measured close enough to the current
+	* temperature, they are loaded; otherwise a full calibration is run and its result is cached.
+	*
+	* @param max_temperature_difference The maximum difference between the current temperature
+	* and the one of the cached parameters, in degrees Celsius
+	* @return On succces, true
+	* @return Otherwise, false
+	*
+	* @note The cache file is $LIBM2K_CALIBRATION_CACHE if set, otherwise libm2k/calibration.cache
+	* in the user cache directory (XDG_CACHE_HOME, ~/.cache or LOCALAPPDATA)
+	*/
+	virtual bool calibrateFromCache(double max_temperature_difference = 2.0) = 0;
+
+
 	/**
 	* @brief Retrieve the Digital object
 	*
@@ -24,6 +24,7 @@
 
 #include <libm2k/m2kglobal.hpp>
 #include <libm2k/m2khardwaretrigger.hpp>
+#include <libm2k/enums.hpp>
 #include <cstdint>
 #include <cstdlib>
 #include <string>
@@ -53,6 +54,8 @@ public:
 	virtual bool getAdcCalibrated() const = 0;
 	virtual bool getDacCalibrated() const = 0;
 
+	virtual std::vector<CALIBRATION_TIMING> getCalibrationTimings() const = 0;
+
 
 	virtual bool resetCalibration() = 0;
 
@@ -60,6 +63,9 @@ public:
 	virtual void setDacOffset(unsigned int chn, int offset) = 0;
 	virtual void setAdcOffset(unsigned int chn, int offset) = 0;
 	virtual void setAdcGain(unsigned int chn, double gain) = 0;
+
+	/* Write all the parameters, keeping the vertical offsets of the ADC */
+	virtual void updateCalibrationParameters(const CALIBRATION_PARAMETERS &parameters) = 0;
 };
 
 }
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <libm2k/m2kglobal.hpp>
+#include <libm2k/enums.hpp>
+#include <string>
+#include <vector>
+
+namespace libm2k {
+
+/**
+ * @addtogroup m2k
+ * @{
+ */
+
+/**
+ * @brief Enable or disable the collection of metrics
+ * @param enable True to measure the operations, False to stop
+ *
+ * @note The metrics are collected by default. The buffer creations, refills and pushes,
+ * the attribute accesses and the conversion of the samples are measured for each device,
+ * as well as the SPI, I2C and multi-bus transfers of the communication tools.
+ */
+LIBM2K_API void enableMetrics(bool enable);
+
+
+/**
+ * @brief Check if the metrics are collected
+ * @return True if the operations are measured
+ */
+LIBM2K_API bool isMetricsEnabled();
+
+
+/**
+ * @brief Retrieve the statistics of all the operations measured so far
+ * @return A list of summaries, one for each operation of each device
+ *
+ * @note The percentiles are computed from histograms with a relative error below 7%.
+ */
+LIBM2K_API std::vector<libm2k::METRIC_SUMMARY> getMetrics();
+
+
+/**
+ * @brief Drop all the collected measurements
+ */
+LIBM2K_API void resetMetrics();
+
+
+/**
+ * @brief Retrieve the collected metrics in the Prometheus text exposition format
+ * @return The metrics as text, ready to be served to a Prometheus scraper
+ *
+ * @note Each operation is exported as a summary libm2k_<operation>_seconds, with
+ * the device as label, together with the libm2k_<operation>_errors_total and
+ * libm2k_<operation>_bytes_total counters.
+ */
+LIBM2K_API std::string getPrometheusMetrics();
+
+/** @} */
+}
+
+#endif //METRICS_HPP
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef MULTIBUS_HPP
+#define MULTIBUS_HPP
+
+#include <libm2k/m2kglobal.hpp>
+#include <libm2k/tools/spi.hpp>
+#include <libm2k/tools/i2c.hpp>
+#include <libm2k/tools/uart.hpp>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+* @addtogroup communication
+* @{
+* @defgroup multibus Multi-bus
+* @brief Runs transfers on several SPI, I2C and UART buses at the same time
+* @{
+*/
+
+/**
+ * @brief Protocol of a multi-bus transfer
+ */
+typedef enum multibus_protocol {
+	MULTIBUS_SPI = 0,
+	MULTIBUS_I2C = 1,
+	MULTIBUS_UART = 2
+} multibus_protocol;
+
+/**
+ * @brief Operation of a multi-bus transfer
+ */
+typedef enum multibus_operation {
+	MULTIBUS_WRITE = 0, ///< spi_write_only(), i2c_write() or uart_write()
+	MULTIBUS_READ = 1 ///< spi_write_and_read(), i2c_read() or uart_read()
+} multibus_operation;
+
+/**
+ * @brief Transfer on one of the buses run by multibus_run()
+ */
+typedef struct multibus_transfer {
+	enum multibus_protocol protocol;
+	enum multibus_operation operation;
+	struct spi_desc *spi; ///< The SPI descriptor, for MULTIBUS_SPI
+	struct i2c_desc *i2c; ///< The I2C descriptor, for MULTIBUS_I2C
+	struct uart_desc *uart; ///< The UART descriptor, for MULTIBUS_UART
+	uint8_t *data; ///< The transmitted data, replaced by the received data on MULTIBUS_READ
+	uint8_t bytes_number;
+	uint8_t option; ///< The I2C transfer option, ignored by the other protocols
+	int32_t status; ///< Set by multibus_run(): 0 in case of success, -1 otherwise
+} multibus_transfer;
+
+/**
+ * @brief Run the transfers of several buses in parallel
+ * @param transfers - The transfers, at most one for each bus
+ * @param transfers_number - Number of transfers
+ * @return 0 if all the transfers succeeded, -1 otherwise
+ *
+ * The waveforms of all the buses are merged into a single pattern generator
+ * buffer, which is pushed once while the logic analyzer captures all the
+ * lines; the capture is then decoded for each bus separately. The buses must
+ * be initialized on the same context and use disjoint DIO pins. When their
+ * sample rates differ, all of them run at the highest one.
+ *
+ * @note The status of each transfer tells which of the buses failed
+ */
+LIBM2K_API int32_t multibus_run(struct multibus_transfer *transfers, uint8_t transfers_number);
+
+/**
+* @}
+* @}
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //MULTIBUS_HPP
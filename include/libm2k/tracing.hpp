@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TRACING_HPP
+#define TRACING_HPP
+
+#include <libm2k/m2kglobal.hpp>
+#include <libm2k/enums.hpp>
+#include <string>
+
+namespace libm2k {
+
+/**
+ * @addtogroup m2k
+ * @{
+ */
+
+/**
+ * @brief Select the categories of events recorded by the tracer
+ * @param categories A bit mask of libm2k::TRACE_CATEGORY values; TRACE_NONE stops the tracing
+ *
+ * @note Each thread records its events in a ring of fixed size, without locking,
+ * so only the most recent events of each thread are kept.
+ * @note The categories left out at build time (TRACE_CATEGORIES CMake option) are never recorded.
+ */
+LIBM2K_API void enableTracing(unsigned int categories);
+
+
+/**
+ * @brief Retrieve the categories of events recorded by the tracer
+ * @return A bit mask of libm2k::TRACE_CATEGORY values
+ */
+LIBM2K_API unsigned int getTracingCategories();
+
+
+/**
+ * @brief Drop all the recorded events
+ */
+LIBM2K_API void clearTrace();
+
+
+/**
+ * @brief Retrieve the recorded events in the Chrome trace event format
+ * @return A JSON document, which can be loaded in chrome://tracing or https://ui.perfetto.dev
+ *
+ * @note Each event holds its start time and duration in microseconds and the device,
+ * operation and size (number of samples for buffers) as arguments.
+ */
+LIBM2K_API std::string getChromeTrace();
+
+
+/**
+ * @brief Write the recorded events to a file in the Chrome trace event format
+ * @param path The destination file
+ * @throw EXC_RUNTIME_ERROR if the file cannot be written
+ */
+LIBM2K_API void writeChromeTrace(const std::string &path);
+
+/** @} */
+}
+
+#endif //TRACING_HPP
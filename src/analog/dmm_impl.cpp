@@ -26,6 +26,7 @@
 #include "utils/channel.hpp"
 #include <iio.h>
 #include <iostream>
+#include <chrono>
 
 using namespace libm2k::analog;
 using namespace libm2k::utils;
@@ -45,10 +46,12 @@ DMMImpl::DMMImpl(struct iio_context *ctx, std::string dev, bool sync)
 	}
 
 	generateDictionaries();
+	loadChannelDescriptors();
 }
 
 DMMImpl::~DMMImpl()
 {
+	m_sampler.stop();
 	for (auto d : m_device_in_list) {
 		delete d;
 	}
@@ -57,7 +60,8 @@ DMMImpl::~DMMImpl()
 
 void DMMImpl::reset()
 {
-
+	m_sampler.stop();
+	loadChannelDescriptors();
 }
 
 DeviceIn* DMMImpl::getDevice(unsigned int index)
@@ -71,14 +75,12 @@ DeviceIn* DMMImpl::getDevice(unsigned int index)
 
 DMM_READING DMMImpl::readChannel(unsigned int index)
 {
-	std::string chn_name = "";
-	for (auto pair : m_channel_id_list) {
-		if (pair.second == index) {
-			chn_name = pair.first;
-			break;
-		}
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto it = m_desc_by_index.find(index);
+	if (it == m_desc_by_index.end()) {
+		THROW_M2K_EXCEPTION("DMM: No such channel " + std::to_string(index), libm2k::EXC_OUT_OF_RANGE);
 	}
-	return readChannel(chn_name);
+	return read(m_descriptors.at(it->second));
 }
 
 std::vector<std::string> DMMImpl::getAllChannels()
@@ -145,78 +147,133 @@ void DMMImpl::generateDictionaries()
 
 }
 
-DMM_READING DMMImpl::readChannel(std::string chn_name)
+void DMMImpl::loadChannelDescriptors()
 {
-	DMM_READING result;
-	double value = 0;
-	double offset = 0;
-	double scale = 1;
-	std::string id = getDevice(0)->getChannel(m_channel_id_list.at(chn_name), false)->getId();
-	std::string name = getDevice(0)->getChannel(m_channel_id_list.at(chn_name), false)->getName();
-	unsigned int index = m_channel_id_list.at(chn_name);
-	auto channel = getDevice(0)->getChannel(index, false);
-	if (channel->hasAttribute("raw")) {
-		value = channel->getDoubleValue("raw");
-	} else if (channel->hasAttribute("processed")) {
-		value = channel->getDoubleValue("processed");
-	} else if (channel->hasAttribute("input")) {
-		value = channel->getDoubleValue("input");
-	} else {
-		THROW_M2K_EXCEPTION("DMM: Cannot read channel " + getName() + " : " + chn_name, libm2k::EXC_OUT_OF_RANGE);
-	}
-
-	if (channel->hasAttribute("offset")) {
-		offset = channel->getDoubleValue("offset");
-	}
-
-	if (channel->hasAttribute("scale")) {
-		scale = channel->getDoubleValue("scale");
-	}
-
-	bool isHwmon = iio_device_is_hwmon(channel->getDevice());
-
-	dmm_info dmm;
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_descriptors.clear();
+	m_desc_by_name.clear();
+	m_desc_by_index.clear();
 
-	if (isHwmon) {
-		int type = hwmon_channel_get_type(channel->getChannel());
+	for (auto pair : m_channel_id_list) {
+		dmm_channel_desc desc;
+		auto channel = getDevice(0)->getChannel(pair.second, false);
+		desc.channel = channel;
+		desc.id = channel->getId();
+		desc.name = channel->getName();
+
+		if (channel->hasAttribute("raw")) {
+			desc.value_attr = "raw";
+		} else if (channel->hasAttribute("processed")) {
+			desc.value_attr = "processed";
+		} else if (channel->hasAttribute("input")) {
+			desc.value_attr = "input";
+		}
 
-		if (type != hwmon_chan_type::HWMON_CHAN_TYPE_UNKNOWN) {
-			dmm = m_hwmonDevices[type];
-			dmm.value = (value + offset) * scale * dmm.umScale;
-		} else {
-			dmm.key = "";
-			dmm.key_symbol = "";
+		// offset and scale don't change at runtime for the DMM channels, so they are read only once
+		if (channel->hasAttribute("offset")) {
+			desc.offset = channel->getDoubleValue("offset");
+		}
+		if (channel->hasAttribute("scale")) {
+			desc.scale = channel->getDoubleValue("scale");
 		}
-	} else {
-		int type = iio_channel_get_type(channel->getChannel());
 
-		if (type != iio_chan_type::IIO_CHAN_TYPE_UNKNOWN) {
-			dmm = m_iioDevices[type];
-			dmm.value = (value + offset) * scale * dmm.umScale;
+		if (iio_device_is_hwmon(channel->getDevice())) {
+			int type = hwmon_channel_get_type(channel->getChannel());
+			if (type != hwmon_chan_type::HWMON_CHAN_TYPE_UNKNOWN) {
+				desc.unit = m_hwmonDevices[type];
+				desc.has_unit = true;
+			}
 		} else {
-			dmm.key = "";
-			dmm.key_symbol = "";
+			int type = iio_channel_get_type(channel->getChannel());
+			if (type != iio_chan_type::IIO_CHAN_TYPE_UNKNOWN) {
+				desc.unit = m_iioDevices[type];
+				desc.has_unit = true;
+			}
 		}
+
+		m_desc_by_name[pair.first] = m_descriptors.size();
+		m_desc_by_index[pair.second] = m_descriptors.size();
+		m_descriptors.push_back(desc);
 	}
+}
 
-	result.id = id;
-	result.name = name;
-	result.unit_name = dmm.key;
-	result.unit_symbol = dmm.key_symbol;
-	result.value = dmm.value;
+DMM_READING DMMImpl::read(const dmm_channel_desc &desc)
+{
+	if (desc.value_attr.empty()) {
+		THROW_M2K_EXCEPTION("DMM: Cannot read channel " + getName() + " : " + desc.id, libm2k::EXC_OUT_OF_RANGE);
+	}
+	double value = desc.channel->getDoubleValue(desc.value_attr);
+
+	DMM_READING result;
+	result.id = desc.id;
+	result.name = desc.name;
+	result.unit_name = desc.unit.key;
+	result.unit_symbol = desc.unit.key_symbol;
+	result.value = desc.has_unit ? (value + desc.offset) * desc.scale * desc.unit.umScale : 0;
 	return result;
 }
 
+DMM_READING DMMImpl::readChannel(std::string chn_name)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto it = m_desc_by_name.find(chn_name);
+	if (it == m_desc_by_name.end()) {
+		THROW_M2K_EXCEPTION("DMM: No such channel " + chn_name, libm2k::EXC_OUT_OF_RANGE);
+	}
+	return read(m_descriptors.at(it->second));
+}
+
 std::vector<DMM_READING> DMMImpl::readAll()
 {
-	std::vector<DMM_READING> result = {};
-	for (auto pair : m_channel_id_list) {
-		DMM_READING res = readChannel(pair.first);
-		result.push_back(res);
+	std::lock_guard<std::mutex> lock(m_lock);
+	std::vector<DMM_READING> result;
+	result.reserve(m_descriptors.size());
+	for (auto &desc : m_descriptors) {
+		result.push_back(read(desc));
 	}
 	return result;
 }
 
+void DMMImpl::startSampling(unsigned int period_ms, unsigned int buffer_size)
+{
+	if (buffer_size == 0) {
+		THROW_M2K_EXCEPTION("DMM: The sample buffer size must be greater than 0", libm2k::EXC_INVALID_PARAMETER);
+	}
+	m_sampler.stop();
+	{
+		std::lock_guard<std::mutex> lock(m_samples_lock);
+		m_samples.reset(buffer_size);
+	}
+	m_sampler.start(std::chrono::milliseconds(period_ms), std::bind(&DMMImpl::storeSample, this));
+}
+
+void DMMImpl::stopSampling()
+{
+	m_sampler.stop();
+}
+
+bool DMMImpl::isSampling()
+{
+	return m_sampler.isRunning();
+}
+
+std::vector<DMM_SAMPLE> DMMImpl::readSamples()
+{
+	std::lock_guard<std::mutex> lock(m_samples_lock);
+	return m_samples.drain();
+}
+
+void DMMImpl::storeSample()
+{
+	DMM_SAMPLE sample;
+	auto now = std::chrono::system_clock::now().time_since_epoch();
+	sample.timestamp = std::chrono::duration_cast<std::chrono::duration<double>>(now).count();
+	sample.readings = readAll();
+
+	std::lock_guard<std::mutex> lock(m_samples_lock);
+	m_samples.push(std::move(sample));
+}
+
 string DMMImpl::getName()
 {
 	return getDevice(0)->getName();
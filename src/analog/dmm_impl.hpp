@@ -25,8 +25,11 @@
 #include <libm2k/analog/dmm.hpp>
 #include <libm2k/analog/enums.hpp>
 #include "utils/devicein.hpp"
+#include "utils/periodictask.hpp"
+#include "utils/ringbuffer.hpp"
 #include <vector>
 #include <map>
+#include <mutex>
 #include <string>
 
 namespace libm2k {
@@ -40,6 +43,19 @@ struct dmm_info{
 	double umScale = 1;
 };
 
+/* Everything needed to turn the value attribute of a channel into a reading,
+ * resolved once instead of on every read */
+struct dmm_channel_desc {
+	libm2k::utils::Channel *channel = nullptr;
+	std::string id;
+	std::string name;
+	std::string value_attr;
+	double offset = 0;
+	double scale = 1;
+	bool has_unit = false;
+	dmm_info unit;
+};
+
 class DMMImpl : public DMM {
 public:
 	DMMImpl(struct iio_context *ctx, std::string dev, bool sync);
@@ -56,14 +72,31 @@ public:
 
 	std::string getName();
 
+	void startSampling(unsigned int period_ms, unsigned int buffer_size = 1024);
+	void stopSampling();
+	bool isSampling();
+	std::vector<libm2k::analog::DMM_SAMPLE> readSamples();
+
 private:
 	std::map<std::string, unsigned int> m_channel_id_list;
 	std::string m_dev_name;
 	std::vector<libm2k::utils::DeviceIn*> m_device_in_list;
 	libm2k::utils::DeviceIn *getDevice(unsigned int index);
 	void generateDictionaries();
+	void loadChannelDescriptors();
+	libm2k::analog::DMM_READING read(const dmm_channel_desc &desc);
+	void storeSample();
 	std::map<int,dmm_info> m_iioDevices;
 	std::map<int,dmm_info> m_hwmonDevices;
+
+	std::mutex m_lock;
+	std::vector<dmm_channel_desc> m_descriptors;
+	std::map<std::string, size_t> m_desc_by_name;
+	std::map<unsigned int, size_t> m_desc_by_index;
+
+	std::mutex m_samples_lock;
+	libm2k::utils::RingBuffer<libm2k::analog::DMM_SAMPLE> m_samples;
+	libm2k::utils::PeriodicTask m_sampler;
 };
 }
 }
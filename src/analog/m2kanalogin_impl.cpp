@@ -40,12 +40,16 @@ M2kAnalogInImpl::M2kAnalogInImpl(iio_context * ctx, std::string adc_dev, bool sy
 	M2kAnalogIn(),
 	m_need_processing(false),
 	m_max_samplerate(-1),
-	m_trigger(trigger)
+	m_trigger(trigger),
+	m_async_worker(new libm2k::utils::AsyncWorker()),
+	m_subscription(0),
+	m_last_subscription_id(0)
 {
 	LIBM2K_LOG(INFO, "[BEGIN] Initialize M2kAnalogIn");
 	firmware_version = Utils::getFirmwareVersion(ctx);
 
 	m_m2k_adc = make_shared<DeviceIn>(ctx, adc_dev);
+	m_conversion_metric = libm2k::utils::metrics::get("conversion", adc_dev);
 	m_m2k_fabric = make_shared<DeviceGeneric>(ctx, "m2k-fabric");
 	m_ad5625_dev = make_shared<DeviceGeneric>(ctx, "ad5625");
 
@@ -79,6 +83,10 @@ M2kAnalogInImpl::M2kAnalogInImpl(iio_context * ctx, std::string adc_dev, bool sy
 	// data_available attribute exists only in firmware versions newer than 0.23
 	m_data_available = m_m2k_adc->hasBufferAttribute("data_available");
 
+	m_m2k_adc->setStreamingCheck([this]() {
+		return m_trigger->getAnalogStreamingFlag();
+	});
+
 	if (sync) {
 		syncDevice();
 	}
@@ -87,7 +95,14 @@ M2kAnalogInImpl::M2kAnalogInImpl(iio_context * ctx, std::string adc_dev, bool sy
 
 
 
-M2kAnalogInImpl::~M2kAnalogInImpl() = default;
+M2kAnalogInImpl::~M2kAnalogInImpl()
+{
+	if (m_subscription.exchange(0) != 0) {
+		// unblock the refill of the subscription so the worker can be joined
+		m_m2k_adc->cancelBuffer();
+	}
+	m_async_worker->stop();
+}
 
 void M2kAnalogInImpl::enableChannel(unsigned int chn_idx, bool enable)
 {
@@ -361,6 +376,124 @@ void M2kAnalogInImpl::getSamples(std::vector<std::vector<double> > &data, unsign
 	LIBM2K_LOG(INFO, "[END] M2kAnalogIn getSamples");
 }
 
+void M2kAnalogInImpl::getSamplesInto(double *data, unsigned int nb_samples)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kAnalogIn getSamplesInto");
+	m_samplerate = getSampleRate();
+	handleChannelsEnableState(true);
+
+	const short *raw = m_m2k_adc->getSamplesRawInterleaved(nb_samples);
+	const unsigned int nb_channels = getNbChannels();
+	const double filter_compensation = getFilterCompensation(m_samplerate);
+	{
+		libm2k::utils::metrics::Timer timer(m_conversion_metric, (uint64_t)nb_samples * nb_channels * sizeof(short));
+		for (unsigned int ch = 0; ch < nb_channels; ch++) {
+			double *dst = data + (size_t)ch * nb_samples;
+			if (!m_channels_enabled.at(ch)) {
+				std::fill(dst, dst + nb_samples, 0.0);
+				continue;
+			}
+			// the conversion is linear, so compute the factors once per channel instead of once per sample
+			const double scale = convRawToVolts(1, m_adc_calib_gain.at(ch),
+							    getValueForRange(m_input_range.at(ch)), filter_compensation);
+			const double offset = -m_adc_hw_vert_offset.at(ch);
+			for (unsigned int i = 0; i < nb_samples; i++) {
+				dst[i] = raw[(size_t)i * nb_channels + ch] * scale + offset;
+			}
+		}
+	}
+
+	handleChannelsEnableState(false);
+	LIBM2K_LOG(INFO, "[END] M2kAnalogIn getSamplesInto");
+}
+
+void M2kAnalogInImpl::getSamplesRawInto(short *data, unsigned int nb_samples)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kAnalogIn getSamplesRawInto");
+	m_samplerate = getSampleRate();
+	handleChannelsEnableState(true);
+
+	const short *raw = m_m2k_adc->getSamplesRawInterleaved(nb_samples);
+	const unsigned int nb_channels = getNbChannels();
+	for (unsigned int ch = 0; ch < nb_channels; ch++) {
+		short *dst = data + (size_t)ch * nb_samples;
+		if (!m_channels_enabled.at(ch)) {
+			std::fill(dst, dst + nb_samples, 0);
+			continue;
+		}
+		for (unsigned int i = 0; i < nb_samples; i++) {
+			dst[i] = raw[(size_t)i * nb_channels + ch];
+		}
+	}
+
+	handleChannelsEnableState(false);
+	LIBM2K_LOG(INFO, "[END] M2kAnalogIn getSamplesRawInto");
+}
+
+std::vector<ANALOG_SEGMENT> M2kAnalogInImpl::getSegments(unsigned int nb_segments, unsigned int nb_samples)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kAnalogIn getSegments");
+	if (nb_segments == 0) {
+		THROW_M2K_EXCEPTION("M2kAnalogIn: The number of segments must be greater than 0", libm2k::EXC_INVALID_PARAMETER);
+	}
+	m_samplerate = getSampleRate();
+	const unsigned int nb_channels = getNbChannels();
+	const size_t segment_size = (size_t)nb_samples * nb_channels;
+	std::vector<short> raw(segment_size * nb_segments);
+	std::vector<libm2k::STREAM_BLOCK_INFO> infos(nb_segments);
+
+	bool streaming = m_trigger->getAnalogStreamingFlag();
+	if (streaming) {
+		m_trigger->setAnalogStreamingFlag(false);
+	}
+	handleChannelsEnableState(true);
+	std::vector<bool> channels_enabled = m_channels_enabled;
+	__try {
+		/* The blocks already queued were triggered before this call; start from a new buffer,
+		 * then only refill it and copy the samples between two trigger events */
+		m_m2k_adc->flushBuffer();
+		for (unsigned int i = 0; i < nb_segments; i++) {
+			const short *samples = m_m2k_adc->getSamplesRawInterleaved(nb_samples);
+			std::memcpy(raw.data() + i * segment_size, samples, segment_size * sizeof(short));
+			infos[i] = m_m2k_adc->getLastBlockInfo();
+		}
+	} __catch (m2k_exception &e) {
+		handleChannelsEnableState(false);
+		if (streaming) {
+			m_trigger->setAnalogStreamingFlag(true);
+		}
+		THROW_M2K_EXCEPTION("M2kAnalogIn: " + std::string(e.what()), e.type(), e.iioCode());
+		return std::vector<ANALOG_SEGMENT>();
+	}
+	handleChannelsEnableState(false);
+	if (streaming) {
+		m_trigger->setAnalogStreamingFlag(true);
+	}
+
+	std::vector<ANALOG_SEGMENT> segments(nb_segments);
+	const double filter_compensation = getFilterCompensation(m_samplerate);
+	for (unsigned int i = 0; i < nb_segments; i++) {
+		const short *src = raw.data() + i * segment_size;
+		segments[i].info = infos[i];
+		segments[i].samples.resize(nb_channels);
+		for (unsigned int ch = 0; ch < nb_channels; ch++) {
+			if (!channels_enabled.at(ch)) {
+				continue;
+			}
+			const double scale = convRawToVolts(1, m_adc_calib_gain.at(ch),
+							    getValueForRange(m_input_range.at(ch)), filter_compensation);
+			const double offset = -m_adc_hw_vert_offset.at(ch);
+			std::vector<double> &dst = segments[i].samples[ch];
+			dst.resize(nb_samples);
+			for (unsigned int k = 0; k < nb_samples; k++) {
+				dst[k] = src[(size_t)k * nb_channels + ch] * scale + offset;
+			}
+		}
+	}
+	LIBM2K_LOG(INFO, "[END] M2kAnalogIn getSegments");
+	return segments;
+}
+
 string M2kAnalogInImpl::getChannelName(unsigned int channel)
 {
 	if (channel >= getNbChannels()) {
@@ -383,6 +516,64 @@ double M2kAnalogInImpl::getMaximumSamplerate()
 	return m_max_samplerate;
 }
 
+libm2k::AsyncResult<std::vector<std::vector<double>>> M2kAnalogInImpl::getSamplesAsync(unsigned int nb_samples)
+{
+	return m_async_worker->run<std::vector<std::vector<double>>>([this, nb_samples]() {
+		return getSamples(nb_samples);
+	});
+}
+
+libm2k::AsyncOperation M2kAnalogInImpl::subscribeSamples(unsigned int nb_samples,
+		std::function<void(const std::vector<std::vector<double>> &)> callback)
+{
+	unsigned long long id = ++m_last_subscription_id;
+	unsigned long long none = 0;
+	if (!m_subscription.compare_exchange_strong(none, id)) {
+		THROW_M2K_EXCEPTION("M2kAnalogIn: a subscription is already active", libm2k::EXC_INVALID_PARAMETER);
+	}
+	/* The worker runs one task at a time, so this loop starts only once the loop of a
+	 * previous subscription returned; each loop only follows its own id */
+	return m_async_worker->run([this, id, nb_samples, callback]() {
+		libm2k::utils::AsyncTokenRelease<unsigned long long> release(m_subscription, id, 0);
+		std::vector<std::vector<double>> data;
+		while (m_subscription == id) {
+			getSamples(data, nb_samples);
+			callback(data);
+		}
+		stopAcquisition();
+	});
+}
+
+void M2kAnalogInImpl::unsubscribeSamples()
+{
+	m_subscription = 0;
+}
+
+libm2k::STREAM_BLOCK_INFO M2kAnalogInImpl::getLastBlockInfo()
+{
+	return m_m2k_adc->getLastBlockInfo();
+}
+
+unsigned long long M2kAnalogInImpl::getGapCount()
+{
+	return m_m2k_adc->getGapCount();
+}
+
+void M2kAnalogInImpl::resetStreamInfo()
+{
+	m_m2k_adc->resetStreamInfo();
+}
+
+void M2kAnalogInImpl::setOverflowDetection(bool enable)
+{
+	m_m2k_adc->setOverflowDetection(enable);
+}
+
+bool M2kAnalogInImpl::getOverflowDetection()
+{
+	return m_m2k_adc->getOverflowDetection();
+}
+
 void M2kAnalogInImpl::deinitialize()
 {
 	// The vertical offset register in the device has dual purpose:
@@ -455,6 +646,57 @@ const short *M2kAnalogInImpl::getSamplesRawInterleaved_matlab(unsigned int nb_sa
 	return this->getSamplesRawInterleaved(nb_samples / getNbChannels());
 }
 
+void M2kAnalogInImpl::getSamplesInterleavedInto(double *data, unsigned int nb_samples_per_channel)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kAnalogIn getSamplesInterleavedInto");
+	m_samplerate = getSampleRate();
+	handleChannelsEnableState(true);
+
+	const short *raw = m_m2k_adc->getSamplesRawInterleaved(nb_samples_per_channel);
+	const unsigned int nb_channels = getNbChannels();
+	const double filter_compensation = getFilterCompensation(m_samplerate);
+	std::vector<double> scale, offset;
+
+	for (unsigned int ch = 0; ch < nb_channels; ch++) {
+		scale.push_back(convRawToVolts(1, m_adc_calib_gain.at(ch),
+					       getValueForRange(m_input_range.at(ch)), filter_compensation));
+		offset.push_back(-m_adc_hw_vert_offset.at(ch));
+	}
+
+	const size_t nb_values = (size_t)nb_samples_per_channel * nb_channels;
+	for (size_t i = 0; i < nb_values; i += nb_channels) {
+		for (unsigned int ch = 0; ch < nb_channels; ch++) {
+			data[i + ch] = raw[i + ch] * scale[ch] + offset[ch];
+		}
+	}
+
+	handleChannelsEnableState(false);
+	LIBM2K_LOG(INFO, "[END] M2kAnalogIn getSamplesInterleavedInto");
+}
+
+void M2kAnalogInImpl::getSamplesRawInterleavedInto(short *data, unsigned int nb_samples_per_channel)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kAnalogIn getSamplesRawInterleavedInto");
+	m_samplerate = getSampleRate();
+	handleChannelsEnableState(true);
+
+	const short *raw = m_m2k_adc->getSamplesRawInterleaved(nb_samples_per_channel);
+	std::copy(raw, raw + (size_t)nb_samples_per_channel * getNbChannels(), data);
+
+	handleChannelsEnableState(false);
+	LIBM2K_LOG(INFO, "[END] M2kAnalogIn getSamplesRawInterleavedInto");
+}
+
+void M2kAnalogInImpl::getSamplesInterleavedInto_matlab(double *data, unsigned int nb_samples)
+{
+	getSamplesInterleavedInto(data, nb_samples / getNbChannels());
+}
+
+void M2kAnalogInImpl::getSamplesRawInterleavedInto_matlab(short *data, unsigned int nb_samples)
+{
+	getSamplesRawInterleavedInto(data, nb_samples / getNbChannels());
+}
+
 double M2kAnalogInImpl::processSample(int16_t sample, unsigned int channel)
 {
 	if (channel >= getNbChannels()) {
@@ -25,8 +25,11 @@
 #include <libm2k/analog/m2kanalogin.hpp>
 #include "utils/devicegeneric.hpp"
 #include "utils/devicein.hpp"
+#include "utils/asyncworker.hpp"
+#include "utils/metrics.hpp"
 #include <libm2k/analog/enums.hpp>
 #include <libm2k/m2khardwaretrigger.hpp>
+#include <atomic>
 #include <vector>
 #include <map>
 
@@ -50,6 +53,10 @@ public:
 
 	const double* getSamplesInterleaved_matlab(unsigned int nb_samples) override;
 	const short* getSamplesRawInterleaved_matlab(unsigned int nb_samples) override;
+	void getSamplesInterleavedInto(double *data, unsigned int nb_samples_per_channel) override;
+	void getSamplesRawInterleavedInto(short *data, unsigned int nb_samples_per_channel) override;
+	void getSamplesInterleavedInto_matlab(double *data, unsigned int nb_samples) override;
+	void getSamplesRawInterleavedInto_matlab(short *data, unsigned int nb_samples) override;
 
 	short getVoltageRaw(unsigned int ch) override;
 	double getVoltage(unsigned int ch) override;
@@ -133,10 +140,24 @@ public:
 	void cancelAcquisition() override;
 
 	void getSamples(std::vector<std::vector<double> > &data, unsigned int nb_samples) override;
+	void getSamplesInto(double *data, unsigned int nb_samples) override;
+	void getSamplesRawInto(short *data, unsigned int nb_samples) override;
+	std::vector<ANALOG_SEGMENT> getSegments(unsigned int nb_segments, unsigned int nb_samples) override;
 
 	std::string getChannelName(unsigned int channel) override;
 	double getMaximumSamplerate() override;
 
+	libm2k::AsyncResult<std::vector<std::vector<double>>> getSamplesAsync(unsigned int nb_samples) override;
+	libm2k::AsyncOperation subscribeSamples(unsigned int nb_samples,
+			std::function<void(const std::vector<std::vector<double>> &)> callback) override;
+	void unsubscribeSamples() override;
+
+	libm2k::STREAM_BLOCK_INFO getLastBlockInfo() override;
+	unsigned long long getGapCount() override;
+	void resetStreamInfo() override;
+	void setOverflowDetection(bool enable) override;
+	bool getOverflowDetection() override;
+
 	void deinitialize();
 	bool hasCalibbias();
 	void loadNbKernelBuffers();
@@ -145,6 +166,7 @@ private:
 	std::shared_ptr<libm2k::utils::DeviceGeneric> m_ad5625_dev;
 	std::shared_ptr<libm2k::utils::DeviceGeneric> m_m2k_fabric;
 	std::shared_ptr<libm2k::utils::DeviceIn> m_m2k_adc;
+	libm2k::utils::metrics::Histogram *m_conversion_metric;
 	bool m_need_processing;
 	double m_max_samplerate;
 
@@ -162,6 +184,11 @@ private:
 	unsigned int m_nb_kernel_buffers;
 	bool m_data_available;
 
+	std::unique_ptr<libm2k::utils::AsyncWorker> m_async_worker;
+	/* The id of the active subscription, 0 if none */
+	std::atomic<unsigned long long> m_subscription;
+	std::atomic<unsigned long long> m_last_subscription_id;
+
 	void syncDevice();
 
 	M2K_RANGE getRangeDevice(ANALOG_IN_CHANNEL channel);
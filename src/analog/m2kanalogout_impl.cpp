@@ -37,8 +37,15 @@ using namespace libm2k::analog;
 using namespace libm2k::utils;
 using namespace std;
 
+/* Seed of the hash of the waveform parameters in the waveform cache */
+static const uint64_t WAVEFORM_PARAMETERS_SEED = 0x5741564546524D31ull;
+
 M2kAnalogOutImpl::M2kAnalogOutImpl(iio_context *ctx, std::vector<std::string> dac_devs, bool sync, M2kHardwareTrigger *trigger) : 
-	m_trigger(trigger)
+	m_trigger(trigger),
+	m_async_worker(new libm2k::utils::AsyncWorker()),
+	m_waveform_cache(16u << 20),
+	m_sequence_running(false),
+	m_sequence_stopped(false)
 {
 	LIBM2K_LOG(INFO, "[BEGIN] Initialize M2kAnalogOut");
 	firmware_version = Utils::getFirmwareVersion(ctx);
@@ -65,6 +72,7 @@ M2kAnalogOutImpl::M2kAnalogOutImpl(iio_context *ctx, std::vector<std::string> da
 		m_samplerate.push_back(75E6);
 		m_nb_kernel_buffers.push_back(4);
 		m_max_samplerate.push_back(-1);
+		m_synth.push_back(nullptr);
 	}
 
 	if (sync) {
@@ -95,6 +103,7 @@ M2kAnalogOutImpl::M2kAnalogOutImpl(iio_context *ctx, std::vector<std::string> da
 
 M2kAnalogOutImpl::~M2kAnalogOutImpl()
 {
+	m_async_worker->stop();
 	for (auto d : m_dac_devices) {
 		delete d;
 	}
@@ -433,12 +442,128 @@ void M2kAnalogOutImpl::pushBytes(unsigned int chnIdx, double *data, unsigned int
 	if (chnIdx >= m_dac_devices.size()) {
 		THROW_M2K_EXCEPTION("Analog Out: No such channel", libm2k::EXC_OUT_OF_RANGE);
 	}
-	std::vector<short> raw_data_buffer = {};
+	std::shared_ptr<const std::vector<short>> raw_data_buffer = convertToRaw(chnIdx, data, nb_samples);
+	m_dac_devices.at(chnIdx)->push(*raw_data_buffer, 0, getCyclic(chnIdx), false, true);
+}
+
+
+std::shared_ptr<const std::vector<short>> M2kAnalogOutImpl::convertToRaw(unsigned int chnIdx, const double *data,
+									  unsigned int nb_samples, unsigned int stride)
+{
+	if (chnIdx >= m_dac_devices.size()) {
+		THROW_M2K_EXCEPTION("Analog Out: No such channel", libm2k::EXC_OUT_OF_RANGE);
+	}
+	double vlsb = m_calib_vlsb.at(chnIdx);
+	double samplerate = m_samplerate.at(chnIdx);
+
+	// only the cyclic buffers are worth keeping, the streamed ones rarely come back
+	bool cached = getCyclic(chnIdx) && m_waveform_cache.getMaxSize() > 0;
+	WaveformCache::key key = {};
+	if (cached) {
+		key = {WaveformCache::hash(data, nb_samples, stride), nb_samples, samplerate, vlsb};
+		std::shared_ptr<const std::vector<short>> raw_data_buffer = m_waveform_cache.find(key);
+		if (raw_data_buffer) {
+			return raw_data_buffer;
+		}
+	}
 
+	double filterCompensation = getFilterCompensation(samplerate);
+	std::shared_ptr<std::vector<short>> raw_data_buffer = std::make_shared<std::vector<short>>(nb_samples);
 	for (unsigned int i = 0; i < nb_samples; i++) {
-		raw_data_buffer.push_back(convertVoltsToRaw(chnIdx, data[i]));
+		(*raw_data_buffer)[i] = convVoltsToRaw(data[i * stride], vlsb, filterCompensation);
+	}
+	if (cached) {
+		m_waveform_cache.store(key, raw_data_buffer);
+	}
+	return raw_data_buffer;
+}
+
+
+std::shared_ptr<const std::vector<short>> M2kAnalogOutImpl::synthesize(unsigned int chnIdx, WAVEFORM const &waveform,
+								       unsigned int nb_samples)
+{
+	if (chnIdx >= m_dac_devices.size()) {
+		THROW_M2K_EXCEPTION("Analog Out: No such channel", libm2k::EXC_OUT_OF_RANGE);
+	}
+	double samplerate = m_samplerate.at(chnIdx);
+	double filterCompensation = getFilterCompensation(samplerate);
+	std::unique_ptr<WaveformSynth> &synth = m_synth.at(chnIdx);
+
+	bool cached = (nb_samples == 0) && m_waveform_cache.getMaxSize() > 0;
+	WaveformCache::key key = {};
+	if (cached) {
+		// the parameters stand for the content; the seed keeps them apart from the samples
+		std::vector<double> parameters = {waveform.offset};
+		for (const WAVEFORM_TONE &tone : waveform.tones) {
+			parameters.insert(parameters.end(), {(double)tone.type, tone.frequency, tone.amplitude,
+							     tone.phase, tone.duty_cycle});
+		}
+		key = {WaveformCache::hash(parameters.data(), parameters.size(), 1, WAVEFORM_PARAMETERS_SEED),
+		       parameters.size(), samplerate, m_calib_vlsb.at(chnIdx)};
+		std::shared_ptr<const std::vector<short>> data = m_waveform_cache.find(key);
+		if (data) {
+			return data;
+		}
+	}
+
+	if (nb_samples == 0) {
+		// whole periods, within the limits of a cyclic buffer
+		nb_samples = WaveformSynth::getCyclicLength(waveform, samplerate, 1024, 500000);
+		synth.reset(new WaveformSynth(waveform, samplerate, nb_samples));
+	} else if (!synth || !synth->matches(waveform, samplerate)) {
+		synth.reset(new WaveformSynth(waveform, samplerate));
+	}
+	// same conversion as convVoltsToRaw
+	synth->setConversion(-1 / (m_calib_vlsb.at(chnIdx) * filterCompensation), -0.5 / filterCompensation);
+
+	std::shared_ptr<std::vector<short>> data = std::make_shared<std::vector<short>>(nb_samples);
+	synth->generate(data->data(), nb_samples);
+	if (cached) {
+		m_waveform_cache.store(key, data);
+	}
+	return data;
+}
+
+
+void M2kAnalogOutImpl::pushWaveform(unsigned int chnIdx, WAVEFORM const &waveform)
+{
+	std::shared_ptr<const std::vector<short>> data = synthesize(chnIdx, waveform, 0);
+	// a later chunked push restarts the phase
+	m_synth.at(chnIdx).reset();
+	pushRaw(chnIdx, *data);
+}
+
+
+void M2kAnalogOutImpl::pushWaveform(unsigned int chnIdx, WAVEFORM const &waveform, unsigned int nb_samples)
+{
+	if (nb_samples == 0) {
+		THROW_M2K_EXCEPTION("Analog Out: The number of samples must be positive", libm2k::EXC_INVALID_PARAMETER);
+	}
+	pushRaw(chnIdx, *synthesize(chnIdx, waveform, nb_samples));
+}
+
+
+void M2kAnalogOutImpl::pushWaveform(std::vector<WAVEFORM> const &waveforms)
+{
+	std::vector<std::vector<short>> data;
+	for (unsigned int chn = 0; chn < waveforms.size(); chn++) {
+		data.push_back(*synthesize(chn, waveforms.at(chn), 0));
+		m_synth.at(chn).reset();
+	}
+	pushRaw(data);
+}
+
+
+void M2kAnalogOutImpl::pushWaveform(std::vector<WAVEFORM> const &waveforms, unsigned int nb_samples)
+{
+	if (nb_samples == 0) {
+		THROW_M2K_EXCEPTION("Analog Out: The number of samples must be positive", libm2k::EXC_INVALID_PARAMETER);
 	}
-	m_dac_devices.at(chnIdx)->push(raw_data_buffer, 0, getCyclic(chnIdx), false, true);
+	std::vector<std::vector<short>> data;
+	for (unsigned int chn = 0; chn < waveforms.size(); chn++) {
+		data.push_back(*synthesize(chn, waveforms.at(chn), nb_samples));
+	}
+	pushRaw(data);
 }
 
 
@@ -546,7 +671,6 @@ void M2kAnalogOutImpl::pushRawInterleaved(short *data, unsigned int nb_channels,
 void M2kAnalogOutImpl::push(std::vector<std::vector<double>> const &data)
 {
 	LIBM2K_LOG(INFO, "[BEGIN] M2kAnalogOut push");
-	std::vector<std::vector<short>> data_buffers;
 	bool streamingData = true;
 	bool isBufferEmpty = true;
 	bool allChannelsPushed = (data.size() != getNbChannels()) ? false : true;
@@ -575,13 +699,9 @@ void M2kAnalogOutImpl::push(std::vector<std::vector<double>> const &data)
 	}
 
 	for (unsigned int chn = 0; chn < data.size(); chn++) {
-		size_t size = data.at(chn).size();
-		std::vector<short> raw_data_buffer = {};
-		for (unsigned int i = 0; i < size; i++) {
-			raw_data_buffer.push_back(convertVoltsToRaw(chn, data[chn][i]));
-		}
-		m_dac_devices.at(chn)->push(raw_data_buffer, 0, getCyclic(chn));
-		data_buffers.push_back(raw_data_buffer);
+		std::shared_ptr<const std::vector<short>> raw_data_buffer =
+				convertToRaw(chn, data.at(chn).data(), data.at(chn).size());
+		m_dac_devices.at(chn)->push(*raw_data_buffer, 0, getCyclic(chn));
 	}
 
 	if ((streamingData && isBufferEmpty) || !streamingData) {
@@ -599,7 +719,6 @@ void M2kAnalogOutImpl::pushInterleaved(double *data, unsigned int nb_channels, u
 	if ((nb_samples % nb_channels) !=0) {
 		THROW_M2K_EXCEPTION("Analog Out: Input array length must be multiple of channels", libm2k::EXC_INVALID_PARAMETER);
 	}
-	std::vector<std::vector<short>> data_buffers;
 	unsigned int bufferSize = nb_samples/nb_channels;
 	bool streamingData = true;
 	bool isBufferEmpty = true;
@@ -625,12 +744,9 @@ void M2kAnalogOutImpl::pushInterleaved(double *data, unsigned int nb_channels, u
 		setSyncedDma(true);
 	}
 	for (unsigned int chn = 0; chn < nb_channels; chn++) {
-		std::vector<short> raw_data_buffer = {};
-		for (unsigned int i = 0, off = 0; i < (bufferSize); i++, off += nb_channels) {
-			raw_data_buffer.push_back(convertVoltsToRaw(chn, data[chn + off]));
-		}
-		m_dac_devices.at(chn)->push(raw_data_buffer, 0, getCyclic(chn));
-		data_buffers.push_back(raw_data_buffer);
+		std::shared_ptr<const std::vector<short>> raw_data_buffer =
+				convertToRaw(chn, data + chn, bufferSize, nb_channels);
+		m_dac_devices.at(chn)->push(*raw_data_buffer, 0, getCyclic(chn));
 	}
 
 	if ((streamingData && isBufferEmpty) || !streamingData) {
@@ -666,6 +782,9 @@ void M2kAnalogOutImpl::stop()
 	for (DeviceOut* dev : m_dac_devices) {
 		dev->stop();
 	}
+	for (auto &synth : m_synth) {
+		synth.reset();
+	}
 
 	if (firmware_version >= "v0.32") {
 		for (unsigned int i = 0; i < m_dac_devices.size(); i++) {
@@ -680,6 +799,7 @@ void M2kAnalogOutImpl::stop(unsigned int chn)
 	m_m2k_fabric->setBoolValue(chn, true, "powerdown", true);
 	setSyncedDma(true, chn);
 	getDacDevice(chn)->stop();
+	m_synth.at(chn).reset();
 	setRawEnable(chn, true);
 	setRaw(chn, 0);
 }
@@ -822,3 +942,162 @@ bool M2kAnalogOutImpl::getBufferRearmOnTrigger() const
 	}
 	return m_dac_devices[0]->getBoolValue("auto_rearm_trigger");
 }
+
+libm2k::AsyncOperation M2kAnalogOutImpl::pushAsync(std::vector<std::vector<double>> const &data)
+{
+	return m_async_worker->run([this, data]() {
+		push(data);
+	});
+}
+
+libm2k::AsyncOperation M2kAnalogOutImpl::runSequence(unsigned int chnIdx, std::vector<SEQUENCE_SEGMENT> const &segments,
+						     unsigned int buffer_size)
+{
+	if (chnIdx >= m_dac_devices.size()) {
+		THROW_M2K_EXCEPTION("Analog Out: No such channel", libm2k::EXC_OUT_OF_RANGE);
+	}
+	if (buffer_size < 16 || buffer_size % 4 != 0) {
+		THROW_M2K_EXCEPTION("Analog Out: The buffer size must be a multiple of 4, at least 16",
+				    libm2k::EXC_INVALID_PARAMETER);
+	}
+	for (const SEQUENCE_SEGMENT &segment : segments) {
+		if (segment.wait_trigger && !m_auto_rearm_trigger_available) {
+			THROW_M2K_EXCEPTION("Invalid firmware version: 0.33 or greater is required.",
+					    libm2k::EXC_INVALID_FIRMWARE_VERSION);
+		}
+	}
+	if (m_sequence_running.exchange(true)) {
+		THROW_M2K_EXCEPTION("Analog Out: a sequence is already running", libm2k::EXC_INVALID_PARAMETER);
+	}
+	m_sequence_stopped = false;
+	setCyclic(chnIdx, false);
+
+	return m_async_worker->run([this, chnIdx, segments, buffer_size]() {
+		libm2k::utils::AsyncTokenRelease<bool> release(m_sequence_running, true, false);
+		streamSequence(chnIdx, segments, buffer_size);
+	});
+}
+
+void M2kAnalogOutImpl::stopSequence()
+{
+	m_sequence_stopped = true;
+}
+
+void M2kAnalogOutImpl::streamSequence(unsigned int chnIdx, std::vector<SEQUENCE_SEGMENT> const &segments,
+				      unsigned int buffer_size)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kAnalogOut sequence");
+	std::vector<std::shared_ptr<const std::vector<short>>> raw_segments;
+	for (const SEQUENCE_SEGMENT &segment : segments) {
+		raw_segments.push_back(convertToRaw(chnIdx, segment.samples.data(), segment.samples.size()));
+	}
+
+	DeviceOut *dac = m_dac_devices.at(chnIdx);
+	bool initial_rearm = m_auto_rearm_trigger_available && getBufferRearmOnTrigger();
+	bool rearm = initial_rearm;
+	unsigned int last_size = 0;
+	bool started = false;
+	std::vector<short> buffer;
+	buffer.reserve(buffer_size);
+
+	// the buffer is created again when its size changes, which drops the queued samples
+	auto push = [&](const short *data, unsigned int nb_samples) {
+		if (last_size != 0 && nb_samples != last_size && !waitForQueuedSamples(chnIdx, last_size)) {
+			return;
+		}
+		dac->push((short*)data, 0, nb_samples, false);
+		last_size = nb_samples;
+		if (!started) {
+			setSyncedDma(false, chnIdx);
+			started = true;
+		}
+	};
+	auto flush = [&]() {
+		if (!buffer.empty()) {
+			buffer.resize(buffer_size, buffer.back());
+			push(buffer.data(), buffer_size);
+			buffer.clear();
+		}
+	};
+	auto setRearm = [&](bool enable) {
+		if (enable != rearm && (last_size == 0 || waitForQueuedSamples(chnIdx, last_size))) {
+			setBufferRearmOnTrigger(enable);
+			rearm = enable;
+		}
+	};
+
+	for (unsigned int i = 0; i < segments.size() && !m_sequence_stopped; i++) {
+		const std::vector<short> &samples = *raw_segments.at(i);
+		if (samples.empty() || segments.at(i).repeat == 0) {
+			continue;
+		}
+
+		if (segments.at(i).wait_trigger) {
+			flush();
+			setRearm(true);
+			for (unsigned int r = 0; r < segments.at(i).repeat && !m_sequence_stopped; r++) {
+				push(samples.data(), samples.size());
+			}
+			continue;
+		}
+
+		setRearm(false);
+		for (unsigned int r = 0; r < segments.at(i).repeat && !m_sequence_stopped; r++) {
+			size_t offset = 0;
+			while (offset < samples.size() && !m_sequence_stopped) {
+				size_t count = std::min(samples.size() - offset, (size_t)(buffer_size - buffer.size()));
+				buffer.insert(buffer.end(), samples.begin() + offset, samples.begin() + offset + count);
+				offset += count;
+				if (buffer.size() == buffer_size) {
+					push(buffer.data(), buffer_size);
+					buffer.clear();
+				}
+			}
+		}
+	}
+
+	if (!m_sequence_stopped) {
+		flush();
+	}
+	if (rearm != initial_rearm) {
+		waitForQueuedSamples(chnIdx, last_size);
+		setBufferRearmOnTrigger(initial_rearm);
+	}
+	LIBM2K_LOG(INFO, "[END] M2kAnalogOut sequence");
+}
+
+bool M2kAnalogOutImpl::waitForQueuedSamples(unsigned int chnIdx, unsigned int buffer_size)
+{
+	if (!m_dma_data_available) {
+		return !m_sequence_stopped;
+	}
+	// all kernel buffers are empty when maximum buffer space is equal with the unused space
+	unsigned int maxBufferSpace = 2u * buffer_size * (m_nb_kernel_buffers.at(chnIdx) - 1);
+	while (!m_sequence_stopped) {
+		if ((unsigned int)m_dac_devices.at(chnIdx)->getBufferLongValue("data_available") == maxBufferSpace) {
+			return true;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return false;
+}
+
+void M2kAnalogOutImpl::setWaveformCacheSize(unsigned int bytes)
+{
+	m_waveform_cache.setMaxSize(bytes);
+}
+
+unsigned int M2kAnalogOutImpl::getWaveformCacheSize()
+{
+	return m_waveform_cache.getMaxSize();
+}
+
+libm2k::WAVEFORM_CACHE_STATS M2kAnalogOutImpl::getWaveformCacheStats()
+{
+	return m_waveform_cache.getStats();
+}
+
+void M2kAnalogOutImpl::clearWaveformCache()
+{
+	m_waveform_cache.clear();
+}
@@ -25,10 +25,14 @@
 #include <libm2k/analog/m2kanalogout.hpp>
 #include "utils/devicegeneric.hpp"
 #include "utils/deviceout.hpp"
+#include "utils/asyncworker.hpp"
+#include "utils/waveformcache.hpp"
+#include "utils/waveformsynth.hpp"
 #include <libm2k/enums.hpp>
 #include <vector>
 #include <memory>
 #include <map>
+#include <atomic>
 
 using namespace libm2k;
 using namespace libm2k::utils;
@@ -88,6 +92,10 @@ public:
 	void pushRaw(unsigned int chnIdx, std::vector<short> const &data) override;
 	void push(std::vector<std::vector<double>> const &data) override;
 	void pushRaw(std::vector<std::vector<short>> const &data) override;
+	void pushWaveform(unsigned int chnIdx, WAVEFORM const &waveform) override;
+	void pushWaveform(unsigned int chnIdx, WAVEFORM const &waveform, unsigned int nb_samples) override;
+	void pushWaveform(std::vector<WAVEFORM> const &waveforms) override;
+	void pushWaveform(std::vector<WAVEFORM> const &waveforms, unsigned int nb_samples) override;
 
 	void stop() override;
 	void stop(unsigned int chn) override;
@@ -120,6 +128,16 @@ public:
 	void setBufferRearmOnTrigger(bool enable) override;
 	bool getBufferRearmOnTrigger() const override;	
 
+	libm2k::AsyncOperation pushAsync(std::vector<std::vector<double>> const &data) override;
+	libm2k::AsyncOperation runSequence(unsigned int chnIdx, std::vector<SEQUENCE_SEGMENT> const &segments,
+					   unsigned int buffer_size) override;
+	void stopSequence() override;
+
+	void setWaveformCacheSize(unsigned int bytes) override;
+	unsigned int getWaveformCacheSize() override;
+	libm2k::WAVEFORM_CACHE_STATS getWaveformCacheStats() override;
+	void clearWaveformCache() override;
+
 private:
 	std::string firmware_version;
 	std::shared_ptr<libm2k::utils::DeviceGeneric> m_m2k_fabric;
@@ -138,10 +156,21 @@ private:
 	std::vector<unsigned int> m_nb_kernel_buffers;
 	std::vector<bool> m_raw_enable_available;
 	std::vector<bool> m_raw_available;
+	std::unique_ptr<libm2k::utils::AsyncWorker> m_async_worker;
+	std::vector<std::unique_ptr<libm2k::utils::WaveformSynth>> m_synth;
+	libm2k::utils::WaveformCache m_waveform_cache;
+	std::atomic<bool> m_sequence_running;
+	std::atomic<bool> m_sequence_stopped;
 
 	DeviceOut* getDacDevice(unsigned int chnIdx) const;
 	void syncDevice();
 	double convRawToVolts(short raw, double vlsb, double filterCompensation);
+	std::shared_ptr<const std::vector<short>> synthesize(unsigned int chnIdx, WAVEFORM const &waveform,
+							     unsigned int nb_samples);
+	std::shared_ptr<const std::vector<short>> convertToRaw(unsigned int chnIdx, const double *data,
+							       unsigned int nb_samples, unsigned int stride = 1);
+	void streamSequence(unsigned int chnIdx, std::vector<SEQUENCE_SEGMENT> const &segments, unsigned int buffer_size);
+	bool waitForQueuedSamples(unsigned int chnIdx, unsigned int buffer_size);
 
 	void setRaw(unsigned int chn_idx, unsigned short raw);
 	unsigned short getRaw(unsigned int chn_idx) const;	
@@ -19,7 +19,10 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
+#include <chrono>
+#include <limits>
 #include "m2kpowersupply_impl.hpp"
 #include <libm2k/m2kexceptions.hpp>
 #include <libm2k/logger.hpp>
@@ -38,7 +41,9 @@ M2kPowerSupplyImpl::M2kPowerSupplyImpl(iio_context *ctx,
 	m_context_attrs(context_attrs),
 	m_pos_powerdown_idx(2),
 	m_neg_powerdown_idx(3),
-	m_individual_powerdown(false)
+	m_individual_powerdown(false),
+	m_sequence_generation(0),
+	m_sequence_worker(new libm2k::utils::AsyncWorker())
 {
 	LIBM2K_LOG(INFO, "[BEGIN] Initialize M2kPowerSupply");
 	m_generic_device = make_shared<DeviceOut>(ctx, "");
@@ -83,8 +88,17 @@ M2kPowerSupplyImpl::M2kPowerSupplyImpl(iio_context *ctx,
 		THROW_M2K_EXCEPTION("M2K Power Supply: Unable to find 2nd write channels", libm2k::EXC_INVALID_PARAMETER);
 	}
 
+	for (unsigned int idx : m_read_channel_idx) {
+		m_read_channels.push_back(m_dev_read->getChannel("voltage" + to_string(idx), false));
+	}
+
 	m_channels_enabled.push_back(false);
 	m_channels_enabled.push_back(false);
+	m_pushed_values.resize(m_write_channel_idx.size(), std::numeric_limits<double>::quiet_NaN());
+	m_monitor_stats.resize(m_read_channel_idx.size());
+	m_monitor_sums.resize(m_read_channel_idx.size());
+	m_monitor_thresholds.resize(m_read_channel_idx.size(), monitor_threshold{false, false, 0, 0, nullptr});
+	resetMonitorStatistics();
 
 
 	m_m2k_fabric = make_shared<DeviceGeneric>(ctx, "m2k-fabric");
@@ -116,7 +130,9 @@ M2kPowerSupplyImpl::M2kPowerSupplyImpl(iio_context *ctx,
 
 M2kPowerSupplyImpl::~M2kPowerSupplyImpl()
 {
-
+	cancelSequence();
+	m_sequence_worker->stop();
+	m_monitor.stop();
 }
 
 void M2kPowerSupplyImpl::syncDevice()
@@ -129,10 +145,19 @@ void M2kPowerSupplyImpl::syncDevice()
 
 void M2kPowerSupplyImpl::reset()
 {
+	m_monitor.stop();
+	/* wait for the cancelled sequences to return before touching the DACs */
+	cancelSequence();
+	m_sequence_worker->run([]() {}).wait();
+
 	powerDownDacs(true);
 	for (unsigned int i : m_write_channel_idx) {
 		m_dev_write->setDoubleValue(i, 2048, "raw", true);
 	}
+	{
+		std::lock_guard<std::mutex> lock(m_sequence_lock);
+		std::fill(m_pushed_values.begin(), m_pushed_values.end(), std::numeric_limits<double>::quiet_NaN());
+	}
 
 	m_write_coefficients.at(0) = 4095.0 / (5.02 * 1.2 );
 	m_write_coefficients.at(1) = 4095.0 / (-5.1 * 1.2 );
@@ -208,6 +233,33 @@ void M2kPowerSupplyImpl::loadCalibrationCoefficients()
 			continue;
 		}
 	}
+
+	/* Channel 0 is the positive supply, channel 1 the negative one */
+	const std::vector<std::pair<std::string, std::string>> keys = {
+		{"offset_pos_dac", "gain_pos_dac"},
+		{"offset_neg_dac", "gain_neg_dac"}
+	};
+	m_channel_calibration.clear();
+	for (auto &key : keys) {
+		calibration_coefficients coeffs = {0.0, 1.0, false};
+		__try {
+			coeffs.offset = getCalibrationCoefficient(key.first);
+			coeffs.gain = getCalibrationCoefficient(key.second);
+			coeffs.available = true;
+		} __catch (exception_type &) {
+			coeffs = {0.0, 1.0, false};
+		}
+		m_channel_calibration.push_back(coeffs);
+	}
+}
+
+const M2kPowerSupplyImpl::calibration_coefficients &M2kPowerSupplyImpl::getChannelCalibration(unsigned int chn)
+{
+	const calibration_coefficients &coeffs = m_channel_calibration.at(chn);
+	if (!coeffs.available) {
+		THROW_M2K_EXCEPTION("M2k Power Supply: No such calibration coefficient", libm2k::EXC_INVALID_PARAMETER);
+	}
+	return coeffs;
 }
 
 double M2kPowerSupplyImpl::getCalibrationCoefficient(std::string key)
@@ -239,19 +291,13 @@ double M2kPowerSupplyImpl::readChannel(unsigned int idx, bool calibrated)
 	}
 
 	if (calibrated) {
-		if (idx == 0) {
-			offset = getCalibrationCoefficient("offset_pos_dac");
-			gain = getCalibrationCoefficient("gain_pos_dac");
-		} else {
-			offset = getCalibrationCoefficient("offset_neg_dac");
-			gain = getCalibrationCoefficient("gain_neg_dac");
-		}
+		const calibration_coefficients &coeffs = getChannelCalibration(idx);
+		offset = coeffs.offset;
+		gain = coeffs.gain;
 	}
 
 	//voltage2 and v1
-	auto chn_name = "voltage" + to_string(m_read_channel_idx.at(idx));
-	auto chn = m_dev_read->getChannel(chn_name, false);
-	val = chn->getDoubleValue("raw");
+	val = m_read_channels.at(idx)->getDoubleValue("raw");
 	value = ((val * m_read_coefficients.at(idx)) + offset) * gain;
 	LIBM2K_LOG(INFO, "[END] M2kPowerSupply readChannel");
 	return value;
@@ -273,13 +319,9 @@ void M2kPowerSupplyImpl::pushChannel(unsigned int chnIdx, double value, bool cal
 	}
 
 	if (calibrated) {
-		if (chnIdx == 0) {
-			offset = getCalibrationCoefficient("offset_pos_dac");
-			gain = getCalibrationCoefficient("gain_pos_dac");
-		} else {
-			offset = getCalibrationCoefficient("offset_neg_dac");
-			gain = getCalibrationCoefficient("gain_neg_dac");
-		}
+		const calibration_coefficients &coeffs = getChannelCalibration(chnIdx);
+		offset = coeffs.offset;
+		gain = coeffs.gain;
 	}
 
 	val = (value * gain + offset) * m_write_coefficients.at(chnIdx);
@@ -288,5 +330,238 @@ void M2kPowerSupplyImpl::pushChannel(unsigned int chnIdx, double value, bool cal
 	}
 
 	m_dev_write->setDoubleValue(m_write_channel_idx.at(chnIdx), val, "raw", true);
+	{
+		std::lock_guard<std::mutex> lock(m_sequence_lock);
+		m_pushed_values.at(chnIdx) = value;
+	}
 	LIBM2K_LOG(INFO, "[END] M2kPowerSupply pushChannel");
 }
+
+void M2kPowerSupplyImpl::startMonitoring(unsigned int period_ms, unsigned int buffer_size)
+{
+	if (buffer_size == 0) {
+		THROW_M2K_EXCEPTION("M2k PowerSupply: The sample buffer size must be greater than 0", libm2k::EXC_INVALID_PARAMETER);
+	}
+	m_monitor.stop();
+	{
+		std::lock_guard<std::mutex> lock(m_monitor_lock);
+		m_monitor_samples.reset(buffer_size);
+	}
+	resetMonitorStatistics();
+	m_monitor.start(std::chrono::milliseconds(period_ms), std::bind(&M2kPowerSupplyImpl::monitorStep, this));
+}
+
+void M2kPowerSupplyImpl::stopMonitoring()
+{
+	m_monitor.stop();
+}
+
+bool M2kPowerSupplyImpl::isMonitoring()
+{
+	return m_monitor.isRunning();
+}
+
+std::vector<POWER_SUPPLY_SAMPLE> M2kPowerSupplyImpl::readMonitorSamples()
+{
+	std::lock_guard<std::mutex> lock(m_monitor_lock);
+	return m_monitor_samples.drain();
+}
+
+POWER_SUPPLY_STATS M2kPowerSupplyImpl::getMonitorStatistics(unsigned int chn)
+{
+	if (chn >= m_read_channel_idx.size()) {
+		THROW_M2K_EXCEPTION("M2k PowerSupply: No such channel", libm2k::EXC_OUT_OF_RANGE);
+	}
+	std::lock_guard<std::mutex> lock(m_monitor_lock);
+	POWER_SUPPLY_STATS stats = m_monitor_stats.at(chn);
+	stats.mean = (stats.count > 0) ? (m_monitor_sums.at(chn) / stats.count) : 0.0;
+	if (stats.count == 0) {
+		stats.min = 0.0;
+		stats.max = 0.0;
+	}
+	return stats;
+}
+
+void M2kPowerSupplyImpl::resetMonitorStatistics()
+{
+	std::lock_guard<std::mutex> lock(m_monitor_lock);
+	for (unsigned int i = 0; i < m_monitor_stats.size(); i++) {
+		m_monitor_stats.at(i) = {std::numeric_limits<double>::max(),
+					 std::numeric_limits<double>::lowest(), 0.0, 0};
+		m_monitor_sums.at(i) = 0.0;
+	}
+}
+
+void M2kPowerSupplyImpl::setMonitorThreshold(unsigned int chn, double min, double max,
+					     std::function<void(unsigned int, double)> callback)
+{
+	if (chn >= m_read_channel_idx.size()) {
+		THROW_M2K_EXCEPTION("M2k PowerSupply: No such channel", libm2k::EXC_OUT_OF_RANGE);
+	}
+	if (min > max) {
+		THROW_M2K_EXCEPTION("M2k PowerSupply: The threshold minimum is greater than the maximum", libm2k::EXC_INVALID_PARAMETER);
+	}
+	std::lock_guard<std::mutex> lock(m_monitor_lock);
+	m_monitor_thresholds.at(chn) = monitor_threshold{true, false, min, max, callback};
+}
+
+void M2kPowerSupplyImpl::clearMonitorThreshold(unsigned int chn)
+{
+	if (chn >= m_read_channel_idx.size()) {
+		THROW_M2K_EXCEPTION("M2k PowerSupply: No such channel", libm2k::EXC_OUT_OF_RANGE);
+	}
+	std::lock_guard<std::mutex> lock(m_monitor_lock);
+	m_monitor_thresholds.at(chn) = monitor_threshold{false, false, 0, 0, nullptr};
+}
+
+void M2kPowerSupplyImpl::monitorStep()
+{
+	POWER_SUPPLY_SAMPLE sample;
+	auto now = std::chrono::system_clock::now().time_since_epoch();
+	sample.timestamp = std::chrono::duration_cast<std::chrono::duration<double>>(now).count();
+	for (unsigned int i = 0; i < m_read_channels.size(); i++) {
+		sample.values.push_back(readChannel(i, m_channel_calibration.at(i).available));
+	}
+
+	/* The callbacks are called without holding the lock, so they can use the monitor API */
+	std::vector<std::pair<std::function<void(unsigned int, double)>, unsigned int>> triggered;
+	{
+		std::lock_guard<std::mutex> lock(m_monitor_lock);
+		for (unsigned int i = 0; i < sample.values.size(); i++) {
+			double value = sample.values.at(i);
+			POWER_SUPPLY_STATS &stats = m_monitor_stats.at(i);
+			stats.min = std::min(stats.min, value);
+			stats.max = std::max(stats.max, value);
+			stats.count++;
+			m_monitor_sums.at(i) += value;
+
+			monitor_threshold &threshold = m_monitor_thresholds.at(i);
+			if (!threshold.enabled) {
+				continue;
+			}
+			bool outside = (value < threshold.min) || (value > threshold.max);
+			if (outside && !threshold.outside && threshold.callback) {
+				triggered.push_back({threshold.callback, i});
+			}
+			threshold.outside = outside;
+		}
+		m_monitor_samples.push(sample);
+	}
+
+	for (auto &trigger : triggered) {
+		trigger.first(trigger.second, sample.values.at(trigger.second));
+	}
+}
+
+libm2k::AsyncOperation M2kPowerSupplyImpl::runSequence(std::vector<POWER_SUPPLY_STEP> const &steps, bool calibrated)
+{
+	for (const POWER_SUPPLY_STEP &step : steps) {
+		validateStep(step);
+	}
+	unsigned int generation;
+	{
+		std::lock_guard<std::mutex> lock(m_sequence_lock);
+		generation = m_sequence_generation;
+	}
+	return m_sequence_worker->run([this, steps, calibrated, generation]() {
+		for (const POWER_SUPPLY_STEP &step : steps) {
+			runStep(step, calibrated, generation);
+		}
+	});
+}
+
+libm2k::AsyncOperation M2kPowerSupplyImpl::rampChannel(unsigned int chn, double target, double slew_rate, bool calibrated)
+{
+	POWER_SUPPLY_STEP step = {chn, target, slew_rate, 0.0, 0.0, 0.0};
+	return runSequence({step}, calibrated);
+}
+
+void M2kPowerSupplyImpl::cancelSequence()
+{
+	std::lock_guard<std::mutex> lock(m_sequence_lock);
+	m_sequence_generation++;
+	m_sequence_cond.notify_all();
+}
+
+void M2kPowerSupplyImpl::validateStep(const POWER_SUPPLY_STEP &step)
+{
+	if (step.channel >= m_write_channel_idx.size()) {
+		THROW_M2K_EXCEPTION("M2k PowerSupply: No such channel", libm2k::EXC_OUT_OF_RANGE);
+	}
+	if (std::abs(step.target) > 5) {
+		THROW_M2K_EXCEPTION("M2K power supplies are limited to 5V", libm2k::EXC_INVALID_PARAMETER);
+	}
+	if (step.slew_rate < 0 || step.dwell < 0 || step.tolerance < 0) {
+		THROW_M2K_EXCEPTION("M2k PowerSupply: The slew rate, dwell and tolerance of a step can't be negative",
+				    libm2k::EXC_INVALID_PARAMETER);
+	}
+	if (step.tolerance > 0 && step.settle_timeout <= 0) {
+		THROW_M2K_EXCEPTION("M2k PowerSupply: A step with a readback tolerance needs a settle timeout",
+				    libm2k::EXC_INVALID_PARAMETER);
+	}
+}
+
+void M2kPowerSupplyImpl::sequenceWaitUntil(std::chrono::steady_clock::time_point deadline, unsigned int generation)
+{
+	std::unique_lock<std::mutex> lock(m_sequence_lock);
+	m_sequence_cond.wait_until(lock, deadline, [this, generation]() {
+		return m_sequence_generation != generation;
+	});
+	if (m_sequence_generation != generation) {
+		THROW_M2K_EXCEPTION("M2k PowerSupply: The sequence was cancelled", libm2k::EXC_RUNTIME_ERROR);
+	}
+}
+
+void M2kPowerSupplyImpl::runStep(const POWER_SUPPLY_STEP &step, bool calibrated, unsigned int generation)
+{
+	using namespace std::chrono;
+	/* The DAC is updated every millisecond during a ramp; the value follows the elapsed
+	 * time, so a slow write delays the next update but not the end of the ramp */
+	const microseconds update_period(1000);
+	const microseconds readback_period(5000);
+
+	double start;
+	{
+		std::lock_guard<std::mutex> lock(m_sequence_lock);
+		start = m_pushed_values.at(step.channel);
+	}
+	if (std::isnan(start)) {
+		start = readChannel(step.channel, calibrated);
+	}
+
+	sequenceWaitUntil(steady_clock::now(), generation);
+	double delta = step.target - start;
+	if (step.slew_rate == 0 || delta == 0) {
+		pushChannel(step.channel, step.target, calibrated);
+	} else {
+		auto begin = steady_clock::now();
+		auto next = begin;
+		while (true) {
+			double elapsed = duration_cast<duration<double>>(steady_clock::now() - begin).count();
+			double progress = std::min(step.slew_rate * elapsed, std::abs(delta));
+			double value = start + std::copysign(progress, delta);
+			pushChannel(step.channel, value, calibrated);
+			if (progress >= std::abs(delta)) {
+				break;
+			}
+			next += update_period;
+			sequenceWaitUntil(next, generation);
+		}
+	}
+
+	if (step.tolerance > 0) {
+		auto timeout = steady_clock::now() + duration_cast<steady_clock::duration>(duration<double>(step.settle_timeout));
+		while (std::abs(readChannel(step.channel, calibrated) - step.target) > step.tolerance) {
+			if (steady_clock::now() >= timeout) {
+				THROW_M2K_EXCEPTION("M2k PowerSupply: Channel " + std::to_string(step.channel) +
+						    " did not reach " + std::to_string(step.target) + "V", libm2k::EXC_TIMEOUT);
+			}
+			sequenceWaitUntil(steady_clock::now() + readback_period, generation);
+		}
+	}
+
+	if (step.dwell > 0) {
+		sequenceWaitUntil(steady_clock::now() + duration_cast<steady_clock::duration>(duration<double>(step.dwell)),
+				  generation);
+	}
+}
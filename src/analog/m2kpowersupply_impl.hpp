@@ -25,9 +25,15 @@
 #include <libm2k/analog/m2kpowersupply.hpp>
 #include "utils/devicein.hpp"
 #include "utils/deviceout.hpp"
+#include "utils/asyncworker.hpp"
+#include "utils/periodictask.hpp"
+#include "utils/ringbuffer.hpp"
 #include <vector>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
 
 namespace libm2k {
 /**
@@ -122,6 +128,23 @@ public:
 	bool anyChannelEnabled();
 
 
+	void startMonitoring(unsigned int period_ms, unsigned int buffer_size = 1024);
+	void stopMonitoring();
+	bool isMonitoring();
+	std::vector<libm2k::analog::POWER_SUPPLY_SAMPLE> readMonitorSamples();
+	libm2k::analog::POWER_SUPPLY_STATS getMonitorStatistics(unsigned int chn);
+	void resetMonitorStatistics();
+	void setMonitorThreshold(unsigned int chn, double min, double max,
+				 std::function<void(unsigned int, double)> callback);
+	void clearMonitorThreshold(unsigned int chn);
+
+	libm2k::AsyncOperation runSequence(std::vector<libm2k::analog::POWER_SUPPLY_STEP> const &steps,
+					   bool calibrated = true);
+	libm2k::AsyncOperation rampChannel(unsigned int chn, double target, double slew_rate,
+					   bool calibrated = true);
+	void cancelSequence();
+
+
 private:
 	std::shared_ptr<libm2k::utils::DeviceOut> m_dev_write;
 	std::shared_ptr<libm2k::utils::DeviceIn> m_dev_read;
@@ -138,9 +161,47 @@ private:
 	std::vector<bool> m_channels_enabled;
 	std::vector<unsigned int> m_write_channel_idx;
 	std::vector<unsigned int> m_read_channel_idx;
+	std::vector<libm2k::utils::Channel*> m_read_channels;
+
+	/* Offset and gain of each channel, looked up once from the context attributes */
+	struct calibration_coefficients {
+		double offset;
+		double gain;
+		bool available;
+	};
+	std::vector<calibration_coefficients> m_channel_calibration;
+
+	struct monitor_threshold {
+		bool enabled;
+		bool outside;
+		double min;
+		double max;
+		std::function<void(unsigned int, double)> callback;
+	};
+	std::mutex m_monitor_lock;
+	libm2k::utils::RingBuffer<libm2k::analog::POWER_SUPPLY_SAMPLE> m_monitor_samples;
+	std::vector<libm2k::analog::POWER_SUPPLY_STATS> m_monitor_stats;
+	std::vector<double> m_monitor_sums;
+	std::vector<monitor_threshold> m_monitor_thresholds;
+
+	/* cancelSequence() bumps the generation; the steps of older sequences stop */
+	std::mutex m_sequence_lock;
+	std::condition_variable m_sequence_cond;
+	unsigned int m_sequence_generation;
+	/* The last value written to each channel, NaN if unknown */
+	std::vector<double> m_pushed_values;
+	std::unique_ptr<libm2k::utils::AsyncWorker> m_sequence_worker;
+
+	/* Declared last, the monitor thread has to stop before the members above are destroyed */
+	libm2k::utils::PeriodicTask m_monitor;
 
 	void loadCalibrationCoefficients();
 	double getCalibrationCoefficient(std::string key);
+	const calibration_coefficients &getChannelCalibration(unsigned int chn);
+	void monitorStep();
+	void validateStep(const libm2k::analog::POWER_SUPPLY_STEP &step);
+	void runStep(const libm2k::analog::POWER_SUPPLY_STEP &step, bool calibrated, unsigned int generation);
+	void sequenceWaitUntil(std::chrono::steady_clock::time_point deadline, unsigned int generation);
 	void syncDevice();
 };
 }
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <libm2k/asyncresult.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+using namespace libm2k;
+
+class AsyncOperation::State
+{
+public:
+	State() : finished(false) {}
+
+	std::mutex lock;
+	std::condition_variable cond;
+	bool finished;
+	std::exception_ptr error;
+	std::vector<std::function<void()>> callbacks;
+};
+
+AsyncOperation::AsyncOperation() :
+	m_state(std::make_shared<State>())
+{
+}
+
+AsyncOperation::~AsyncOperation()
+{
+}
+
+bool AsyncOperation::isReady() const
+{
+	std::lock_guard<std::mutex> lock(m_state->lock);
+	return m_state->finished;
+}
+
+void AsyncOperation::wait() const
+{
+	std::exception_ptr error;
+	{
+		std::unique_lock<std::mutex> lock(m_state->lock);
+		m_state->cond.wait(lock, [this] { return m_state->finished; });
+		error = m_state->error;
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+bool AsyncOperation::waitFor(unsigned int timeout_ms) const
+{
+	std::unique_lock<std::mutex> lock(m_state->lock);
+	return m_state->cond.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+				      [this] { return m_state->finished; });
+}
+
+void AsyncOperation::onComplete(std::function<void()> callback)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_state->lock);
+		if (!m_state->finished) {
+			m_state->callbacks.push_back(callback);
+			return;
+		}
+	}
+	callback();
+}
+
+void AsyncOperation::setFinished(std::exception_ptr error)
+{
+	std::vector<std::function<void()>> callbacks;
+	{
+		std::lock_guard<std::mutex> lock(m_state->lock);
+		if (m_state->finished) {
+			return;
+		}
+		m_state->finished = true;
+		m_state->error = error;
+		callbacks.swap(m_state->callbacks);
+	}
+	m_state->cond.notify_all();
+
+	// callbacks may block (e.g. waiting for a language runtime lock), so they never run under our lock
+	for (auto &callback : callbacks) {
+		callback();
+	}
+}
@@ -22,6 +22,7 @@
 #include "context_impl.hpp"
 #include "analog/dmm_impl.hpp"
 #include "utils/channel.hpp"
+#include "utils/phasetimer.hpp"
 #include <libm2k/m2kexceptions.hpp>
 #include <libm2k/utils/utils.hpp>
 #include <libm2k/m2k.hpp>
@@ -41,9 +42,7 @@ ContextImpl::ContextImpl(std::string uri, struct iio_context *ctx, std::string n
 	m_uri = uri;
 	m_sync = sync;
 	m_ownsContext = false;
-
-	/* Initialize the DMM list */
-	scanAllDMM();
+	m_dmm_scanned = false;
 
 	initializeContextAttributes();
 }
@@ -253,7 +252,7 @@ void ContextImpl::scanAllDMM()
 
 	for (auto dev : dev_list) {
 		if (getIioDeviceDirection(dev.first) != OUTPUT) {
-			if (!getDMM(dev.first)) {
+			if (!findDMM(dev.first)) {
 				m_instancesDMM.push_back(new DMMImpl(m_context, dev.first, m_sync));
 			}
 		}
@@ -310,7 +309,18 @@ void ContextImpl::logAllAttributes() const
 #endif
 }
 
-DMM* ContextImpl::getDMM(std::string dev_name)
+void ContextImpl::ensureDMMScanned()
+{
+	if (m_dmm_scanned) {
+		return;
+	}
+	libm2k::utils::PhaseTimer timer("Scan DMM");
+	scanAllDMM();
+	m_dmm_scanned = true;
+	timer.finish();
+}
+
+DMM* ContextImpl::findDMM(const std::string &dev_name)
 {
 	for (DMM* d : m_instancesDMM) {
 		if (d->getName() == dev_name) {
@@ -320,9 +330,18 @@ DMM* ContextImpl::getDMM(std::string dev_name)
 	return nullptr;
 }
 
+DMM* ContextImpl::getDMM(std::string dev_name)
+{
+	std::lock_guard<std::mutex> lock(m_dmm_lock);
+	ensureDMMScanned();
+	return findDMM(dev_name);
+}
+
 
 DMM* ContextImpl::getDMM(unsigned int index)
 {
+	std::lock_guard<std::mutex> lock(m_dmm_lock);
+	ensureDMMScanned();
 	if (index < m_instancesDMM.size()) {
 		return m_instancesDMM.at(index);
 	} else {
@@ -332,11 +351,15 @@ DMM* ContextImpl::getDMM(unsigned int index)
 
 std::vector<DMM*> ContextImpl::getAllDmm()
 {
+	std::lock_guard<std::mutex> lock(m_dmm_lock);
+	ensureDMMScanned();
 	return m_instancesDMM;
 }
 
 unsigned int ContextImpl::getDmmCount()
 {
+	std::lock_guard<std::mutex> lock(m_dmm_lock);
+	ensureDMMScanned();
 	return m_instancesDMM.size();
 }
 
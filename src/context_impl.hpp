@@ -31,6 +31,7 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <mutex>
 
 extern "C" {
 	struct iio_context;
@@ -94,6 +95,10 @@ protected:
 	std::vector<libm2k::analog::DMM*> m_instancesDMM;
 	std::map<std::string, std::string> m_context_attributes;
 
+	/* The DMM devices are looked up on first use, most scripts never read them.
+	 * The caller must hold m_dmm_lock. */
+	void ensureDMMScanned();
+
 	bool isIioDeviceBufferCapable(std::string dev_name);
 	std::vector<std::pair<std::string, std::string> > getIioDevByChannelAttrs(std::vector<std::string> attr_list);
 	std::vector<std::pair<std::string, std::string>> getHwmonDevices();
@@ -103,11 +108,14 @@ protected:
 
 private:
 	void initializeContextAttributes();
+	libm2k::analog::DMM* findDMM(const std::string &dev_name);
 
 	std::string m_uri;
 	std::string m_name;
 	bool m_sync;
 	bool m_ownsContext;
+	std::mutex m_dmm_lock;
+	bool m_dmm_scanned;
 };
 }
 }
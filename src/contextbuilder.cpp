@@ -21,6 +21,8 @@
 
 #include "m2k_impl.hpp"
 #include "generic_impl.hpp"
+#include "contextdiscovery.hpp"
+#include "utils/phasetimer.hpp"
 #include <libm2k/contextbuilder.hpp>
 #include <libm2k/m2kexceptions.hpp>
 #include <libm2k/logger.hpp>
@@ -31,7 +33,6 @@
 #include <vector>
 #include <iostream>
 #include <memory>
-#include <regex>
 
 
 using namespace libm2k::context;
@@ -64,53 +65,10 @@ ContextBuilder::~ContextBuilder()
 
 std::vector<struct libm2k::CONTEXT_INFO*> ContextBuilder::getContextsInfo()
 {
-	struct iio_context_info **info;
-	unsigned int nb_contexts;
-	std::regex re(":| \\(Analog Devices Inc. |\\), serial=");
-	const sregex_token_iterator end;
 	std::vector<struct libm2k::CONTEXT_INFO*> contexts_info;
-
-	struct iio_scan_context *scan_ctx = iio_create_scan_context("usb", 0);
-
-	if (!scan_ctx) {
-		std::cout << "Unable to create scan context!" << std::endl;
-		return contexts_info;
-	}
-
-	ssize_t ret = iio_scan_context_get_info_list(scan_ctx, &info);
-
-	if (ret < 0) {
-		std::cout << "Unable to scan!" << std::endl;
-		goto out_destroy_context;
+	for (const auto &info : ContextDiscovery::instance().getContexts()) {
+		contexts_info.push_back(new struct libm2k::CONTEXT_INFO(info));
 	}
-
-	nb_contexts = static_cast<unsigned int>(ret);
-
-	for (unsigned int i = 0; i < nb_contexts; i++)
-	{
-		std::string description = std::string(iio_context_info_get_description(info[i]));
-		std::sregex_token_iterator ptr(description.begin(), description.end(), re, -1);
-		auto *ctx_info = new struct libm2k::CONTEXT_INFO();
-		ctx_info->uri = std::string(iio_context_info_get_uri(info[i]));
-		ctx_info->manufacturer = "Analog Devices Inc.";
-		if (ptr != end) {
-			ctx_info->id_vendor = *ptr++;
-		}
-		if (ptr != end) {
-			ctx_info->id_product = *ptr++;
-		}
-		if (ptr != end) {
-			ctx_info->product = *ptr++;
-		}
-		if (ptr != end) {
-			ctx_info->serial = *ptr++;
-		}
-		contexts_info.push_back(ctx_info);
-	}
-
-	iio_context_info_list_free(info);
-out_destroy_context:
-	iio_scan_context_destroy(scan_ctx);
 	return contexts_info;
 }
 
@@ -198,10 +156,12 @@ Context* ContextBuilder::contextOpen(const char *uri)
 		return dev;
 	}
 	// create and save device during first call
+	PhaseTimer timer(std::string("Open ") + uri);
 	struct iio_context* ctx = iio_create_context_from_uri(uri);
 	if (!ctx) {
 		return nullptr;
 	}
+	timer.mark("iio_context");
 	char ctx_git_tag[8];
 	unsigned int ctx_major, ctx_minor;
 	iio_context_get_version(ctx, &ctx_major, &ctx_minor, ctx_git_tag);
@@ -218,10 +178,13 @@ Context* ContextBuilder::contextOpen(const char *uri)
 	}
 
 	ContextTypes dev_type = ContextBuilder::identifyContext(ctx);
+	timer.mark("identify");
 
 	dev = buildContext(dev_type, std::string(uri), ctx, true, true);
 	s_connectedDevices.push_back(dev);
 	incrementReferenceCount(uri);
+	timer.mark("build_context");
+	timer.finish();
 
 	return dev;
 }
@@ -260,11 +223,15 @@ Context* ContextBuilder::contextOpen(struct iio_context* ctx, const char* uri)
 		return nullptr;
 	}
 	// create and save device during first call
+	PhaseTimer timer(std::string("Open ") + uri);
 	ContextTypes dev_type = ContextBuilder::identifyContext(ctx);
+	timer.mark("identify");
 
 	dev = buildContext(dev_type, std::string(uri), ctx, true);
 	s_connectedDevices.push_back(dev);
 	incrementReferenceCount(uri);
+	timer.mark("build_context");
+	timer.finish();
 
 	return dev;
 }
@@ -275,10 +242,18 @@ before trying the "usb" one. */
 Context* ContextBuilder::contextOpen()
 {
 	auto lst = getAllContexts();
-	if (lst.size() <= 0) {
+	if (lst.size() > 0) {
+		Context *dev = contextOpen(lst.at(0).c_str());
+		if (dev) {
+			return dev;
+		}
+	}
+	// the cached list may be stale after a board was unplugged or replugged
+	auto contexts = ContextDiscovery::instance().getContexts(true);
+	if (contexts.empty()) {
 		return nullptr;
 	}
-	return contextOpen(lst.at(0).c_str());
+	return contextOpen(contexts.at(0).uri.c_str());
 }
 
 M2k *ContextBuilder::m2kOpen(struct iio_context* ctx, const char *uri)
@@ -360,6 +335,22 @@ void ContextBuilder::contextCloseAll()
 	}
 }
 
+void ContextBuilder::setContextsCacheTimeout(unsigned int timeout_ms)
+{
+	ContextDiscovery::instance().setCacheTimeout(timeout_ms);
+}
+
+unsigned int ContextBuilder::watchContexts(std::function<void(const libm2k::CONTEXT_INFO &, bool)> callback,
+					   unsigned int period_ms)
+{
+	return ContextDiscovery::instance().subscribe(callback, period_ms);
+}
+
+void ContextBuilder::unwatchContexts(unsigned int id)
+{
+	ContextDiscovery::instance().unsubscribe(id);
+}
+
 std::string ContextBuilder::getVersion()
 {
         if (std::string(PROJECT_VERSION_GIT).empty())
@@ -448,6 +439,22 @@ void libm2k::context::contextCloseAll()
 	ContextBuilder::contextCloseAll();
 }
 
+void libm2k::context::setContextsCacheTimeout(unsigned int timeout_ms)
+{
+	ContextBuilder::setContextsCacheTimeout(timeout_ms);
+}
+
+unsigned int libm2k::context::watchContexts(std::function<void(const libm2k::CONTEXT_INFO &, bool)> callback,
+					    unsigned int period_ms)
+{
+	return ContextBuilder::watchContexts(callback, period_ms);
+}
+
+void libm2k::context::unwatchContexts(unsigned int id)
+{
+	ContextBuilder::unwatchContexts(id);
+}
+
 std::string libm2k::context::getVersion()
 {
 	return ContextBuilder::getVersion();
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "contextdiscovery.hpp"
+#include <libm2k/m2kexceptions.hpp>
+#include <libm2k/logger.hpp>
+#include <iio.h>
+#include <algorithm>
+#include <regex>
+
+using namespace libm2k::context;
+
+namespace {
+bool sameContext(const libm2k::CONTEXT_INFO &a, const libm2k::CONTEXT_INFO &b)
+{
+	return a.uri == b.uri && a.serial == b.serial;
+}
+
+bool containsContext(const std::vector<libm2k::CONTEXT_INFO> &list, const libm2k::CONTEXT_INFO &info)
+{
+	return std::any_of(list.begin(), list.end(), [&info](const libm2k::CONTEXT_INFO &other) {
+		return sameContext(info, other);
+	});
+}
+}
+
+ContextDiscovery &ContextDiscovery::instance()
+{
+	static ContextDiscovery discovery;
+	return discovery;
+}
+
+ContextDiscovery::ContextDiscovery() :
+	m_scan_ctx(nullptr),
+	m_valid(false),
+	m_timeout(500),
+	m_next_id(1)
+{
+}
+
+ContextDiscovery::~ContextDiscovery()
+{
+	m_watcher.stop();
+	if (m_scan_ctx) {
+		iio_scan_context_destroy(m_scan_ctx);
+	}
+}
+
+std::vector<libm2k::CONTEXT_INFO> ContextDiscovery::getContexts(bool refresh)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		if (!refresh && m_valid && (std::chrono::steady_clock::now() - m_scan_time) < m_timeout) {
+			return m_contexts;
+		}
+	}
+	/* Only the watcher notifies the subscribers, it reports what changed since its last poll */
+	rescan();
+	std::lock_guard<std::mutex> lock(m_lock);
+	return m_contexts;
+}
+
+void ContextDiscovery::setCacheTimeout(unsigned int timeout_ms)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_timeout = std::chrono::milliseconds(timeout_ms);
+}
+
+unsigned int ContextDiscovery::subscribe(Callback callback, unsigned int period_ms)
+{
+	if (!callback) {
+		THROW_M2K_EXCEPTION("Context discovery: invalid callback", libm2k::EXC_INVALID_PARAMETER);
+	}
+	if (period_ms == 0) {
+		THROW_M2K_EXCEPTION("Context discovery: the period must be greater than 0", libm2k::EXC_INVALID_PARAMETER);
+	}
+
+	getContexts();
+
+	unsigned int id;
+	bool first;
+	std::chrono::milliseconds period;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		first = m_subscribers.empty();
+		if (first) {
+			/* Take the current list as reference, so only the later changes are reported */
+			m_reported = m_contexts;
+		}
+		id = m_next_id++;
+		m_subscribers[id] = {callback, std::chrono::milliseconds(period_ms)};
+		period = watchPeriod();
+	}
+
+	/* A single watcher serves all the subscribers, at the shortest period any of them asked for */
+	if (first) {
+		m_watcher.start(period, [this]() {
+			poll();
+		});
+	} else {
+		m_watcher.setPeriod(period);
+	}
+	return id;
+}
+
+void ContextDiscovery::unsubscribe(unsigned int id)
+{
+	bool empty;
+	std::chrono::milliseconds period(0);
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_subscribers.erase(id);
+		empty = m_subscribers.empty();
+		if (!empty) {
+			period = watchPeriod();
+		}
+	}
+	if (empty) {
+		m_watcher.stop();
+	} else {
+		m_watcher.setPeriod(period);
+	}
+}
+
+std::chrono::milliseconds ContextDiscovery::watchPeriod()
+{
+	/* Called with m_lock held and at least one subscriber */
+	auto period = m_subscribers.begin()->second.period;
+	for (const auto &subscriber : m_subscribers) {
+		period = std::min(period, subscriber.second.period);
+	}
+	return period;
+}
+
+bool ContextDiscovery::rescan()
+{
+	std::vector<libm2k::CONTEXT_INFO> contexts;
+	std::lock_guard<std::mutex> scan_lock(m_scan_lock);
+	if (!scan(contexts)) {
+		/* Keep the last known list, a failed scan does not mean the boards are gone */
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_contexts = contexts;
+	m_valid = true;
+	m_scan_time = std::chrono::steady_clock::now();
+	return true;
+}
+
+void ContextDiscovery::poll()
+{
+	if (!rescan()) {
+		return;
+	}
+	std::vector<std::pair<libm2k::CONTEXT_INFO, bool>> changes;
+	std::vector<Callback> subscribers;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		for (const auto &info : m_reported) {
+			if (!containsContext(m_contexts, info)) {
+				changes.emplace_back(info, false);
+			}
+		}
+		for (const auto &info : m_contexts) {
+			if (!containsContext(m_reported, info)) {
+				changes.emplace_back(info, true);
+			}
+		}
+		m_reported = m_contexts;
+
+		if (!changes.empty()) {
+			for (const auto &subscriber : m_subscribers) {
+				subscribers.push_back(subscriber.second.callback);
+			}
+		}
+	}
+
+	/* Called without the lock, so a callback may open a board or unsubscribe */
+	for (const auto &change : changes) {
+		LIBM2K_LOG(INFO, "Context " + std::string(change.second ? "added: " : "removed: ") + change.first.uri);
+		for (const auto &callback : subscribers) {
+			callback(change.first, change.second);
+		}
+	}
+}
+
+bool ContextDiscovery::scan(std::vector<libm2k::CONTEXT_INFO> &contexts)
+{
+	static const std::regex re(":| \\(Analog Devices Inc. |\\), serial=");
+	const std::sregex_token_iterator end;
+	struct iio_context_info **info;
+
+	/* Called with m_scan_lock held; the scan context is not meant to be shared between threads */
+	if (!m_scan_ctx) {
+		m_scan_ctx = iio_create_scan_context("usb", 0);
+		if (!m_scan_ctx) {
+			LIBM2K_LOG(ERROR, "Unable to create scan context!");
+			return false;
+		}
+	}
+
+	ssize_t ret = iio_scan_context_get_info_list(m_scan_ctx, &info);
+	if (ret < 0) {
+		LIBM2K_LOG(ERROR, "Unable to scan!");
+		/* Start over with a new scan context next time */
+		iio_scan_context_destroy(m_scan_ctx);
+		m_scan_ctx = nullptr;
+		return false;
+	}
+
+	for (unsigned int i = 0; i < static_cast<unsigned int>(ret); i++) {
+		std::string description = std::string(iio_context_info_get_description(info[i]));
+		std::sregex_token_iterator ptr(description.begin(), description.end(), re, -1);
+		libm2k::CONTEXT_INFO ctx_info;
+		ctx_info.uri = std::string(iio_context_info_get_uri(info[i]));
+		ctx_info.manufacturer = "Analog Devices Inc.";
+		if (ptr != end) {
+			ctx_info.id_vendor = *ptr++;
+		}
+		if (ptr != end) {
+			ctx_info.id_product = *ptr++;
+		}
+		if (ptr != end) {
+			ctx_info.product = *ptr++;
+		}
+		if (ptr != end) {
+			ctx_info.serial = *ptr++;
+		}
+		contexts.push_back(ctx_info);
+	}
+	iio_context_info_list_free(info);
+	return true;
+}
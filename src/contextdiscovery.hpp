@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CONTEXTDISCOVERY_HPP
+#define CONTEXTDISCOVERY_HPP
+
+#include <libm2k/enums.hpp>
+#include "utils/periodictask.hpp"
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+extern "C" {
+	struct iio_scan_context;
+}
+
+namespace libm2k {
+namespace context {
+
+/*
+ * Lists the USB connected contexts. The scan context is created once and
+ * reused, the results are cached for a short time and an optional watcher
+ * polls for added or removed boards and notifies its subscribers.
+ */
+class ContextDiscovery
+{
+public:
+	typedef std::function<void(const libm2k::CONTEXT_INFO &, bool)> Callback;
+
+	static ContextDiscovery &instance();
+
+	std::vector<libm2k::CONTEXT_INFO> getContexts(bool refresh = false);
+	void setCacheTimeout(unsigned int timeout_ms);
+
+	unsigned int subscribe(Callback callback, unsigned int period_ms);
+	void unsubscribe(unsigned int id);
+
+private:
+	ContextDiscovery();
+	~ContextDiscovery();
+	ContextDiscovery(const ContextDiscovery &) = delete;
+	ContextDiscovery &operator=(const ContextDiscovery &) = delete;
+
+	struct Subscriber {
+		Callback callback;
+		std::chrono::milliseconds period;
+	};
+
+	bool scan(std::vector<libm2k::CONTEXT_INFO> &contexts);
+	bool rescan();
+	void poll();
+	std::chrono::milliseconds watchPeriod();
+
+	std::mutex m_lock;
+	/* Held across a scan and the update of the cached list, so an older scan never overwrites a newer one */
+	std::mutex m_scan_lock;
+	struct iio_scan_context *m_scan_ctx;
+	std::vector<libm2k::CONTEXT_INFO> m_contexts;
+	bool m_valid;
+	std::chrono::steady_clock::time_point m_scan_time;
+	std::chrono::milliseconds m_timeout;
+	/* The list the subscribers were last notified about */
+	std::vector<libm2k::CONTEXT_INFO> m_reported;
+	std::map<unsigned int, Subscriber> m_subscribers;
+	unsigned int m_next_id;
+	libm2k::utils::PeriodicTask m_watcher;
+};
+}
+}
+
+#endif //CONTEXTDISCOVERY_HPP
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <libm2k/digital/bitplanes.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIBM2K_BITPLANES_SSE2
+#endif
+
+using namespace libm2k::digital;
+
+static const unsigned int NB_CHANNELS = 16;
+
+/* The samples are split one block at a time, so that a block read once for each
+ * channel stays in the cache */
+static const unsigned int CHANNELS_BLOCK = 4096;
+
+#ifdef LIBM2K_BITPLANES_SSE2
+/* Pack the low and the high bytes of 16 samples in two registers */
+static inline void splitBytes(const unsigned short *samples, __m128i &low, __m128i &high)
+{
+	const __m128i low_mask = _mm_set1_epi16(0x00ff);
+	__m128i a = _mm_loadu_si128((const __m128i *)samples);
+	__m128i b = _mm_loadu_si128((const __m128i *)(samples + 8));
+	low = _mm_packus_epi16(_mm_and_si128(a, low_mask), _mm_and_si128(b, low_mask));
+	high = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+}
+
+/* Add the bits of 16 samples to the planes of a 64-sample block, at position 16 * group.
+ * movemask collects the top bit of the 16 bytes, then each byte is shifted left by one
+ * for the next channel */
+static inline void transpose16(const unsigned short *samples, unsigned int group, unsigned long long *words)
+{
+	__m128i low, high;
+	splitBytes(samples, low, high);
+	unsigned int shift = 16 * group;
+	for (int bit = 7; bit >= 0; bit--) {
+		words[bit] |= (unsigned long long)(unsigned int)_mm_movemask_epi8(low) << shift;
+		words[bit + 8] |= (unsigned long long)(unsigned int)_mm_movemask_epi8(high) << shift;
+		low = _mm_add_epi8(low, low);
+		high = _mm_add_epi8(high, high);
+	}
+}
+
+static void transposeBlock(const unsigned short *samples, unsigned long long *words)
+{
+	for (unsigned int group = 0; group < 4; group++) {
+		transpose16(samples + 16 * group, group, words);
+	}
+}
+#else
+/* Transpose the 8x8 bit matrix held in x, one row per byte (Hacker's Delight, 7-3) */
+static inline unsigned long long transpose8(unsigned long long x)
+{
+	unsigned long long t;
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x = x ^ t ^ (t << 28);
+	return x;
+}
+
+/* The low and high bytes of 8 samples form two 8x8 matrices; once transposed,
+ * byte c of each holds the bits of channel c (or c + 8) for the 8 samples */
+static void transposeBlock(const unsigned short *samples, unsigned long long *words)
+{
+	for (unsigned int group = 0; group < 8; group++) {
+		const unsigned short *s = samples + 8 * group;
+		unsigned long long low = 0;
+		unsigned long long high = 0;
+		for (unsigned int r = 0; r < 8; r++) {
+			low |= (unsigned long long)(s[r] & 0xff) << (8 * r);
+			high |= (unsigned long long)(s[r] >> 8) << (8 * r);
+		}
+		low = transpose8(low);
+		high = transpose8(high);
+		unsigned int shift = 8 * group;
+		for (unsigned int c = 0; c < 8; c++) {
+			words[c] |= ((low >> (8 * c)) & 0xff) << shift;
+			words[c + 8] |= ((high >> (8 * c)) & 0xff) << shift;
+		}
+	}
+}
+#endif
+
+unsigned int libm2k::digital::getBitPlaneSize(unsigned int nb_samples)
+{
+	return (nb_samples + 63) / 64;
+}
+
+void libm2k::digital::extractBitPlanes(const unsigned short *samples, unsigned int nb_samples,
+				       unsigned long long *planes)
+{
+	unsigned int plane_size = getBitPlaneSize(nb_samples);
+	unsigned int nb_full = nb_samples / 64;
+	for (unsigned int k = 0; k < plane_size; k++) {
+		unsigned long long words[NB_CHANNELS] = {};
+		if (k < nb_full) {
+			transposeBlock(samples + 64 * k, words);
+		} else {
+			// the last, incomplete block is padded with zeros
+			unsigned short tail[64] = {};
+			std::memcpy(tail, samples + 64 * k, (nb_samples - 64 * k) * sizeof(unsigned short));
+			transposeBlock(tail, words);
+		}
+		for (unsigned int ch = 0; ch < NB_CHANNELS; ch++) {
+			planes[ch * plane_size + k] = words[ch];
+		}
+	}
+}
+
+void libm2k::digital::extractChannels(const unsigned short *samples, unsigned int nb_samples,
+				      unsigned char *channels)
+{
+	unsigned int i = 0;
+#ifdef LIBM2K_BITPLANES_SSE2
+	const __m128i one = _mm_set1_epi8(1);
+	for (; i + 16 <= nb_samples; i += 16) {
+		__m128i low, high;
+		splitBytes(samples + i, low, high);
+		for (unsigned int bit = 0; bit < 8; bit++) {
+			__m128i low_bits = _mm_and_si128(_mm_srli_epi16(low, bit), one);
+			__m128i high_bits = _mm_and_si128(_mm_srli_epi16(high, bit), one);
+			_mm_storeu_si128((__m128i *)(channels + (size_t)bit * nb_samples + i), low_bits);
+			_mm_storeu_si128((__m128i *)(channels + (size_t)(bit + 8) * nb_samples + i), high_bits);
+		}
+	}
+#endif
+	for (; i < nb_samples; i += CHANNELS_BLOCK) {
+		unsigned int n = std::min(CHANNELS_BLOCK, nb_samples - i);
+		const unsigned short *in = samples + i;
+		for (unsigned int ch = 0; ch < NB_CHANNELS; ch++) {
+			// a loop the compiler can vectorize
+			unsigned char *out = channels + (size_t)ch * nb_samples + i;
+			for (unsigned int k = 0; k < n; k++) {
+				out[k] = (in[k] >> ch) & 1;
+			}
+		}
+	}
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <libm2k/digital/digitaltransitions.hpp>
+#include <libm2k/m2kexceptions.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace libm2k;
+using namespace libm2k::digital;
+
+/* The samples are compared one block at a time; a block without changes is skipped */
+static const unsigned int SCAN_BLOCK = 64;
+
+DigitalTransitions::DigitalTransitions(double sample_rate) :
+	m_sample_rate(sample_rate),
+	m_nb_samples(0)
+{
+}
+
+void DigitalTransitions::append(const unsigned short *samples, unsigned int nb_samples)
+{
+	if (nb_samples == 0) {
+		return;
+	}
+	if (m_transitions.empty()) {
+		m_transitions.push_back({m_nb_samples, samples[0]});
+	}
+
+	unsigned short previous = m_transitions.back().value;
+	unsigned int i = 0;
+	while (i < nb_samples) {
+		unsigned int end = std::min(i + SCAN_BLOCK, nb_samples);
+		// a loop the compiler can vectorize: any bit set means a change in the block
+		unsigned short changes = samples[i] ^ previous;
+		for (unsigned int k = i + 1; k < end; k++) {
+			changes |= samples[k] ^ samples[k - 1];
+		}
+		if (changes) {
+			for (unsigned int k = i; k < end; k++) {
+				if (samples[k] != previous) {
+					m_transitions.push_back({m_nb_samples + k, samples[k]});
+					previous = samples[k];
+				}
+			}
+		}
+		previous = samples[end - 1];
+		i = end;
+	}
+	m_nb_samples += nb_samples;
+}
+
+void DigitalTransitions::append(std::vector<unsigned short> const &samples)
+{
+	append(samples.data(), samples.size());
+}
+
+void DigitalTransitions::clear()
+{
+	m_nb_samples = 0;
+	m_transitions.clear();
+}
+
+double DigitalTransitions::getSampleRate() const
+{
+	return m_sample_rate;
+}
+
+unsigned long long DigitalTransitions::getNbSamples() const
+{
+	return m_nb_samples;
+}
+
+std::vector<DIGITAL_TRANSITION> const &DigitalTransitions::getTransitions() const
+{
+	return m_transitions;
+}
+
+unsigned short DigitalTransitions::getValue(unsigned long long sample) const
+{
+	if (sample >= m_nb_samples) {
+		THROW_M2K_EXCEPTION("DigitalTransitions: No such sample", libm2k::EXC_OUT_OF_RANGE);
+	}
+	auto next = std::upper_bound(m_transitions.begin(), m_transitions.end(), sample,
+				     [](unsigned long long s, const DIGITAL_TRANSITION &t) { return s < t.sample; });
+	return (next - 1)->value;
+}
+
+unsigned short DigitalTransitions::getValueAt(double time) const
+{
+	if (!(m_sample_rate > 0)) {
+		THROW_M2K_EXCEPTION("DigitalTransitions: The sample rate is unknown", libm2k::EXC_OUT_OF_RANGE);
+	}
+	double sample = std::floor(time * m_sample_rate);
+	if (sample < 0 || sample >= (double)m_nb_samples) {
+		THROW_M2K_EXCEPTION("DigitalTransitions: No sample at this time", libm2k::EXC_OUT_OF_RANGE);
+	}
+	return getValue((unsigned long long)sample);
+}
+
+std::vector<unsigned long long> DigitalTransitions::getEdges(DIO_CHANNEL channel,
+							   libm2k::M2K_TRIGGER_CONDITION_DIGITAL edge) const
+{
+	if (edge != RISING_EDGE_DIGITAL && edge != FALLING_EDGE_DIGITAL && edge != ANY_EDGE_DIGITAL) {
+		THROW_M2K_EXCEPTION("DigitalTransitions: The condition is not an edge", libm2k::EXC_INVALID_PARAMETER);
+	}
+	unsigned short mask = 1 << channel;
+	std::vector<unsigned long long> edges;
+	for (size_t i = 1; i < m_transitions.size(); i++) {
+		unsigned short value = m_transitions[i].value & mask;
+		if (value == (m_transitions[i - 1].value & mask)) {
+			continue;
+		}
+		if (edge == ANY_EDGE_DIGITAL || (edge == RISING_EDGE_DIGITAL) == (value != 0)) {
+			edges.push_back(m_transitions[i].sample);
+		}
+	}
+	return edges;
+}
+
+std::vector<unsigned short> DigitalTransitions::getSamples(unsigned long long first, unsigned int nb_samples) const
+{
+	if (first + nb_samples > m_nb_samples) {
+		THROW_M2K_EXCEPTION("DigitalTransitions: No such samples", libm2k::EXC_OUT_OF_RANGE);
+	}
+	std::vector<unsigned short> samples(nb_samples);
+	if (nb_samples == 0) {
+		return samples;
+	}
+	auto it = std::upper_bound(m_transitions.begin(), m_transitions.end(), first,
+				   [](unsigned long long s, const DIGITAL_TRANSITION &t) { return s < t.sample; }) - 1;
+	unsigned long long sample = first;
+	while (sample < first + nb_samples) {
+		unsigned long long end = (it + 1 != m_transitions.end()) ? std::min((it + 1)->sample, first + nb_samples)
+									 : first + nb_samples;
+		std::fill(samples.begin() + (sample - first), samples.begin() + (end - first), it->value);
+		sample = end;
+		++it;
+	}
+	return samples;
+}
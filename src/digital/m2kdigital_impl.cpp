@@ -26,6 +26,7 @@
 #include <iio.h>
 #include <iostream>
 #include <algorithm>
+#include <climits>
 
 using namespace libm2k;
 using namespace libm2k::utils;
@@ -34,12 +35,63 @@ using namespace libm2k::analog;
 using namespace std;
 
 
+namespace {
+/* Writes the samples of a pattern into consecutive buffers */
+class PatternExpander
+{
+public:
+	explicit PatternExpander(const std::vector<DIGITAL_PATTERN_STEP> &pattern) :
+		m_pattern(pattern),
+		m_step(0),
+		m_left(pattern.empty() ? 0 : pattern.front().duration)
+	{
+	}
+
+	/* The number of samples written, fewer than nb_samples at the end of the pattern */
+	unsigned int fill(unsigned short *data, unsigned int nb_samples)
+	{
+		unsigned int written = 0;
+		while (written < nb_samples && m_step < m_pattern.size()) {
+			if (m_left == 0) {
+				m_step++;
+				m_left = (m_step < m_pattern.size()) ? m_pattern.at(m_step).duration : 0;
+				continue;
+			}
+			unsigned int count = (unsigned int)std::min<unsigned long long>(m_left, nb_samples - written);
+			std::fill_n(data + written, count, m_pattern.at(m_step).value);
+			written += count;
+			m_left -= count;
+		}
+		return written;
+	}
+private:
+	const std::vector<DIGITAL_PATTERN_STEP> &m_pattern;
+	size_t m_step;
+	unsigned long long m_left;
+};
+
+unsigned long long patternDuration(const std::vector<DIGITAL_PATTERN_STEP> &pattern)
+{
+	unsigned long long duration = 0;
+	for (const DIGITAL_PATTERN_STEP &step : pattern) {
+		duration += step.duration;
+	}
+	if (duration == 0) {
+		THROW_M2K_EXCEPTION("M2kDigital: The pattern is empty", libm2k::EXC_INVALID_PARAMETER);
+	}
+	return duration;
+}
+}
+
 std::vector<std::string> M2kDigitalImpl::m_output_mode = {
 	"open-drain",
 	"push-pull",
 };
 
-M2kDigitalImpl::M2kDigitalImpl(struct iio_context *ctx, std::string logic_dev, bool sync, M2kHardwareTrigger *trigger)
+M2kDigitalImpl::M2kDigitalImpl(struct iio_context *ctx, std::string logic_dev, bool sync, M2kHardwareTrigger *trigger) :
+	m_async_worker(new libm2k::utils::AsyncWorker()),
+	m_subscription(0),
+	m_last_subscription_id(0)
 {
 	LIBM2K_LOG(INFO, "[BEGIN] Initialize M2kDigital");
 	__try {
@@ -86,6 +138,10 @@ M2kDigitalImpl::M2kDigitalImpl(struct iio_context *ctx, std::string logic_dev, b
 		THROW_M2K_EXCEPTION("M2K Digital: logic device not found", libm2k::EXC_INVALID_PARAMETER);
 	}
 
+	m_dev_read->setStreamingCheck([this]() {
+		return m_trigger->getDigitalStreamingFlag();
+	});
+
 	if (sync) {
 		syncDevice();
 	}
@@ -94,6 +150,11 @@ M2kDigitalImpl::M2kDigitalImpl(struct iio_context *ctx, std::string logic_dev, b
 
 M2kDigitalImpl::~M2kDigitalImpl()
 {
+	if (m_subscription.exchange(0) != 0) {
+		// unblock the refill of the subscription so the worker can be joined
+		m_dev_read->cancelBuffer();
+	}
+	m_async_worker->stop();
 }
 
 void M2kDigitalImpl::syncDevice()
@@ -258,6 +319,54 @@ void M2kDigitalImpl::push(unsigned short *data, unsigned int nb_samples)
 	LIBM2K_LOG(INFO, "[END] M2kDigital push");
 }
 
+void M2kDigitalImpl::pushPattern(std::vector<DIGITAL_PATTERN_STEP> const &pattern)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kDigital pushPattern");
+	unsigned long long nb_samples = patternDuration(pattern);
+	if (nb_samples > UINT_MAX) {
+		THROW_M2K_EXCEPTION("M2kDigital: The pattern does not fit in one buffer", libm2k::EXC_OUT_OF_RANGE);
+	}
+	if (!anyChannelEnabled(DIO_OUTPUT)) {
+		THROW_M2K_EXCEPTION("M2kDigital: No TX channel enabled.", libm2k::EXC_INVALID_PARAMETER);
+	}
+	PatternExpander expander(pattern);
+	m_dev_write->fillAndPush(nb_samples, getCyclic(), [&expander](unsigned short *data, unsigned int nb_samples) {
+		expander.fill(data, nb_samples);
+	});
+	LIBM2K_LOG(INFO, "[END] M2kDigital pushPattern");
+}
+
+void M2kDigitalImpl::pushPattern(std::vector<DIGITAL_PATTERN_STEP> const &pattern, unsigned int buffer_size)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kDigital pushPattern");
+	if (getCyclic()) {
+		THROW_M2K_EXCEPTION("M2kDigital: Streaming a pattern requires the non-cyclic mode", libm2k::EXC_INVALID_PARAMETER);
+	}
+	if (buffer_size < 16 || buffer_size % 4 != 0) {
+		THROW_M2K_EXCEPTION("M2kDigital: The buffer size must be a multiple of 4, at least 16",
+				    libm2k::EXC_INVALID_PARAMETER);
+	}
+	unsigned long long nb_samples = patternDuration(pattern);
+	if (!anyChannelEnabled(DIO_OUTPUT)) {
+		THROW_M2K_EXCEPTION("M2kDigital: No TX channel enabled.", libm2k::EXC_INVALID_PARAMETER);
+	}
+
+	unsigned short last_value = 0;
+	for (const DIGITAL_PATTERN_STEP &step : pattern) {
+		if (step.duration > 0) {
+			last_value = step.value;
+		}
+	}
+	PatternExpander expander(pattern);
+	for (unsigned long long sent = 0; sent < nb_samples; sent += buffer_size) {
+		m_dev_write->fillAndPush(buffer_size, false, [&expander, last_value](unsigned short *data, unsigned int nb_samples) {
+			unsigned int written = expander.fill(data, nb_samples);
+			std::fill(data + written, data + nb_samples, last_value);
+		});
+	}
+	LIBM2K_LOG(INFO, "[END] M2kDigital pushPattern");
+}
+
 void M2kDigitalImpl::stopBufferOut()
 {
 	m_dev_write->stop();
@@ -480,6 +589,113 @@ void M2kDigitalImpl::getSamples(std::vector<unsigned short> &data, unsigned int
 	LIBM2K_LOG(INFO, "[END] M2kDigital getSamples");
 }
 
+void M2kDigitalImpl::getSamplesInto(unsigned short *data, unsigned int nb_samples)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kDigital getSamplesInto");
+	if (!anyChannelEnabled(DIO_INPUT)) {
+		THROW_M2K_EXCEPTION("M2kDigital: No RX channel enabled.", libm2k::EXC_INVALID_PARAMETER);
+	}
+
+	/* There is a restriction in the HDL that the buffer size must
+	 * be a multiple of 8 bytes (4x 16-bit samples). Round up to the
+	 * nearest multiple, but only copy what the client asked for.*/
+	unsigned int nb_samples_hw = ((nb_samples + 3) / 4) * 4;
+	const unsigned short *samples = m_dev_read->getSamplesP(nb_samples_hw);
+	std::copy(samples, samples + nb_samples, data);
+	LIBM2K_LOG(INFO, "[END] M2kDigital getSamplesInto");
+}
+
+DigitalTransitions M2kDigitalImpl::getTransitions(unsigned int nb_samples)
+{
+	DigitalTransitions transitions(getSampleRateIn());
+	getTransitions(transitions, nb_samples);
+	return transitions;
+}
+
+void M2kDigitalImpl::getTransitions(DigitalTransitions &transitions, unsigned int nb_samples)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kDigital getTransitions");
+	if (!anyChannelEnabled(DIO_INPUT)) {
+		THROW_M2K_EXCEPTION("M2kDigital: No RX channel enabled.", libm2k::EXC_INVALID_PARAMETER);
+	}
+
+	/* The samples are scanned in the buffer, without a copy; the buffer size
+	 * is rounded up as for getSamplesInto, but only nb_samples are kept */
+	unsigned int nb_samples_hw = ((nb_samples + 3) / 4) * 4;
+	const unsigned short *samples = m_dev_read->getSamplesP(nb_samples_hw);
+	transitions.append(samples, nb_samples);
+	LIBM2K_LOG(INFO, "[END] M2kDigital getTransitions");
+}
+
+void M2kDigitalImpl::getBitPlanesInto(unsigned long long *planes, unsigned int nb_samples)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kDigital getBitPlanesInto");
+	if (!anyChannelEnabled(DIO_INPUT)) {
+		THROW_M2K_EXCEPTION("M2kDigital: No RX channel enabled.", libm2k::EXC_INVALID_PARAMETER);
+	}
+
+	/* The samples are split straight from the buffer, without a copy */
+	unsigned int nb_samples_hw = ((nb_samples + 3) / 4) * 4;
+	const unsigned short *samples = m_dev_read->getSamplesP(nb_samples_hw);
+	extractBitPlanes(samples, nb_samples, planes);
+	LIBM2K_LOG(INFO, "[END] M2kDigital getBitPlanesInto");
+}
+
+void M2kDigitalImpl::getChannelsInto(unsigned char *data, unsigned int nb_samples)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kDigital getChannelsInto");
+	if (!anyChannelEnabled(DIO_INPUT)) {
+		THROW_M2K_EXCEPTION("M2kDigital: No RX channel enabled.", libm2k::EXC_INVALID_PARAMETER);
+	}
+
+	unsigned int nb_samples_hw = ((nb_samples + 3) / 4) * 4;
+	const unsigned short *samples = m_dev_read->getSamplesP(nb_samples_hw);
+	extractChannels(samples, nb_samples, data);
+	LIBM2K_LOG(INFO, "[END] M2kDigital getChannelsInto");
+}
+
+std::vector<DIGITAL_SEGMENT> M2kDigitalImpl::getSegments(unsigned int nb_segments, unsigned int nb_samples)
+{
+	LIBM2K_LOG(INFO, "[BEGIN] M2kDigital getSegments");
+	if (!anyChannelEnabled(DIO_INPUT)) {
+		THROW_M2K_EXCEPTION("M2kDigital: No RX channel enabled.", libm2k::EXC_INVALID_PARAMETER);
+	}
+	if (nb_segments == 0) {
+		THROW_M2K_EXCEPTION("M2kDigital: The number of segments must be greater than 0", libm2k::EXC_INVALID_PARAMETER);
+	}
+
+	std::vector<DIGITAL_SEGMENT> segments(nb_segments);
+	for (auto &segment : segments) {
+		segment.samples.resize(nb_samples);
+	}
+	unsigned int nb_samples_hw = ((nb_samples + 3) / 4) * 4;
+	bool streaming = m_trigger->getDigitalStreamingFlag();
+	if (streaming) {
+		m_trigger->setDigitalStreamingFlag(false);
+	}
+	__try {
+		/* The blocks already queued were triggered before this call; start from a new buffer,
+		 * then only refill it and copy the samples between two trigger events */
+		m_dev_read->flushBuffer();
+		for (auto &segment : segments) {
+			const unsigned short *samples = m_dev_read->getSamplesP(nb_samples_hw);
+			std::copy(samples, samples + nb_samples, segment.samples.begin());
+			segment.info = m_dev_read->getLastBlockInfo();
+		}
+	} __catch (m2k_exception &e) {
+		if (streaming) {
+			m_trigger->setDigitalStreamingFlag(true);
+		}
+		THROW_M2K_EXCEPTION("M2kDigital: " + std::string(e.what()), e.type(), e.iioCode());
+		return std::vector<DIGITAL_SEGMENT>();
+	}
+	if (streaming) {
+		m_trigger->setDigitalStreamingFlag(true);
+	}
+	LIBM2K_LOG(INFO, "[END] M2kDigital getSegments");
+	return segments;
+}
+
 bool M2kDigitalImpl::hasRateMux()
 {
 	return m_dev_read->hasGlobalAttribute("rate_mux");
@@ -530,3 +746,71 @@ bool M2kDigitalImpl::isClocksourceExternal()
 
 }
 
+libm2k::AsyncResult<std::vector<unsigned short>> M2kDigitalImpl::getSamplesAsync(unsigned int nb_samples)
+{
+	return m_async_worker->run<std::vector<unsigned short>>([this, nb_samples]() {
+		return getSamples(nb_samples);
+	});
+}
+
+libm2k::AsyncOperation M2kDigitalImpl::pushAsync(std::vector<unsigned short> const &data)
+{
+	return m_async_worker->run([this, data]() {
+		push(data);
+	});
+}
+
+libm2k::AsyncOperation M2kDigitalImpl::subscribeSamples(unsigned int nb_samples,
+		std::function<void(const std::vector<unsigned short> &)> callback)
+{
+	unsigned long long id = ++m_last_subscription_id;
+	unsigned long long none = 0;
+	if (!m_subscription.compare_exchange_strong(none, id)) {
+		THROW_M2K_EXCEPTION("M2kDigital: a subscription is already active", libm2k::EXC_INVALID_PARAMETER);
+	}
+	/* The worker runs one task at a time, so this loop starts only once the loop of a
+	 * previous subscription returned; each loop only follows its own id */
+	return m_async_worker->run([this, id, nb_samples, callback]() {
+		libm2k::utils::AsyncTokenRelease<unsigned long long> release(m_subscription, id, 0);
+		std::vector<unsigned short> data;
+		while (m_subscription == id) {
+			getSamples(data, nb_samples);
+			callback(data);
+		}
+		stopAcquisition();
+	});
+}
+
+void M2kDigitalImpl::unsubscribeSamples()
+{
+	m_subscription = 0;
+}
+
+libm2k::STREAM_BLOCK_INFO M2kDigitalImpl::getLastBlockInfo()
+{
+	return m_dev_read->getLastBlockInfo();
+}
+
+unsigned long long M2kDigitalImpl::getGapCount()
+{
+	return m_dev_read->getGapCount();
+}
+
+void M2kDigitalImpl::resetStreamInfo()
+{
+	m_dev_read->resetStreamInfo();
+}
+
+void M2kDigitalImpl::setOverflowDetection(bool enable)
+{
+	// the DMA status register of the ADC is not known to have the same layout on the logic analyzer
+	if (enable) {
+		THROW_M2K_EXCEPTION("M2K Digital: the logic analyzer does not report overflows", libm2k::EXC_INVALID_PARAMETER);
+	}
+	m_dev_read->setOverflowDetection(false);
+}
+
+bool M2kDigitalImpl::getOverflowDetection()
+{
+	return m_dev_read->getOverflowDetection();
+}
@@ -28,7 +28,9 @@
 #include <libm2k/m2khardwaretrigger.hpp>
 #include "utils/deviceout.hpp"
 #include "utils/devicein.hpp"
+#include "utils/asyncworker.hpp"
 #include <libm2k/digital/m2kdigital.hpp>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -52,6 +54,8 @@ public:
 
 	void push(std::vector<unsigned short> const &data) override;
 	void push(unsigned short *data, unsigned int nb_samples) override;
+	void pushPattern(std::vector<DIGITAL_PATTERN_STEP> const &pattern) override;
+	void pushPattern(std::vector<DIGITAL_PATTERN_STEP> const &pattern, unsigned int buffer_size) override;
 
 	void setValueRaw(DIO_CHANNEL index, DIO_LEVEL level) override;
 	void setValueRaw(unsigned int index, DIO_LEVEL level) override;
@@ -98,12 +102,30 @@ public:
 	unsigned int getNbChannelsOut() override;
 
 	void getSamples(std::vector<unsigned short> &data, unsigned int nb_samples) override;
+	void getSamplesInto(unsigned short *data, unsigned int nb_samples) override;
+	DigitalTransitions getTransitions(unsigned int nb_samples) override;
+	void getTransitions(DigitalTransitions &transitions, unsigned int nb_samples) override;
+	void getBitPlanesInto(unsigned long long *planes, unsigned int nb_samples) override;
+	void getChannelsInto(unsigned char *data, unsigned int nb_samples) override;
+	std::vector<DIGITAL_SEGMENT> getSegments(unsigned int nb_segments, unsigned int nb_samples) override;
 
 	bool hasRateMux();
 	void setRateMux() override;
 	void resetRateMux() override;
 	void setExternalClocksource(bool external) override;
 	bool isClocksourceExternal() override;
+
+	libm2k::AsyncResult<std::vector<unsigned short>> getSamplesAsync(unsigned int nb_samples) override;
+	libm2k::AsyncOperation pushAsync(std::vector<unsigned short> const &data) override;
+	libm2k::AsyncOperation subscribeSamples(unsigned int nb_samples,
+			std::function<void(const std::vector<unsigned short> &)> callback) override;
+	void unsubscribeSamples() override;
+
+	libm2k::STREAM_BLOCK_INFO getLastBlockInfo() override;
+	unsigned long long getGapCount() override;
+	void resetStreamInfo() override;
+	void setOverflowDetection(bool enable) override;
+	bool getOverflowDetection() override;
 private:
 	bool m_cyclic;
 	std::shared_ptr<libm2k::utils::DeviceIn> m_dev_read;
@@ -115,6 +137,10 @@ private:
 	std::vector<bool> m_rx_channels_enabled;
 	libm2k::M2kHardwareTrigger *m_trigger;
 	static std::vector<std::string> m_output_mode;
+	std::unique_ptr<libm2k::utils::AsyncWorker> m_async_worker;
+	/* The id of the active subscription, 0 if none */
+	std::atomic<unsigned long long> m_subscription;
+	std::atomic<unsigned long long> m_last_subscription_id;
 
 	void syncDevice();
 };
@@ -28,6 +28,8 @@
 #include "m2khardwaretrigger_v0.24_impl.hpp"
 #include "m2khardwaretrigger_v0.33_impl.hpp"
 #include "m2kcalibration_impl.hpp"
+#include "utils/calibrationcache.hpp"
+#include "utils/phasetimer.hpp"
 #include <libm2k/analog/dmm.hpp>
 #include "utils/channel.hpp"
 #include <libm2k/m2kexceptions.hpp>
@@ -39,6 +41,7 @@
 #include <iostream>
 #include <algorithm>
 #include <thread>
+#include <cmath>
 
 using namespace std;
 using namespace libm2k::context;
@@ -51,55 +54,29 @@ constexpr double defaultGain = 1;
 
 M2kImpl::M2kImpl(std::string uri, iio_context* ctx, std::string name, bool sync) :
 	ContextImpl(uri, ctx, name, sync),
-	m_sync(sync)
+	m_initialized(false),
+	m_calibration(nullptr),
+	m_trigger(nullptr),
+	m_sync(sync),
+	m_tracking_threshold(1.0),
+	m_tracked_temperature(0.0)
 {
-	initialize();
 	setTimeout(0);
 
-	for (auto ain : m_instancesAnalogIn) {
-		delete ain;
-	}
-	for (auto aout : m_instancesAnalogOut) {
-		delete aout;
-	}
-	for (auto ps : m_instancesPowerSupply) {
-		delete ps;
-	}
-	m_instancesAnalogIn.clear();
-	m_instancesAnalogOut.clear();
-	m_instancesPowerSupply.clear();
-
 	m_firmware_version = getFirmwareVersion();
 	// Remove suffix from dev version
 	std::size_t pos = m_firmware_version.find("-dirty");
 	if (pos != std::string::npos) {
 		m_firmware_version = m_firmware_version.substr(0, pos);
 	}
-
-	int diff_to_24 = Utils::compareVersions(m_firmware_version, "v0.24");
-	int diff_to_33 = Utils::compareVersions(m_firmware_version, "v0.33");
-	if (diff_to_24 < 0) { //m_firmware_version < 0.24 
-		m_trigger = new M2kHardwareTriggerImpl(ctx);
-	} else if (diff_to_33 < 0) { // (m_firmware_version >= 0.24) && (m_firmware_version < 0.33 )
-		m_trigger = new M2kHardwareTriggerV024Impl(ctx);
-	} else { // m_firmware_version >= 0.33
-		m_trigger = new M2kHardwareTriggerV033Impl(ctx);
-	}
-
-	if (!m_trigger) {
-		THROW_M2K_EXCEPTION("Can't instantiate M2K board; M2K trigger is invalid.", libm2k::EXC_INVALID_PARAMETER);
-	}
-
-	scanAllAnalogIn();
-	scanAllAnalogOut();
-	scanAllPowerSupply();
-	scanAllDigital();
-	m_calibration = new M2kCalibrationImpl(ctx, getAnalogIn(), getAnalogOut());
 }
 
 M2kImpl::~M2kImpl()
 {
-	delete m_calibration;
+	m_temperature_tracker.stop();
+	if (m_calibration) {
+		delete m_calibration;
+	}
 
 	if (m_trigger) {
 		delete m_trigger;
@@ -136,13 +113,18 @@ void M2kImpl::deinitialize()
 		}
 	}
 
-	auto ain_impl = dynamic_cast<M2kAnalogInImpl*>(getAnalogIn());
-	if (ain_impl) {
-		ain_impl->deinitialize();
+	/* Instruments which were never created have nothing to undo */
+	for (auto ain : m_instancesAnalogIn) {
+		auto ain_impl = dynamic_cast<M2kAnalogInImpl*>(ain);
+		if (ain_impl) {
+			ain_impl->deinitialize();
+		}
 	}
-	auto aout_impl = dynamic_cast<M2kAnalogOutImpl*>(getAnalogOut());
-	if (aout_impl) {
-		aout_impl->deinitialize();
+	for (auto aout : m_instancesAnalogOut) {
+		auto aout_impl = dynamic_cast<M2kAnalogOutImpl*>(aout);
+		if (aout_impl) {
+			aout_impl->deinitialize();
+		}
 	}
 
 	auto trigger_impl = dynamic_cast<M2kHardwareTriggerImpl*>(m_trigger);
@@ -153,6 +135,7 @@ void M2kImpl::deinitialize()
 
 void M2kImpl::reset()
 {
+	m_temperature_tracker.stop();
 	for (auto ain : m_instancesAnalogIn) {
 		ain->reset();
 	}
@@ -168,8 +151,12 @@ void M2kImpl::reset()
 	for (auto dmm : m_instancesDMM) {
 		dmm->reset();
 	}
-	m_trigger->reset();
+	if (m_trigger) {
+		m_trigger->reset();
+	}
+	std::lock_guard<std::recursive_mutex> lock(m_instances_lock);
 	initialize();
+	m_initialized = true;
 
 }
 
@@ -201,51 +188,66 @@ void M2kImpl::scanAllDigital()
 
 bool M2kImpl::calibrate()
 {
-	bool ok_adc, ok_dac = false;
-	ok_adc = calibrateADC();
-	ok_dac = calibrateDAC();
-	return ok_adc && ok_dac;
+	std::lock_guard<std::recursive_mutex> lock(m_calibration_lock);
+	LIBM2K_LOG(INFO, "[BEGIN] Calibrate");
+	const bool calibrationResult = getCalibration()->calibrateAll();
+	if (calibrationResult) {
+		storeCalibration();
+	}
+	LIBM2K_LOG(INFO, "[END] Calibrate");
+	return calibrationResult;
+}
+
+std::vector<CALIBRATION_TIMING> M2kImpl::getCalibrationTimings()
+{
+	return getCalibration()->getCalibrationTimings();
 }
 
 bool M2kImpl::resetCalibration()
 {
-	return m_calibration->resetCalibration();
+	std::lock_guard<std::recursive_mutex> lock(m_calibration_lock);
+	return getCalibration()->resetCalibration();
 }
 
 bool M2kImpl::calibrateADC()
 {
+	std::lock_guard<std::recursive_mutex> lock(m_calibration_lock);
 	LIBM2K_LOG(INFO, "[BEGIN] Calibrate ADC");
-	const bool calibrationResult = m_calibration->calibrateADC();
+	const bool calibrationResult = getCalibration()->calibrateADC();
 	LIBM2K_LOG(INFO, "[END] Calibrate ADC");
 	return calibrationResult;
 }
 
 bool M2kImpl::calibrateDAC()
 {
+	std::lock_guard<std::recursive_mutex> lock(m_calibration_lock);
 	LIBM2K_LOG(INFO, "[BEGIN] Calibrate DAC");
-	bool calibrationResult = m_calibration->calibrateDAC();
+	bool calibrationResult = getCalibration()->calibrateDAC();
+	if (calibrationResult && getCalibration()->getAdcCalibrated()) {
+		storeCalibration();
+	}
 	LIBM2K_LOG(INFO, "[END] Calibrate DAC");
 	return calibrationResult;
 }
 
 double M2kImpl::getAdcCalibrationGain(unsigned int chn)
 {
-	return m_calibration->getAdcGain(chn);
+	return getCalibration()->getAdcGain(chn);
 }
 
 int M2kImpl::getAdcCalibrationOffset(unsigned int chn)
 {
-	return m_calibration->getAdcOffset(chn);
+	return getCalibration()->getAdcOffset(chn);
 }
 
 double M2kImpl::getDacCalibrationGain(unsigned int chn)
 {
-	return m_calibration->getDacGain(chn);
+	return getCalibration()->getDacGain(chn);
 }
 
 int M2kImpl::getDacCalibrationOffset(unsigned int chn)
 {
-	return m_calibration->getDacOffset(chn);
+	return getCalibration()->getDacOffset(chn);
 }
 
 void M2kImpl::setAdcCalibrationGain(unsigned int chn, double gain)
@@ -253,7 +255,7 @@ void M2kImpl::setAdcCalibrationGain(unsigned int chn, double gain)
 	if (chn >= getAnalogIn()->getNbChannels()) {
 		THROW_M2K_EXCEPTION("No such ADC channel", libm2k::EXC_OUT_OF_RANGE);
 	}
-	m_calibration->setAdcGain(chn, gain);
+	getCalibration()->setAdcGain(chn, gain);
 }
 
 void M2kImpl::setAdcCalibrationOffset(unsigned int chn, int offset)
@@ -261,7 +263,7 @@ void M2kImpl::setAdcCalibrationOffset(unsigned int chn, int offset)
 	if (chn >= getAnalogIn()->getNbChannels()) {
 		THROW_M2K_EXCEPTION("No such ADC channel", libm2k::EXC_OUT_OF_RANGE);
 	}
-	m_calibration->setAdcOffset(chn, offset);
+	getCalibration()->setAdcOffset(chn, offset);
 }
 
 void M2kImpl::setDacCalibrationOffset(unsigned int chn, int offset)
@@ -269,7 +271,7 @@ void M2kImpl::setDacCalibrationOffset(unsigned int chn, int offset)
 	if (chn >= getAnalogOut()->getNbChannels()) {
 		THROW_M2K_EXCEPTION("No such DAC channel", libm2k::EXC_OUT_OF_RANGE);
 	}
-	m_calibration->setDacOffset(chn, offset);
+	getCalibration()->setDacOffset(chn, offset);
 }
 
 void M2kImpl::setDacCalibrationGain(unsigned int chn, double gain)
@@ -277,23 +279,70 @@ void M2kImpl::setDacCalibrationGain(unsigned int chn, double gain)
 	if (chn >= getAnalogOut()->getNbChannels()) {
 		THROW_M2K_EXCEPTION("No such DAC channel", libm2k::EXC_OUT_OF_RANGE);
 	}
-	m_calibration->setDacGain(chn, gain);
+	getCalibration()->setDacGain(chn, gain);
+}
+
+void M2kImpl::ensureInitialized()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_instances_lock);
+	if (!m_initialized) {
+		PhaseTimer timer("Initialize M2K");
+		initialize();
+		m_initialized = true;
+		timer.finish();
+	}
+}
+
+libm2k::M2kHardwareTrigger* M2kImpl::getTrigger()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_instances_lock);
+	if (m_trigger) {
+		return m_trigger;
+	}
+
+	PhaseTimer timer("Create M2K trigger");
+	int diff_to_24 = Utils::compareVersions(m_firmware_version, "v0.24");
+	int diff_to_33 = Utils::compareVersions(m_firmware_version, "v0.33");
+	if (diff_to_24 < 0) { //m_firmware_version < 0.24 
+		m_trigger = new M2kHardwareTriggerImpl(m_context);
+	} else if (diff_to_33 < 0) { // (m_firmware_version >= 0.24) && (m_firmware_version < 0.33 )
+		m_trigger = new M2kHardwareTriggerV024Impl(m_context);
+	} else { // m_firmware_version >= 0.33
+		m_trigger = new M2kHardwareTriggerV033Impl(m_context);
+	}
+
+	if (!m_trigger) {
+		THROW_M2K_EXCEPTION("Can't instantiate M2K board; M2K trigger is invalid.", libm2k::EXC_INVALID_PARAMETER);
+	}
+	timer.finish();
+	return m_trigger;
+}
+
+M2kCalibration* M2kImpl::getCalibration()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_instances_lock);
+	if (!m_calibration) {
+		m_calibration = new M2kCalibrationImpl(m_context, getAnalogIn(), getAnalogOut());
+	}
+	return m_calibration;
 }
 
 M2kAnalogIn* M2kImpl::getAnalogIn()
 {
-	auto aIn = dynamic_cast<libm2k::analog::M2kAnalogIn*>(
-				m_instancesAnalogIn.at(0));
-	if (aIn) {
-		return aIn;
-	} else {
-		return nullptr;
+	std::lock_guard<std::recursive_mutex> lock(m_instances_lock);
+	if (m_instancesAnalogIn.empty()) {
+		ensureInitialized();
+		getTrigger();
+		PhaseTimer timer("Create M2kAnalogIn");
+		scanAllAnalogIn();
+		timer.finish();
 	}
+	return m_instancesAnalogIn.at(0);
 }
 
 M2kAnalogIn* M2kImpl::getAnalogIn(string dev_name)
 {
-	for (M2kAnalogIn* d : m_instancesAnalogIn) {
+	for (M2kAnalogIn* d : getAllAnalogIn()) {
 		if (d->getName() == dev_name) {
 			libm2k::analog::M2kAnalogIn* analogIn =
 					dynamic_cast<libm2k::analog::M2kAnalogIn*>(d);
@@ -307,6 +356,13 @@ M2kAnalogIn* M2kImpl::getAnalogIn(string dev_name)
 
 M2kPowerSupply* M2kImpl::getPowerSupply()
 {
+	std::lock_guard<std::recursive_mutex> lock(m_instances_lock);
+	if (m_instancesPowerSupply.empty()) {
+		/* The power supply needs neither the trigger nor the analog setup */
+		PhaseTimer timer("Create M2kPowerSupply");
+		scanAllPowerSupply();
+		timer.finish();
+	}
 	M2kPowerSupply* pSupply = dynamic_cast<M2kPowerSupply*>(m_instancesPowerSupply.at(0));
 	if (!pSupply) {
 		THROW_M2K_EXCEPTION("No M2K power supply", libm2k::EXC_INVALID_PARAMETER);
@@ -316,6 +372,14 @@ M2kPowerSupply* M2kImpl::getPowerSupply()
 
 M2kDigital* M2kImpl::getDigital()
 {
+	std::lock_guard<std::recursive_mutex> lock(m_instances_lock);
+	if (m_instancesDigital.empty()) {
+		ensureInitialized();
+		getTrigger();
+		PhaseTimer timer("Create M2kDigital");
+		scanAllDigital();
+		timer.finish();
+	}
 	M2kDigital* logic = dynamic_cast<M2kDigital*>(m_instancesDigital.at(0));
 	if (!logic) {
 		THROW_M2K_EXCEPTION("No M2K digital device found", libm2k::EXC_INVALID_PARAMETER);
@@ -325,19 +389,26 @@ M2kDigital* M2kImpl::getDigital()
 
 M2kAnalogOut* M2kImpl::getAnalogOut()
 {
-	if (m_instancesAnalogOut.size() > 0) {
-		return m_instancesAnalogOut.at(0);
+	std::lock_guard<std::recursive_mutex> lock(m_instances_lock);
+	if (m_instancesAnalogOut.empty()) {
+		ensureInitialized();
+		getTrigger();
+		PhaseTimer timer("Create M2kAnalogOut");
+		scanAllAnalogOut();
+		timer.finish();
 	}
-	return nullptr;
+	return m_instancesAnalogOut.at(0);
 }
 
 std::vector<M2kAnalogIn*> M2kImpl::getAllAnalogIn()
 {
+	getAnalogIn();
 	return m_instancesAnalogIn;
 }
 
 std::vector<M2kAnalogOut*> M2kImpl::getAllAnalogOut()
 {
+	getAnalogOut();
 	return m_instancesAnalogOut;
 }
 
@@ -353,28 +424,28 @@ void M2kImpl::startMixedSignalAcquisition(unsigned int nb_samples)
 	const bool hasAnalogTrigger = this->hasAnalogTrigger();
 	const bool hasDigitalTrigger = this->hasDigitalTrigger();
 
-	analogSource = m_trigger->getAnalogSource();
-	digitalSource = m_trigger->getDigitalSource();
+	analogSource = getTrigger()->getAnalogSource();
+	digitalSource = getTrigger()->getDigitalSource();
 
 	if (!hasAnalogTrigger && !hasDigitalTrigger) {
 		// no trigger
-		m_trigger->setAnalogSource(NO_SOURCE);
-		m_trigger->setDigitalSource(SRC_ANALOG_IN);
+		getTrigger()->setAnalogSource(NO_SOURCE);
+		getTrigger()->setDigitalSource(SRC_ANALOG_IN);
 	} else if (!hasDigitalTrigger) {
 		// analog trigger
-		m_trigger->setAnalogSource(NO_SOURCE);
-		m_trigger->setDigitalSource(SRC_ANALOG_IN);
+		getTrigger()->setAnalogSource(NO_SOURCE);
+		getTrigger()->setDigitalSource(SRC_ANALOG_IN);
 	} else if (!hasAnalogTrigger) {
 		// digital trigger
-		m_trigger->setDigitalSource(SRC_DISABLED);
-		m_trigger->setAnalogSource(SRC_DIGITAL_IN);
+		getTrigger()->setDigitalSource(SRC_DISABLED);
+		getTrigger()->setAnalogSource(SRC_DIGITAL_IN);
 	}
 
 	// share the same rate
-	m_instancesDigital.at(0)->setRateMux();
+	getDigital()->setRateMux();
 
 	// start acquisition
-	for (auto analogIn : m_instancesAnalogIn) {
+	for (auto analogIn : getAllAnalogIn()) {
 		analogIn->startAcquisition(nb_samples);
 	}
 	for (auto digital : m_instancesDigital) {
@@ -383,12 +454,12 @@ void M2kImpl::startMixedSignalAcquisition(unsigned int nb_samples)
 
 	// release the trigger
 	if (!hasAnalogTrigger && !hasDigitalTrigger) {
-		m_trigger->setAnalogMode(CHANNEL_1, ALWAYS);
-		m_trigger->setAnalogSource(CHANNEL_1);
+		getTrigger()->setAnalogMode(CHANNEL_1, ALWAYS);
+		getTrigger()->setAnalogSource(CHANNEL_1);
 	} else if (!hasDigitalTrigger) {
-		m_trigger->setAnalogSource(analogSource);
+		getTrigger()->setAnalogSource(analogSource);
 	} else if (!hasAnalogTrigger) {
-		m_trigger->setDigitalSource(digitalSource);
+		getTrigger()->setDigitalSource(digitalSource);
 	}
 	LIBM2K_LOG(INFO, "[END] Start mixed signal acquisition");
 }
@@ -396,15 +467,15 @@ void M2kImpl::startMixedSignalAcquisition(unsigned int nb_samples)
 void M2kImpl::stopMixedSignalAcquisition()
 {
 	LIBM2K_LOG(INFO, "[BEGIN] Stop mixed signal acquisition");
-	for (auto analogIn : m_instancesAnalogIn) {
+	for (auto analogIn : getAllAnalogIn()) {
 		analogIn->stopAcquisition();
 	}
 	for (auto digital : m_instancesDigital) {
 		digital->stopAcquisition();
 	}
-	m_instancesDigital.at(0)->resetRateMux();
-	m_trigger->setAnalogSource(analogSource);
-	m_trigger->setDigitalSource(digitalSource);
+	getDigital()->resetRateMux();
+	getTrigger()->setAnalogSource(analogSource);
+	getTrigger()->setDigitalSource(digitalSource);
 	LIBM2K_LOG(INFO, "[END] Stop mixed signal acquisition");
 }
 
@@ -413,11 +484,11 @@ bool M2kImpl::hasAnalogTrigger()
 	enum M2K_TRIGGER_SOURCE_ANALOG source;
 	enum M2K_TRIGGER_MODE mode;
 
-	source = m_trigger->getAnalogSource();
+	source = getTrigger()->getAnalogSource();
 	switch (source) {
 	case CHANNEL_1:
 	case CHANNEL_2:
-		mode = m_trigger->getAnalogMode(source);
+		mode = getTrigger()->getAnalogMode(source);
 		if (mode != ALWAYS) {
 			return true;
 		}
@@ -425,26 +496,26 @@ bool M2kImpl::hasAnalogTrigger()
 	case CHANNEL_1_OR_CHANNEL_2:
 	case CHANNEL_1_AND_CHANNEL_2:
 	case CHANNEL_1_XOR_CHANNEL_2:
-		return m_trigger->getAnalogMode(CHANNEL_1) || m_trigger->getAnalogMode(CHANNEL_2);
+		return getTrigger()->getAnalogMode(CHANNEL_1) || getTrigger()->getAnalogMode(CHANNEL_2);
 	case SRC_DIGITAL_IN:
 		return false;
 	case CHANNEL_1_OR_SRC_LOGIC_ANALYZER:
-		if (m_trigger->getDigitalSource() == SRC_ANALOG_IN) {
+		if (getTrigger()->getDigitalSource() == SRC_ANALOG_IN) {
 			return true;
 		}
-		mode = m_trigger->getAnalogMode(CHANNEL_1);
+		mode = getTrigger()->getAnalogMode(CHANNEL_1);
 		return mode || hasDigitalTrigger();
 	case CHANNEL_2_OR_SRC_LOGIC_ANALYZER:
-		if (m_trigger->getDigitalSource() == SRC_ANALOG_IN) {
+		if (getTrigger()->getDigitalSource() == SRC_ANALOG_IN) {
 			return true;
 		}
-		mode = m_trigger->getAnalogMode(CHANNEL_2);
+		mode = getTrigger()->getAnalogMode(CHANNEL_2);
 		return mode || hasDigitalTrigger();
 	case CHANNEL_1_OR_CHANNEL_2_OR_SRC_LOGIC_ANALYZER:
-		if (m_trigger->getDigitalSource() == SRC_ANALOG_IN) {
+		if (getTrigger()->getDigitalSource() == SRC_ANALOG_IN) {
 			return true;
 		}
-		return m_trigger->getAnalogMode(CHANNEL_1) || m_trigger->getAnalogMode(CHANNEL_2) || hasDigitalTrigger();
+		return getTrigger()->getAnalogMode(CHANNEL_1) || getTrigger()->getAnalogMode(CHANNEL_2) || hasDigitalTrigger();
 	case NO_SOURCE:
 		return false;
 	}
@@ -457,15 +528,14 @@ bool M2kImpl::hasDigitalTrigger()
 	enum M2K_TRIGGER_CONDITION_DIGITAL condition;
 	unsigned int ch_index;
 
-	source = m_trigger->getDigitalSource();
+	source = getTrigger()->getDigitalSource();
 	switch (source) {
 	case SRC_NONE:
-		for (auto digital : m_instancesDigital) {
-			for (ch_index = 0; ch_index < digital->getNbChannelsIn(); ch_index++) {
-				condition = m_trigger->getDigitalCondition(ch_index);
-				if (condition != NO_TRIGGER_DIGITAL) {
-					return true;
-				}
+		// the digital instrument is created on first use, make sure it exists
+		for (ch_index = 0; ch_index < getDigital()->getNbChannelsIn(); ch_index++) {
+			condition = getTrigger()->getDigitalCondition(ch_index);
+			if (condition != NO_TRIGGER_DIGITAL) {
+				return true;
 			}
 		}
 		return false;
@@ -632,15 +702,15 @@ bool M2kImpl::isCalibrated()
 	int diff = Utils::compareVersions(m_firmware_version, "v0.25");
 	if (diff <= 0) {
 		// for FW 0.25 and earlier we cannot conclude if the adc/dac was calibrated due to missing calibbias attribute
-		return m_calibration->getAdcCalibrated() && m_calibration->getDacCalibrated();
+		return getCalibration()->getAdcCalibrated() && getCalibration()->getDacCalibrated();
 	}
 
 	for (unsigned int i = 0; i < 2; i++) {
-		if (m_calibration->getAdcOffset(i) != defaultOffset || m_calibration->getDacOffset(i) != defaultOffset) {
+		if (getCalibration()->getAdcOffset(i) != defaultOffset || getCalibration()->getDacOffset(i) != defaultOffset) {
 			return true;
 		}
 
-		if (m_calibration->getAdcGain(i) != defaultGain || m_calibration->getDacGain(i) != defaultGain) {
+		if (getCalibration()->getAdcGain(i) != defaultGain || getCalibration()->getDacGain(i) != defaultGain) {
 			return true;
 		}
 	}
@@ -673,23 +743,168 @@ double M2kImpl::getCalibrationTemperature(double temperature)
 
 double M2kImpl::calibrateFromContext()
 {
+	std::lock_guard<std::recursive_mutex> lock(m_calibration_lock);
 	LIBM2K_LOG(INFO, "[BEGIN] Calibrate from context");
-	double temperature = getDMM("ad9963")->readChannel("temp0").value;
+	double temperature = readTemperature();
 	double calibrationTemperature = getCalibrationTemperature(temperature);
 	auto it = m_calibration_lut.find(calibrationTemperature);
 	if (it == m_calibration_lut.end()) {
 		THROW_M2K_EXCEPTION("Calibration from context is unavailable", libm2k::EXC_RUNTIME_ERROR);
 	}
-	auto calibrationParameters = it->second;
-
-	m_calibration->setAdcOffset(0, calibrationParameters->adc_offset_ch_1);
-	m_calibration->setAdcOffset(1, calibrationParameters->adc_offset_ch_2);
-	m_calibration->setAdcGain(0, calibrationParameters->adc_gain_ch_1);
-	m_calibration->setAdcGain(1, calibrationParameters->adc_gain_ch_2);
-	m_calibration->setDacOffset(0, calibrationParameters->dac_a_offset);
-	m_calibration->setDacOffset(1, calibrationParameters->dac_b_offset);
-	m_calibration->setDacGain(0, calibrationParameters->dac_a_gain);
-	m_calibration->setDacGain(1, calibrationParameters->dac_b_gain);
+	applyCalibrationParameters(*it->second);
 	LIBM2K_LOG(INFO, "[END] Calibrate from context");
 	return calibrationTemperature;
 }
+
+struct CALIBRATION_PARAMETERS M2kImpl::getInterpolatedCalibrationParameters(double temperature)
+{
+	if (m_calibration_lut.empty()) {
+		if (!hasContextCalibration()) {
+			THROW_M2K_EXCEPTION("Calibration from context is unavailable", libm2k::EXC_RUNTIME_ERROR);
+		}
+	}
+
+	auto high = m_calibration_lut.lower_bound(temperature);
+	if (high == m_calibration_lut.end()) {
+		return *m_calibration_lut.rbegin()->second;
+	}
+	if (high == m_calibration_lut.begin() || high->first == temperature) {
+		return *high->second;
+	}
+	auto low = std::prev(high);
+
+	/* The table holds a few points, far apart; a straight line between them is all it supports */
+	const double w = (temperature - low->first) / (high->first - low->first);
+	const struct CALIBRATION_PARAMETERS &a = *low->second;
+	const struct CALIBRATION_PARAMETERS &b = *high->second;
+	auto lerp = [w](double x, double y) { return x + w * (y - x); };
+
+	struct CALIBRATION_PARAMETERS parameters;
+	parameters.adc_offset_ch_1 = static_cast<int>(std::lround(lerp(a.adc_offset_ch_1, b.adc_offset_ch_1)));
+	parameters.adc_offset_ch_2 = static_cast<int>(std::lround(lerp(a.adc_offset_ch_2, b.adc_offset_ch_2)));
+	parameters.adc_gain_ch_1 = lerp(a.adc_gain_ch_1, b.adc_gain_ch_1);
+	parameters.adc_gain_ch_2 = lerp(a.adc_gain_ch_2, b.adc_gain_ch_2);
+	parameters.dac_a_offset = static_cast<int>(std::lround(lerp(a.dac_a_offset, b.dac_a_offset)));
+	parameters.dac_b_offset = static_cast<int>(std::lround(lerp(a.dac_b_offset, b.dac_b_offset)));
+	parameters.dac_a_gain = lerp(a.dac_a_gain, b.dac_a_gain);
+	parameters.dac_b_gain = lerp(a.dac_b_gain, b.dac_b_gain);
+	return parameters;
+}
+
+double M2kImpl::calibrateFromContextInterpolated()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_calibration_lock);
+	LIBM2K_LOG(INFO, "[BEGIN] Calibrate from context, interpolated");
+	const double temperature = readTemperature();
+	applyCalibrationParameters(getInterpolatedCalibrationParameters(temperature));
+	LIBM2K_LOG(INFO, "[END] Calibrate from context, interpolated");
+	return temperature;
+}
+
+void M2kImpl::startTemperatureTracking(double threshold, unsigned int period_ms)
+{
+	if (threshold <= 0) {
+		THROW_M2K_EXCEPTION("The temperature threshold must be greater than 0", libm2k::EXC_INVALID_PARAMETER);
+	}
+	if (period_ms == 0) {
+		THROW_M2K_EXCEPTION("The tracking period must be greater than 0", libm2k::EXC_INVALID_PARAMETER);
+	}
+	m_temperature_tracker.stop();
+
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_calibration_lock);
+		m_tracking_threshold = threshold;
+		m_tracked_temperature = readTemperature();
+		getCalibration()->updateCalibrationParameters(getInterpolatedCalibrationParameters(m_tracked_temperature));
+	}
+	m_temperature_tracker.start(std::chrono::milliseconds(period_ms), [this]() {
+		trackTemperature();
+	});
+}
+
+void M2kImpl::stopTemperatureTracking()
+{
+	m_temperature_tracker.stop();
+}
+
+bool M2kImpl::isTemperatureTracking()
+{
+	return m_temperature_tracker.isRunning();
+}
+
+void M2kImpl::trackTemperature()
+{
+	/* Leave the board alone while a calibration is running, the next reading will catch up */
+	std::unique_lock<std::recursive_mutex> lock(m_calibration_lock, std::try_to_lock);
+	if (!lock.owns_lock()) {
+		return;
+	}
+
+	const double temperature = readTemperature();
+	if (std::fabs(temperature - m_tracked_temperature) < m_tracking_threshold) {
+		return;
+	}
+	getCalibration()->updateCalibrationParameters(getInterpolatedCalibrationParameters(temperature));
+	LIBM2K_LOG(INFO, "Calibration updated for " + std::to_string(temperature) + " degrees, was "
+		   + std::to_string(m_tracked_temperature));
+	m_tracked_temperature = temperature;
+}
+
+bool M2kImpl::calibrateFromCache(double max_temperature_difference)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_calibration_lock);
+	LIBM2K_LOG(INFO, "[BEGIN] Calibrate from cache");
+	struct CALIBRATION_PARAMETERS parameters;
+	double cachedTemperature;
+	CalibrationCache cache;
+
+	const double temperature = readTemperature();
+	if (cache.find(getSerialNumber(), m_firmware_version, temperature, max_temperature_difference,
+		       parameters, cachedTemperature)) {
+		applyCalibrationParameters(parameters);
+		LIBM2K_LOG(INFO, "[END] Calibrate from cache, parameters measured at " + std::to_string(cachedTemperature));
+		return true;
+	}
+
+	const bool calibrationResult = calibrate();
+	LIBM2K_LOG(INFO, "[END] Calibrate from cache, no cached parameters");
+	return calibrationResult;
+}
+
+double M2kImpl::readTemperature()
+{
+	return getDMM("ad9963")->readChannel("temp0").value;
+}
+
+void M2kImpl::applyCalibrationParameters(const struct CALIBRATION_PARAMETERS &parameters)
+{
+	getCalibration()->setAdcOffset(0, parameters.adc_offset_ch_1);
+	getCalibration()->setAdcOffset(1, parameters.adc_offset_ch_2);
+	getCalibration()->setAdcGain(0, parameters.adc_gain_ch_1);
+	getCalibration()->setAdcGain(1, parameters.adc_gain_ch_2);
+	getCalibration()->setDacOffset(0, parameters.dac_a_offset);
+	getCalibration()->setDacOffset(1, parameters.dac_b_offset);
+	getCalibration()->setDacGain(0, parameters.dac_a_gain);
+	getCalibration()->setDacGain(1, parameters.dac_b_gain);
+}
+
+void M2kImpl::storeCalibration()
+{
+	/* The cache only speeds up later calibrations; failing to update it is not an error */
+	__try {
+		struct CALIBRATION_PARAMETERS parameters;
+		parameters.adc_offset_ch_1 = getCalibration()->getAdcOffset(0);
+		parameters.adc_offset_ch_2 = getCalibration()->getAdcOffset(1);
+		parameters.adc_gain_ch_1 = getCalibration()->getAdcGain(0);
+		parameters.adc_gain_ch_2 = getCalibration()->getAdcGain(1);
+		parameters.dac_a_offset = getCalibration()->getDacOffset(0);
+		parameters.dac_b_offset = getCalibration()->getDacOffset(1);
+		parameters.dac_a_gain = getCalibration()->getDacGain(0);
+		parameters.dac_b_gain = getCalibration()->getDacGain(1);
+
+		CalibrationCache cache;
+		cache.store(getSerialNumber(), m_firmware_version, readTemperature(), parameters);
+	} __catch (exception_type &e) {
+		LIBM2K_LOG(WARNING, std::string("Cannot cache the calibration: ") + e.what());
+	}
+}
@@ -25,6 +25,8 @@
 #include <libm2k/m2k.hpp>
 #include "context_impl.hpp"
 #include <libm2k/enums.hpp>
+#include "utils/periodictask.hpp"
+#include <mutex>
 
 namespace libm2k {
 class M2kHardwareTrigger;
@@ -51,6 +53,12 @@ public:
 	bool calibrateDAC() override;
 	bool resetCalibration() override;
 	double calibrateFromContext() override;
+	std::vector<libm2k::CALIBRATION_TIMING> getCalibrationTimings() override;
+	bool calibrateFromCache(double max_temperature_difference = 2.0) override;
+	double calibrateFromContextInterpolated() override;
+	void startTemperatureTracking(double threshold = 1.0, unsigned int period_ms = 5000) override;
+	void stopTemperatureTracking() override;
+	bool isTemperatureTracking() override;
 
 	libm2k::digital::M2kDigital* getDigital() override;
 	libm2k::analog::M2kPowerSupply* getPowerSupply() override;
@@ -82,6 +90,9 @@ public:
 	std::string getFirmwareVersion() override;
 
 private:
+	/* Instruments are created on first use; m_instances_lock guards their creation */
+	std::recursive_mutex m_instances_lock;
+	bool m_initialized;
 	M2kCalibration* m_calibration;
 	libm2k::M2kHardwareTrigger *m_trigger;
 	std::vector<analog::M2kAnalogOut*> m_instancesAnalogOut;
@@ -96,9 +107,23 @@ private:
 	bool hasDigitalTrigger();
 	std::map<double, shared_ptr<struct CALIBRATION_PARAMETERS>> m_calibration_lut;
 
+	/* Held by the calibration calls; the temperature tracker skips a reading while it is taken */
+	std::recursive_mutex m_calibration_lock;
+	double m_tracking_threshold;
+	double m_tracked_temperature;
+	libm2k::utils::PeriodicTask m_temperature_tracker;
+
 	double getCalibrationTemperature(double temperature);
+	struct CALIBRATION_PARAMETERS getInterpolatedCalibrationParameters(double temperature);
+	void trackTemperature();
+	double readTemperature();
+	void applyCalibrationParameters(const struct CALIBRATION_PARAMETERS &parameters);
+	void storeCalibration();
 	void blinkLed(const double duration = 4, bool blocking = false);
 	void initialize();
+	void ensureInitialized();
+	libm2k::M2kHardwareTrigger* getTrigger();
+	M2kCalibration* getCalibration();
 };
 }
 }
@@ -28,6 +28,8 @@
 #include <libm2k/utils/utils.hpp>
 #include <libm2k/enums.hpp>
 
+#include <libm2k/logger.hpp>
+
 #include <errno.h>
 #include <iio.h>
 #include <vector>
@@ -39,6 +41,13 @@ using namespace libm2k;
 using namespace libm2k::analog;
 using namespace libm2k::utils;
 
+/* Samples per channel of one calibration capture; a measurement averages the last two captures */
+static const unsigned int CALIB_BLOCK_SAMPLES = 32768u;
+/* Two consecutive captures within this many raw LSBs mean the input settled */
+static const double CALIB_SETTLE_TOLERANCE = 0.25;
+/* Measure anyway if the input did not settle after this long */
+static const std::chrono::milliseconds CALIB_SETTLE_TIMEOUT(200);
+
 M2kCalibrationImpl::M2kCalibrationImpl(struct iio_context* ctx, M2kAnalogIn* analogIn,
 				       M2kAnalogOut* analogOut):
 	m_cancel(false),
@@ -207,12 +216,13 @@ bool M2kCalibrationImpl::calibrateADCoffset()
 	bool calibrated = false;
 	double voltage0 = 0;
 	double voltage1 = 0;
-	std::vector<std::vector<double>> ch_data = {};
+	double avg0, avg1;
 
 	if (!m_initialized) {
 		return false;
 	}
 
+	auto start = std::chrono::steady_clock::now();
 	// Ground ADC inputs
 	setCalibrationMode(ADC_GND);
 
@@ -221,20 +231,15 @@ bool M2kCalibrationImpl::calibrateADCoffset()
 	m_m2k_adc->setVerticalOffset(static_cast<ANALOG_IN_CHANNEL>(1), 0);
 	m_m2k_adc->setAdcCalibOffset(static_cast<ANALOG_IN_CHANNEL>(1), 2048);
 
-
-	// Allow some time for the voltage to settle
-	std::this_thread::sleep_for(std::chrono::milliseconds(50));
-
-	const unsigned int num_samples = 100000u;
-	ch_data = m_m2k_adc->getSamplesRaw(num_samples);
+	bool ok = readSettledAverages(avg0, avg1);
 	m_m2k_adc->stopAcquisition();
 
-	if (ch_data.size() == 0) {
+	if (!ok) {
 		return false;
 	}
 
-	int16_t ch0_avg = static_cast<int16_t>(Utils::average(ch_data.at(0).data(), num_samples));
-	int16_t ch1_avg = static_cast<int16_t>(Utils::average(ch_data.at(1).data(), num_samples));
+	int16_t ch0_avg = static_cast<int16_t>(avg0);
+	int16_t ch1_avg = static_cast<int16_t>(avg1);
 
 	// Convert from raw format to signed raw
 	int16_t tmp;
@@ -249,12 +254,12 @@ bool M2kCalibrationImpl::calibrateADCoffset()
 
 	m_adc_ch0_offset = (int)(2048 - ((voltage0 * 4096 * gain) / range));
 	m_adc_ch1_offset = (int)(2048 - ((voltage1 * 4096 * gain) / range));
+	recordTiming("adc_offset", start);
 
-	fine_tune(20, m_adc_ch0_offset, m_adc_ch1_offset, num_samples);
+	start = std::chrono::steady_clock::now();
+	calibrated = fine_tune(20, m_adc_ch0_offset, m_adc_ch1_offset);
+	recordTiming("adc_fine_tune", start);
 
-	calibrated = true;
-
-	ch_data.clear();
 	return calibrated;
 }
 
@@ -262,27 +267,23 @@ bool M2kCalibrationImpl::calibrateADCgain()
 {
 	int16_t tmp;
 	double vref1 = 0.46172;
-	const unsigned int num_samples = 150000u;
 	double avg0, avg1;
 	bool calibrated = false;
-	std::vector<std::vector<double>> ch_data = {};
 
 	if (!m_initialized) {
 		return false;
 	}
 
+	auto start = std::chrono::steady_clock::now();
 	setCalibrationMode(ADC_REF1);
 
-	ch_data = m_m2k_adc->getSamplesRaw(num_samples);
+	bool ok = readSettledAverages(avg0, avg1);
 	m_m2k_adc->stopAcquisition();
 
-	if (ch_data.size() == 0) {
+	if (!ok) {
 		return false;
 	}
 
-	avg0 = Utils::average(ch_data.at(0).data(), num_samples);
-	avg1 = Utils::average(ch_data.at(1).data(), num_samples);
-
 	tmp = static_cast<int16_t>(avg0);
 	m_m2k_adc->convertChannelHostFormat(ANALOG_IN_CHANNEL_1, &avg0, &tmp);
 	tmp = static_cast<int16_t >(avg1);
@@ -297,8 +298,8 @@ bool M2kCalibrationImpl::calibrateADCgain()
 	setCalibrationMode(NONE);
 
 	calibrated = true;
+	recordTiming("adc_gain", start);
 
-	ch_data.clear();
 	return calibrated;
 }
 
@@ -363,6 +364,21 @@ void M2kCalibrationImpl::setAdcGain(unsigned int chn, double gain)
 	}
 }
 
+void M2kCalibrationImpl::updateCalibrationParameters(const CALIBRATION_PARAMETERS &parameters)
+{
+	/* Unlike setAdcOffset, the two argument setAdcCalibOffset keeps the vertical offset */
+	m_adc_ch0_offset = parameters.adc_offset_ch_1;
+	m_adc_ch1_offset = parameters.adc_offset_ch_2;
+	m_m2k_adc->setAdcCalibOffset(ANALOG_IN_CHANNEL_1, m_adc_ch0_offset);
+	m_m2k_adc->setAdcCalibOffset(ANALOG_IN_CHANNEL_2, m_adc_ch1_offset);
+	setAdcGain(0, parameters.adc_gain_ch_1);
+	setAdcGain(1, parameters.adc_gain_ch_2);
+	setDacOffset(0, parameters.dac_a_offset);
+	setDacOffset(1, parameters.dac_b_offset);
+	setDacGain(0, parameters.dac_a_gain);
+	setDacGain(1, parameters.dac_b_gain);
+}
+
 bool M2kCalibrationImpl::getAdcCalibrated() const
 {
 	return m_adc_calibrated;
@@ -424,92 +440,150 @@ bool M2kCalibrationImpl::resetCalibration()
 	return true;
 }
 
-bool M2kCalibrationImpl::fine_tune(size_t span, int16_t centerVal0, int16_t centerVal1,
-				   size_t num_samples)
-{
-	int16_t *candidateOffsets0 = new int16_t[span + 1];
-	int16_t *candidateOffsets1 = new int16_t[span + 1];
-	double *averagesCh0 = new double[span + 1];
-	double *averagesCh1 = new double[span + 1];
-	double minAvg0, minAvg1;
-	std::vector<std::vector<double>> ch_data = {};
-	int16_t offset0, offset1;
-	unsigned int i, i0 = 0, i1 = 0;
-	bool ret = true;
-
-	offset0 = centerVal0 - static_cast<int16_t>(span) / 2;
-	offset1 = centerVal1 - static_cast<int16_t>(span) / 2;
-	candidateOffsets0[0] = offset0;
-	candidateOffsets1[0] = offset1;
-	m_m2k_adc->setAdcCalibOffset(static_cast<ANALOG_IN_CHANNEL>(0), offset0);
-	m_m2k_adc->setAdcCalibOffset(static_cast<ANALOG_IN_CHANNEL>(1), offset1);
-	offset0++;
-	offset1++;
-
-	std::this_thread::sleep_for(std::chrono::milliseconds(5));
-	m_m2k_adc->startAcquisition(num_samples);
-
-	for (i = 0; i < span + 1; i++) {
-		if (i < span) {
-			candidateOffsets0[i + 1] = offset0;
-			candidateOffsets1[i + 1] = offset1;
+void M2kCalibrationImpl::rawAverages(unsigned int num_samples, double &avg0, double &avg1)
+{
+	/* Reduce the interleaved raw buffer directly; both channels are enabled in calibration mode */
+	const short *raw = m_m2k_adc->getSamplesRawInterleaved(num_samples);
+	int64_t sum0 = 0;
+	int64_t sum1 = 0;
+	for (unsigned int i = 0; i < num_samples; i++) {
+		sum0 += raw[2 * i];
+		sum1 += raw[2 * i + 1];
+	}
+	avg0 = static_cast<double>(sum0) / num_samples;
+	avg1 = static_cast<double>(sum1) / num_samples;
+}
+
+bool M2kCalibrationImpl::readSettledAverages(double &avg0, double &avg1)
+{
+	/* With a single kernel buffer the first capture may predate the last change,
+	 * so it is dropped. Then capture until two consecutive averages agree. */
+	double prev0, prev1;
+	auto deadline = std::chrono::steady_clock::now() + CALIB_SETTLE_TIMEOUT;
+
+	rawAverages(CALIB_BLOCK_SAMPLES, prev0, prev1);
+	rawAverages(CALIB_BLOCK_SAMPLES, prev0, prev1);
+	while (true) {
+		if (m_cancel) {
+			return false;
 		}
-		m_m2k_adc->setAdcCalibOffset(static_cast<ANALOG_IN_CHANNEL>(0), offset0);
-		m_m2k_adc->setAdcCalibOffset(static_cast<ANALOG_IN_CHANNEL>(1), offset1);
-		offset0++;
-		offset1++;
-
-		// Allow some time for the voltage to settle
-		std::this_thread::sleep_for(std::chrono::milliseconds(5));
-
-		/* Do not be confused by the position of this getSamples.
-		* This will get data configured by the previous "setAdcCalibOffset",
-		* not by the latest one.
-		* This helps to reduce the calibration time by aprox. 1s, by not stopping
-		* to clean the buffer after each acquisition.
-		* Once we run "getSamplesRaw" and read data from the buffer, it will
-		* be refilled instantly using the latest offset written on the board.
-		* */
-		ch_data = m_m2k_adc->getSamplesRaw(num_samples);
-
-		if (ch_data.size() == 0) {
-			goto out_cleanup;
+		rawAverages(CALIB_BLOCK_SAMPLES, avg0, avg1);
+		bool settled = std::abs(avg0 - prev0) <= CALIB_SETTLE_TOLERANCE &&
+				std::abs(avg1 - prev1) <= CALIB_SETTLE_TOLERANCE;
+		if (settled || std::chrono::steady_clock::now() >= deadline) {
+			avg0 = (avg0 + prev0) / 2;
+			avg1 = (avg1 + prev1) / 2;
+			return true;
 		}
+		prev0 = avg0;
+		prev1 = avg1;
+	}
+}
 
-		averagesCh0[i] = std::abs(Utils::average(ch_data.at(0).data(), num_samples));
-		averagesCh1[i] = std::abs(Utils::average(ch_data.at(1).data(), num_samples));
+bool M2kCalibrationImpl::fine_tune(size_t span, int16_t centerVal0, int16_t centerVal1)
+{
+	/* The average of a grounded input moves monotonically with the calibration offset,
+	 * so its zero crossing is searched inside [center - span / 2, center + span / 2]
+	 * with the secant method, falling back to bisection when one end of the bracket
+	 * does not move. Both channels are searched at once, each capture measuring the
+	 * next candidate of both. */
+	struct offset_search {
+		int lo, hi;
+		double avg_lo, avg_hi;
+		int candidate;
+		int kept_side;
+		bool done;
+	};
+	offset_search search[2];
+	int16_t center[2] = {centerVal0, centerVal1};
+	double avg[2];
+
+	for (unsigned int ch = 0; ch < 2; ch++) {
+		search[ch].lo = center[ch] - static_cast<int>(span) / 2;
+		search[ch].hi = search[ch].lo + static_cast<int>(span);
+		search[ch].kept_side = 0;
+		search[ch].done = false;
 	}
 
-	m_m2k_adc->stopAcquisition();
+	auto measure = [&](int offset0, int offset1) {
+		m_m2k_adc->setAdcCalibOffset(static_cast<ANALOG_IN_CHANNEL>(0), offset0);
+		m_m2k_adc->setAdcCalibOffset(static_cast<ANALOG_IN_CHANNEL>(1), offset1);
+		return readSettledAverages(avg[0], avg[1]);
+	};
+
+	// Both ends of the bracket
+	if (!measure(search[0].lo, search[1].lo)) {
+		m_m2k_adc->stopAcquisition();
+		return false;
+	}
+	for (unsigned int ch = 0; ch < 2; ch++) {
+		search[ch].avg_lo = avg[ch];
+	}
+	if (!measure(search[0].hi, search[1].hi)) {
+		m_m2k_adc->stopAcquisition();
+		return false;
+	}
+	for (unsigned int ch = 0; ch < 2; ch++) {
+		search[ch].avg_hi = avg[ch];
+		// no zero crossing inside the span, the closest end is the best candidate
+		if ((search[ch].avg_lo < 0) == (search[ch].avg_hi < 0)) {
+			search[ch].done = true;
+		}
+	}
 
-	minAvg0 = std::abs(averagesCh0[0]);
-	minAvg1 = std::abs(averagesCh1[0]);
+	while (!search[0].done || !search[1].done) {
+		for (unsigned int ch = 0; ch < 2; ch++) {
+			offset_search &s = search[ch];
+			if (s.done) {
+				s.candidate = (std::abs(s.avg_lo) <= std::abs(s.avg_hi)) ? s.lo : s.hi;
+				continue;
+			}
+			int next;
+			if (s.kept_side >= 2 || s.kept_side <= -2) {
+				next = (s.lo + s.hi) / 2;
+			} else {
+				next = static_cast<int>(std::lround(s.lo - s.avg_lo * (s.hi - s.lo) / (s.avg_hi - s.avg_lo)));
+			}
+			s.candidate = std::min(std::max(next, s.lo + 1), s.hi - 1);
+		}
 
-	for (unsigned int i = 1; i < span + 1; i++) {
-		if (averagesCh0[i] < minAvg0) {
-			minAvg0 = averagesCh0[i];
-			i0 = i;
+		if (!measure(search[0].candidate, search[1].candidate)) {
+			m_m2k_adc->stopAcquisition();
+			return false;
 		}
-		if (averagesCh1[i] < minAvg1) {
-			minAvg1 = averagesCh1[i];
-			i1 = i;
+
+		for (unsigned int ch = 0; ch < 2; ch++) {
+			offset_search &s = search[ch];
+			if (s.done) {
+				continue;
+			}
+			if ((avg[ch] < 0) == (s.avg_lo < 0)) {
+				s.lo = s.candidate;
+				s.avg_lo = avg[ch];
+				// the upper end was kept once more
+				s.kept_side = (s.kept_side > 0) ? s.kept_side + 1 : 1;
+			} else {
+				s.hi = s.candidate;
+				s.avg_hi = avg[ch];
+				s.kept_side = (s.kept_side < 0) ? s.kept_side - 1 : -1;
+			}
+			if (s.hi - s.lo <= 1) {
+				s.done = true;
+			}
 		}
 	}
 
+	m_m2k_adc->stopAcquisition();
+
 	setCalibrationMode(NONE);
 
-	m_adc_ch0_offset = candidateOffsets0[i0];
-	m_adc_ch1_offset = candidateOffsets1[i1];
+	m_adc_ch0_offset = (std::abs(search[0].avg_lo) <= std::abs(search[0].avg_hi)) ? search[0].lo : search[0].hi;
+	m_adc_ch1_offset = (std::abs(search[1].avg_lo) <= std::abs(search[1].avg_hi)) ? search[1].lo : search[1].hi;
 
 	m_m2k_adc->setAdcCalibOffset(static_cast<ANALOG_IN_CHANNEL>(0), m_adc_ch0_offset);
 	m_m2k_adc->setAdcCalibOffset(static_cast<ANALOG_IN_CHANNEL>(1), m_adc_ch1_offset);
 
-out_cleanup:
-	delete[] candidateOffsets0;
-	delete[] candidateOffsets1;
-	delete[] averagesCh0;
-	delete[] averagesCh1;
-	return ret;
+	return true;
 }
 
 int M2kCalibrationImpl::getDacOffset(unsigned int channel)
@@ -575,13 +649,13 @@ bool M2kCalibrationImpl::calibrateDACoffset()
 {
 	int16_t tmp;
 	bool calibrated = false;
-	const unsigned int num_samples = 100000u;
-	std::vector<std::vector<double>> ch_data = {};
+	double avg0, avg1;
 
 	if (!m_initialized) {
 		return false;
 	}
 
+	auto start = std::chrono::steady_clock::now();
 	// connect ADC to DAC
 	setCalibrationMode(DAC);
 
@@ -609,18 +683,15 @@ bool M2kCalibrationImpl::calibrateDACoffset()
 	m_m2k_fabric->setBoolValue(0, false, "powerdown", true);
 	m_m2k_fabric->setBoolValue(1, false, "powerdown", true);
 
-	// Allow some time for the voltage to settle
-	std::this_thread::sleep_for(std::chrono::milliseconds(50));
-
-	ch_data = m_m2k_adc->getSamplesRaw(num_samples);
+	bool ok = readSettledAverages(avg0, avg1);
 	m_m2k_adc->stopAcquisition();
 
-	if (ch_data.size() == 0) {
+	if (!ok) {
 		return false;
 	}
 
-	int16_t ch0_avg = static_cast<int16_t>(Utils::average(ch_data.at(0).data(), num_samples));
-	int16_t ch1_avg = static_cast<int16_t>(Utils::average(ch_data.at(1).data(), num_samples));
+	int16_t ch0_avg = static_cast<int16_t>(avg0);
+	int16_t ch1_avg = static_cast<int16_t>(avg1);
 
 	tmp = ch0_avg;
 	m_m2k_adc->convertChannelHostFormat(ANALOG_IN_CHANNEL_1, &ch0_avg, &tmp);
@@ -645,8 +716,8 @@ bool M2kCalibrationImpl::calibrateDACoffset()
 	setCalibrationMode(NONE);
 
 	calibrated = true;
+	recordTiming("dac_offset", start);
 
-	ch_data.clear();
 	return calibrated;
 }
 
@@ -654,8 +725,9 @@ bool M2kCalibrationImpl::calibrateDACgain()
 {
 	int16_t tmp;
 	bool calibrated = false;
-	std::vector<std::vector<double>> ch_data = {};
+	double avg0, avg1;
 
+	auto start = std::chrono::steady_clock::now();
 	// connect ADC to DAC
 	setCalibrationMode(DAC);
 
@@ -679,19 +751,15 @@ bool M2kCalibrationImpl::calibrateDACgain()
 	m_m2k_fabric->setBoolValue(0, false, "powerdown", true);
 	m_m2k_fabric->setBoolValue(1, false, "powerdown", true);
 
-	// Allow some time for the voltage to settle
-	std::this_thread::sleep_for(std::chrono::milliseconds(50));
-
-	const unsigned int num_samples = 150000u;
-	ch_data = m_m2k_adc->getSamplesRaw(num_samples);
+	bool ok = readSettledAverages(avg0, avg1);
 	m_m2k_adc->stopAcquisition();
 
-	if (ch_data.size() == 0) {
+	if (!ok) {
 		return false;
 	}
 
-	int16_t ch0_avg = static_cast<int16_t>(Utils::average(ch_data.at(0).data(), num_samples));
-	int16_t ch1_avg = static_cast<int16_t>(Utils::average(ch_data.at(1).data(), num_samples));
+	int16_t ch0_avg = static_cast<int16_t>(avg0);
+	int16_t ch1_avg = static_cast<int16_t>(avg1);
 
 	tmp = ch0_avg;
 	m_m2k_adc->convertChannelHostFormat(ANALOG_IN_CHANNEL_1, &ch0_avg, &tmp);
@@ -717,12 +785,21 @@ bool M2kCalibrationImpl::calibrateDACgain()
 	setCalibrationMode(NONE);
 
 	calibrated = true;
+	recordTiming("dac_gain", start);
 
-	ch_data.clear();
 	return calibrated;
 }
 
 bool M2kCalibrationImpl::calibrateADC()
+{
+	m_timings.clear();
+	auto start = std::chrono::steady_clock::now();
+	bool ok = runAdcCalibration();
+	recordTiming("total", start);
+	return ok;
+}
+
+bool M2kCalibrationImpl::runAdcCalibration()
 {
 	bool ok;
 	if (!m_initialized) {
@@ -755,19 +832,32 @@ calibration_fail:
 
 bool M2kCalibrationImpl::calibrateDAC()
 {
-	bool ok;
+	m_timings.clear();
+	auto start = std::chrono::steady_clock::now();
 	if (!m_initialized) {
 		initialize();
 	}
 
 	if (!m_adc_calibrated) {
-		calibrateADC();
+		runAdcCalibration();
 	}
+
+	auto setup_start = std::chrono::steady_clock::now();
 	setDacInCalibMode();
+	configDacSamplerate();
+	recordTiming("dac_setup", setup_start);
+
+	bool ok = runDacCalibration();
+	recordTiming("total", start);
+	return ok;
+}
+
+bool M2kCalibrationImpl::runDacCalibration()
+{
+	bool ok;
 	setAdcInCalibMode();
 
 	configAdcSamplerate();
-	configDacSamplerate();
 
 	ok = calibrateDACoffset();
 
@@ -796,31 +886,49 @@ calibration_fail:
 
 bool M2kCalibrationImpl::calibrateAll()
 {
-	bool ok;
+	bool ok_adc, ok_dac;
+	m_timings.clear();
+	auto start = std::chrono::steady_clock::now();
 	initialize();
 
-	ok = calibrateADC();
+	/* The DAC is set up first, on this thread: libiio does not promise that
+	 * one context may be used from several threads at once */
+	auto setup_start = std::chrono::steady_clock::now();
+	setDacInCalibMode();
+	configDacSamplerate();
+	recordTiming("dac_setup", setup_start);
 
-	if (!ok || m_cancel) {
-		goto calibration_fail;
+	ok_adc = runAdcCalibration();
+	auto adc_end = std::chrono::steady_clock::now();
+
+	if (!ok_adc || m_cancel) {
+		restoreDacFromCalibMode();
+		m_cancel = false;
+		recordTiming("total", start);
+		return false;
 	}
 
+	/* The DAC calibration waits 750 ms after the end of the ADC calibration */
 	if (Utils::getHardwareRevision(m_ctx) != "A") {
-		std::this_thread::sleep_for
-				(std::chrono::milliseconds(750));
+		std::this_thread::sleep_until(adc_end + std::chrono::milliseconds(750));
 	}
 
-	ok = calibrateDAC();
+	ok_dac = runDacCalibration();
 
-	if (!ok || m_cancel) {
-		goto calibration_fail;
-	}
+	recordTiming("total", start);
+	return ok_adc && ok_dac;
+}
 
-	return true;
+std::vector<CALIBRATION_TIMING> M2kCalibrationImpl::getCalibrationTimings() const
+{
+	return m_timings;
+}
 
-calibration_fail:
-	m_cancel=false;
-	return false;
+void M2kCalibrationImpl::recordTiming(const std::string &phase, std::chrono::steady_clock::time_point start)
+{
+	double duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	m_timings.push_back({phase, duration});
+	LIBM2K_LOG(INFO, "Calibration phase " + phase + ": " + std::to_string(duration) + " ms");
 }
 
 void M2kCalibrationImpl::cancelCalibration()
@@ -27,6 +27,7 @@
 #include <libm2k/m2khardwaretrigger.hpp>
 #include "analog/m2kanalogin_impl.hpp"
 #include "analog/m2kanalogout_impl.hpp"
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <string>
@@ -74,10 +75,13 @@ public:
 	void setDacOffset(unsigned int chn, int offset);
 	void setAdcOffset(unsigned int chn, int offset);
 	void setAdcGain(unsigned int chn, double gain);
+	void updateCalibrationParameters(const CALIBRATION_PARAMETERS &parameters);
 
 	bool getAdcCalibrated() const override;
 	bool getDacCalibrated() const override;
 
+	std::vector<CALIBRATION_TIMING> getCalibrationTimings() const override;
+
 private:
 	bool m_cancel;
 
@@ -119,12 +123,18 @@ private:
 	std::vector<bool> m_adc_channels_enabled;
 	std::vector<bool> m_dac_channels_enabled;
 	double m_dac_default_vlsb;
+	std::vector<CALIBRATION_TIMING> m_timings;
 
 	std::shared_ptr<libm2k::utils::DeviceGeneric> m_ad5625_dev;
 	std::shared_ptr<libm2k::utils::DeviceGeneric> m_m2k_fabric;
 	void configAdcSamplerate();
 	void configDacSamplerate();
-	bool fine_tune(size_t span, int16_t centerVal0, int16_t centerVal1, size_t num_samples);
+	bool runAdcCalibration();
+	bool runDacCalibration();
+	void rawAverages(unsigned int num_samples, double &avg0, double &avg1);
+	bool readSettledAverages(double &avg0, double &avg1);
+	bool fine_tune(size_t span, int16_t centerVal0, int16_t centerVal1);
+	void recordTiming(const std::string &phase, std::chrono::steady_clock::time_point start);
 	int16_t processRawSample(int16_t value);
 };
 
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "asyncworker.hpp"
+
+using namespace libm2k;
+using namespace libm2k::utils;
+
+AsyncWorker::AsyncWorker() :
+	m_stop(false)
+{
+}
+
+AsyncWorker::~AsyncWorker()
+{
+	stop();
+}
+
+void AsyncWorker::post(std::function<void(bool)> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		if (!m_stop) {
+			m_tasks.push_back(task);
+			if (!m_thread.joinable()) {
+				m_thread = std::thread(&AsyncWorker::loop, this);
+			}
+			m_cond.notify_one();
+			return;
+		}
+	}
+	task(true);
+}
+
+AsyncOperation AsyncWorker::run(std::function<void()> fn)
+{
+	AsyncOperation operation;
+	post([=](bool cancelled) mutable {
+		if (cancelled) {
+			operation.setFinished(cancelledError());
+			return;
+		}
+		__try {
+			fn();
+			operation.setFinished();
+		} __catch (...) {
+			operation.setFinished(std::current_exception());
+		}
+	});
+	return operation;
+}
+
+void AsyncWorker::stop()
+{
+	std::deque<std::function<void(bool)>> dropped;
+	std::thread thread;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stop = true;
+		dropped.swap(m_tasks);
+		thread.swap(m_thread);
+		m_cond.notify_one();
+	}
+	for (auto &task : dropped) {
+		task(true);
+	}
+	if (thread.joinable()) {
+		if (thread.get_id() == std::this_thread::get_id()) {
+			// stopped from one of its own tasks, the loop exits once the task returns
+			thread.detach();
+		} else {
+			thread.join();
+		}
+	}
+}
+
+std::exception_ptr AsyncWorker::cancelledError()
+{
+	return std::make_exception_ptr(m2k_exception::make("Asynchronous operation cancelled")
+				       .type(libm2k::EXC_RUNTIME_ERROR).build());
+}
+
+void AsyncWorker::loop()
+{
+	while (true) {
+		std::function<void(bool)> task;
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			m_cond.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+			if (m_tasks.empty()) {
+				return;
+			}
+			task = m_tasks.front();
+			m_tasks.pop_front();
+		}
+		task(false);
+	}
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ASYNCWORKER_HPP
+#define ASYNCWORKER_HPP
+
+#include <libm2k/asyncresult.hpp>
+#include <libm2k/m2kexceptions.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace libm2k {
+namespace utils {
+
+/*
+ * Single background thread which runs the asynchronous operations of one device
+ * in the order they were requested. The thread is started by the first request.
+ */
+class AsyncWorker
+{
+public:
+	AsyncWorker();
+	~AsyncWorker();
+
+	/* The task receives true if it was dropped because the worker stopped */
+	void post(std::function<void(bool cancelled)> task);
+
+	template <typename T>
+	AsyncResult<T> run(std::function<T()> fn)
+	{
+		AsyncResult<T> result;
+		post([=](bool cancelled) mutable {
+			if (cancelled) {
+				result.setFinished(cancelledError());
+				return;
+			}
+			__try {
+				result.setValue(fn());
+			} __catch (...) {
+				result.setFinished(std::current_exception());
+			}
+		});
+		return result;
+	}
+
+	AsyncOperation run(std::function<void()> fn);
+
+	/* Drop the pending operations and wait for the running one to return */
+	void stop();
+
+	static std::exception_ptr cancelledError();
+private:
+	void loop();
+
+	std::mutex m_lock;
+	std::condition_variable m_cond;
+	std::deque<std::function<void(bool)>> m_tasks;
+	std::thread m_thread;
+	bool m_stop;
+};
+
+/*
+ * Gives back the slot held by a background operation when it goes out of scope: the token is
+ * set to released if it still holds value. Used inside the task, the slot is free before the
+ * operation is reported as finished, unlike with an onComplete() callback.
+ */
+template <typename T>
+class AsyncTokenRelease
+{
+public:
+	AsyncTokenRelease(std::atomic<T> &token, T value, T released) :
+		m_token(token), m_value(value), m_released(released) {}
+
+	~AsyncTokenRelease()
+	{
+		T expected = m_value;
+		m_token.compare_exchange_strong(expected, m_released);
+	}
+private:
+	AsyncTokenRelease(const AsyncTokenRelease &);
+	AsyncTokenRelease &operator=(const AsyncTokenRelease &);
+
+	std::atomic<T> &m_token;
+	T m_value;
+	T m_released;
+};
+}
+}
+
+#endif //ASYNCWORKER_HPP
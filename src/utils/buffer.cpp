@@ -21,6 +21,8 @@
 
 #include "buffer.hpp"
 #include "channel.hpp"
+#include "trace.hpp"
+#include "metrics.hpp"
 #include <libm2k/m2kexceptions.hpp>
 #include <libm2k/logger.hpp>
 #include <libm2k/utils/utils.hpp>
@@ -28,10 +30,19 @@
 #include <iostream>
 #include <memory>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 
 using namespace std;
 using namespace libm2k::utils;
 
+namespace {
+/* DMA status register of the ADI AXI converter cores, reached through the register window
+ * of the DMA core; the overflow flag is sticky and cleared by writing it back */
+const uint32_t ADI_REG_DMA_STATUS = 0x80000088;
+const uint32_t ADI_DMA_OVERFLOW = 1u << 2;
+}
+
 Buffer::Buffer(struct iio_device *dev) {
 	m_dev = dev;
 
@@ -40,6 +51,12 @@ Buffer::Buffer(struct iio_device *dev) {
 		THROW_M2K_EXCEPTION("Buffer: Device not found, so no buffer can be created", libm2k::EXC_INVALID_PARAMETER);
 	}
 	m_dev_name = iio_device_get_name(m_dev);
+	m_trace_name = trace::intern(m_dev_name ? m_dev_name : "");
+	const std::string metric_device = m_dev_name ? m_dev_name : "";
+	m_metric_create = metrics::get("buffer_create", metric_device);
+	m_metric_refill = metrics::get("buffer_refill", metric_device);
+	m_metric_push = metrics::get("buffer_push", metric_device);
+	m_metric_conversion = metrics::get("conversion", metric_device);
 
 	unsigned int dev_count = iio_device_get_buffer_attrs_count(m_dev);
 	if (dev_count <= 0) {
@@ -47,6 +64,12 @@ Buffer::Buffer(struct iio_device *dev) {
 	}
 	m_buffer = nullptr;
 	m_last_nb_samples = 0;
+	m_last_block = libm2k::STREAM_BLOCK_INFO();
+	m_next_sequence = 0;
+	m_next_sample = 0;
+	m_gap_count = 0;
+	m_restarted = false;
+	m_overflow_detection = false;
 }
 
 Buffer::~Buffer() {
@@ -74,7 +97,11 @@ void Buffer::initializeBuffer(unsigned int size, bool cyclic, bool output, bool
 		destroy();
 
 		m_last_nb_samples = size;
-		m_buffer = iio_device_create_buffer(m_dev, size, cyclic);
+		{
+			metrics::Timer timer(m_metric_create);
+			m_buffer = iio_device_create_buffer(m_dev, size, cyclic);
+			timer.setError(!m_buffer);
+		}
 		if (!m_buffer) {
 			if (output) {
 				if (errno == ETIMEDOUT) {
@@ -95,6 +122,19 @@ void Buffer::initializeBuffer(unsigned int size, bool cyclic, bool output, bool
                 }
             }
         }
+		if (!output) {
+			bool overflow_detection;
+			{
+				std::lock_guard<std::mutex> lock(m_stream_lock);
+				m_restarted = true;
+				overflow_detection = m_overflow_detection;
+			}
+			if (overflow_detection) {
+				/* a flag raised before this buffer existed concerns no block of it */
+				bool overflow;
+				readOverflow(overflow);
+			}
+		}
                 LIBM2K_LOG(INFO, libm2k::buildLoggingMessage({m_dev_name}, std::string((output ? "TX" : "RX")) + " buffer created (" + std::to_string(size) +
                                                                       " samples)"));
 		LIBM2K_LOG_IF(WARNING, size % 4 != 0 || size < 16,
@@ -105,6 +145,36 @@ void Buffer::initializeBuffer(unsigned int size, bool cyclic, bool output, bool
 	}
 }
 
+void Buffer::fillAndPush(unsigned int nb_samples, bool cyclic,
+			 const std::function<void(unsigned short *data, unsigned int nb_samples)> &fill)
+{
+	if (Utils::getIioDeviceDirection(m_dev) != OUTPUT) {
+		THROW_M2K_EXCEPTION("Device not output buffer capable, so no buffer was created", libm2k::EXC_INVALID_PARAMETER);
+	}
+	if (nb_samples == 0) {
+		return;
+	}
+
+	initializeBuffer(nb_samples, cyclic, true);
+
+	size_t size = ((char *)iio_buffer_end(m_buffer) - (char *)iio_buffer_start(m_buffer)) / sizeof(unsigned short);
+	if (size < nb_samples) {
+		THROW_M2K_EXCEPTION("Buffer: The TX buffer does not hold multiplexed 16-bit samples", libm2k::EXC_INVALID_PARAMETER);
+	}
+	fill((unsigned short *)iio_buffer_start(m_buffer), nb_samples);
+
+	ssize_t ret = pushBuffer();
+	if (ret < 0) {
+		destroy();
+		// timeout error code
+		if (ret == -ETIMEDOUT) {
+			THROW_M2K_EXCEPTION("Buffer: Push timeout occurred", libm2k::EXC_TIMEOUT, ret);
+		}
+		THROW_M2K_EXCEPTION("Buffer: Cannot push TX buffer", libm2k::EXC_RUNTIME_ERROR, ret);
+	}
+	LIBM2K_LOG(INFO, libm2k::buildLoggingMessage({m_dev_name}, "Buffer pushed"));
+}
+
 void Buffer::setChannels(std::vector<Channel*> channels)
 {
 	//if (m_buffer) //this means the output is running, should we change the channels now?
@@ -134,16 +204,11 @@ void Buffer::push(unsigned short *data, unsigned int channel, unsigned int nb_sa
 		if (!multiplex) {
 			m_channel_list.at(channel)->write(m_buffer, data, nb_samples);
 		} else {
-			short *p_dat;
-			int i = 0;
-
-			for (p_dat = (short *)iio_buffer_start(m_buffer); (p_dat < iio_buffer_end(m_buffer));
-			     (unsigned short*)p_dat++, i++) {
-				*p_dat = data[i];
-			}
+			memcpy(iio_buffer_start(m_buffer), data,
+			       (char *)iio_buffer_end(m_buffer) - (char *)iio_buffer_start(m_buffer));
 
 		}
-		ssize_t ret = iio_buffer_push(m_buffer);
+		ssize_t ret = pushBuffer();
 		if (ret < 0) {
 			destroy();
 			// timeout error code
@@ -189,7 +254,7 @@ void Buffer::push(std::vector<short> const &data, unsigned int channel,
 			}
 
 		}
-		ssize_t ret = iio_buffer_push(m_buffer);
+		ssize_t ret = pushBuffer();
 		if (ret < 0) {
 			destroy();
 			// timeout error code
@@ -225,16 +290,11 @@ void Buffer::push(std::vector<unsigned short> const &data, unsigned int channel,
 		if (!multiplex) {
 			m_channel_list.at(channel)->write(m_buffer, data);
 		} else {
-			unsigned short *p_dat;
-			int i = 0;
-
-			for (p_dat = (unsigned short *)iio_buffer_start(m_buffer); (p_dat < iio_buffer_end(m_buffer));
-			     (unsigned short*)p_dat++, i++) {
-				*p_dat = data[i];
-			}
+			memcpy(iio_buffer_start(m_buffer), data.data(),
+			       (char *)iio_buffer_end(m_buffer) - (char *)iio_buffer_start(m_buffer));
 
 		}
-		ssize_t ret = iio_buffer_push(m_buffer);
+		ssize_t ret = pushBuffer();
 		if (ret < 0) {
 			destroy();
 			// timeout error code
@@ -268,7 +328,7 @@ void Buffer::push(std::vector<double> const &data, unsigned int channel, bool cy
 
 	if (channel < m_channel_list.size() ) {
 		m_channel_list.at(channel)->write(m_buffer, data);
-		ssize_t ret = iio_buffer_push(m_buffer);
+		ssize_t ret = pushBuffer();
 		if (ret < 0) {
 			destroy();
 			// timeout error code
@@ -313,7 +373,7 @@ void Buffer::push(double *data, unsigned int channel, unsigned int nb_samples, b
 
 	if (channel < m_channel_list.size() ) {
 		m_channel_list.at(channel)->write(m_buffer, data, nb_samples);
-		ssize_t ret = iio_buffer_push(m_buffer);
+		ssize_t ret = pushBuffer();
 		if (ret < 0) {
 			destroy();
 			// timeout error code
@@ -345,7 +405,7 @@ void Buffer::push(short *data, unsigned int channel, unsigned int nb_samples, bo
 
 	if (channel < m_channel_list.size() ) {
 		m_channel_list.at(channel)->write(m_buffer, data, nb_samples);
-		ssize_t ret = iio_buffer_push(m_buffer);
+		ssize_t ret = pushBuffer();
 		if (ret < 0) {
 			destroy();
 			// timeout error code
@@ -370,7 +430,7 @@ void Buffer::getSamples(std::vector<unsigned short> &data, unsigned int nb_sampl
 
 	initializeBuffer(nb_samples, false, false);
 
-	ssize_t ret = iio_buffer_refill(m_buffer);
+	ssize_t ret = refillBuffer();
 
 
 	if (ret < 0) {
@@ -405,7 +465,7 @@ const unsigned short* Buffer::getSamplesP(unsigned int nb_samples)
 
 	initializeBuffer(nb_samples, false, false);
 
-	ssize_t ret = iio_buffer_refill(m_buffer);
+	ssize_t ret = refillBuffer();
 
 
 	if (ret < 0) {
@@ -442,7 +502,7 @@ void Buffer::getSamples(std::vector<std::vector<double>> &data, unsigned int nb_
 
 	unsigned int i;
 	unsigned int nb_channels = m_channel_list.size();
-
+	metrics::Timer timer(m_metric_conversion, (uint64_t)nb_samples * nb_channels * sizeof(short));
 
 	for (i = 0; i < nb_samples; i++) {
 		for (unsigned int ch = 0; ch < nb_channels; ch++) {
@@ -486,7 +546,7 @@ void* Buffer::getSamplesRawInterleavedVoid(unsigned int nb_samples)
 
 	initializeBuffer(nb_samples, false, false);
 
-	ssize_t ret = iio_buffer_refill(m_buffer);
+	ssize_t ret = refillBuffer();
 	if (ret < 0) {
 		destroy();
 		// timeout error code
@@ -517,6 +577,7 @@ const double* Buffer::getSamplesInterleaved(unsigned int nb_samples,
 	double *data_p_d = new double[nb_samples * channels_enabled.size()];
 	unsigned int i;
 	unsigned int i_d = 0;
+	metrics::Timer timer(m_metric_conversion, (uint64_t)nb_samples * nb_channels * sizeof(short));
 
 	for (i = 0; i < nb_samples; i++) {
 		for (unsigned int ch = 0; ch < nb_channels; ch++) {
@@ -572,6 +633,134 @@ void Buffer::setCyclic(bool enable)
 	m_cyclic = enable;
 }
 
+ssize_t Buffer::pushBuffer()
+{
+	trace::Scope scope(libm2k::TRACE_BUFFER, m_trace_name, "push", m_last_nb_samples);
+	metrics::Timer timer(m_metric_push);
+	ssize_t ret = iio_buffer_push(m_buffer);
+	timer.setBytes(ret > 0 ? ret : 0);
+	timer.setError(ret < 0);
+	return ret;
+}
+
+ssize_t Buffer::refillBuffer()
+{
+	ssize_t ret;
+	{
+		trace::Scope scope(libm2k::TRACE_BUFFER, m_trace_name, "refill", m_last_nb_samples);
+		metrics::Timer timer(m_metric_refill);
+		ret = iio_buffer_refill(m_buffer);
+		timer.setBytes(ret > 0 ? ret : 0);
+		timer.setError(ret < 0);
+	}
+	if (ret >= 0) {
+		updateStreamInfo();
+	}
+	return ret;
+}
+
+void Buffer::updateStreamInfo()
+{
+	const double timestamp = std::chrono::duration<double>(
+				std::chrono::system_clock::now().time_since_epoch()).count();
+	bool overflow = false;
+	if (getOverflowDetection() && readOverflow(overflow) < 0) {
+		LIBM2K_LOG(WARNING, libm2k::buildLoggingMessage({m_dev_name}, "Cannot read the overflow status; detection disabled"));
+		setOverflowDetection(false);
+	}
+
+	std::lock_guard<std::mutex> lock(m_stream_lock);
+	const bool streaming = !m_streaming || m_streaming();
+	m_last_block.sequence = m_next_sequence++;
+	m_last_block.nb_samples = m_last_nb_samples;
+	m_last_block.timestamp = timestamp;
+	m_last_block.restarted = m_restarted;
+	m_last_block.overflow = overflow;
+	m_restarted = false;
+	if (!streaming) {
+		/* Each block waited for its own trigger, the samples in between were not acquired */
+		m_last_block.first_sample = 0;
+		m_last_block.gap = m_last_block.sequence > 0;
+		m_next_sample = m_last_nb_samples;
+		if (m_last_block.gap) {
+			m_gap_count++;
+		}
+		return;
+	}
+	m_last_block.first_sample = m_next_sample;
+	/* The first block after a reset has nothing to follow */
+	m_last_block.gap = overflow || (m_last_block.restarted && m_last_block.sequence > 0);
+	m_next_sample += m_last_nb_samples;
+	if (m_last_block.gap) {
+		m_gap_count++;
+		LIBM2K_LOG(WARNING, libm2k::buildLoggingMessage({m_dev_name}, "Samples lost before block " +
+								std::to_string(m_last_block.sequence)));
+	}
+}
+
+int Buffer::readOverflow(bool &overflow)
+{
+	uint32_t status = 0;
+	overflow = false;
+	int ret = iio_device_reg_read(m_dev, ADI_REG_DMA_STATUS, &status);
+	if (ret < 0) {
+		return ret;
+	}
+	if (status & ADI_DMA_OVERFLOW) {
+		overflow = true;
+		ret = iio_device_reg_write(m_dev, ADI_REG_DMA_STATUS, ADI_DMA_OVERFLOW);
+	}
+	return ret;
+}
+
+libm2k::STREAM_BLOCK_INFO Buffer::getLastBlockInfo()
+{
+	std::lock_guard<std::mutex> lock(m_stream_lock);
+	return m_last_block;
+}
+
+unsigned long long Buffer::getGapCount()
+{
+	std::lock_guard<std::mutex> lock(m_stream_lock);
+	return m_gap_count;
+}
+
+void Buffer::resetStreamInfo()
+{
+	std::lock_guard<std::mutex> lock(m_stream_lock);
+	m_last_block = libm2k::STREAM_BLOCK_INFO();
+	m_next_sequence = 0;
+	m_next_sample = 0;
+	m_gap_count = 0;
+}
+
+void Buffer::setOverflowDetection(bool enable)
+{
+	if (enable) {
+		/* Probe the status register, which also clears a stale flag */
+		bool overflow;
+		int ret = readOverflow(overflow);
+		if (ret < 0) {
+			THROW_M2K_EXCEPTION("Buffer: Device " + std::string(m_dev_name) + " does not report overflows",
+					    libm2k::EXC_INVALID_PARAMETER, ret);
+		}
+	}
+	std::lock_guard<std::mutex> lock(m_stream_lock);
+	m_overflow_detection = enable;
+}
+
+bool Buffer::getOverflowDetection()
+{
+	std::lock_guard<std::mutex> lock(m_stream_lock);
+	return m_overflow_detection;
+}
+
+void Buffer::setStreamingCheck(std::function<bool()> streaming)
+{
+	std::lock_guard<std::mutex> lock(m_stream_lock);
+	m_streaming = streaming;
+}
+
 unsigned int Buffer::getNbSamples() const
 {
 	return m_last_nb_samples;
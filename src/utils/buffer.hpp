@@ -27,11 +27,16 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <mutex>
 #include <libm2k/m2kglobal.hpp>
+#include <libm2k/enums.hpp>
 
 namespace libm2k {
 namespace utils {
 class Channel;
+namespace metrics {
+class Histogram;
+}
 
 class Buffer
 {
@@ -51,6 +56,9 @@ public:
 
 	void push(double *data, unsigned int channel, unsigned int nb_samples, bool cyclic = true, bool enableFlag = false);
 	void push(short *data, unsigned int channel, unsigned int nb_samples, bool cyclic = true, bool enableFlag = false);
+	/* Let fill write the nb_samples multiplexed samples straight into the buffer, then push it */
+	void fillAndPush(unsigned int nb_samples, bool cyclic,
+			 const std::function<void(unsigned short *data, unsigned int nb_samples)> &fill);
 
 	void setChannels(std::vector<Channel*> channels);
 	std::vector<unsigned short> getSamples(unsigned int nb_samples);
@@ -74,17 +82,44 @@ public:
 	unsigned int getNbSamples() const;
 
 	struct iio_buffer* getBuffer();
+
+	libm2k::STREAM_BLOCK_INFO getLastBlockInfo();
+	unsigned long long getGapCount();
+	void resetStreamInfo();
+	void setOverflowDetection(bool enable);
+	bool getOverflowDetection();
+	/* Tells whether the device streams; otherwise every block is a separate triggered capture */
+	void setStreamingCheck(std::function<bool()> streaming);
 private:
 	struct iio_device* m_dev;
 	struct iio_buffer* m_buffer;
 	const char *m_dev_name;
+	const char *m_trace_name;
+	metrics::Histogram *m_metric_create;
+	metrics::Histogram *m_metric_refill;
+	metrics::Histogram *m_metric_push;
+	metrics::Histogram *m_metric_conversion;
 	unsigned int m_last_nb_samples;
 	bool m_cyclic;
 	std::vector<Channel*> m_channel_list;
 	std::vector<std::vector<double>> m_data;
 	std::vector<unsigned short> m_data_short;
 
+	/* Guards the stream information, which is read from other threads */
+	std::mutex m_stream_lock;
+	libm2k::STREAM_BLOCK_INFO m_last_block;
+	unsigned long long m_next_sequence;
+	unsigned long long m_next_sample;
+	unsigned long long m_gap_count;
+	bool m_restarted;
+	bool m_overflow_detection;
+	std::function<bool()> m_streaming;
+
 	void destroy();
+	ssize_t pushBuffer();
+	ssize_t refillBuffer();
+	void updateStreamInfo();
+	int readOverflow(bool &overflow);
 };
 }
 }
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "calibrationcache.hpp"
+#include <libm2k/logger.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+using namespace libm2k;
+using namespace libm2k::utils;
+
+static const char *CACHE_HEADER = "# libm2k calibration cache v1";
+/* Entries of the same board closer than this are the same calibration point */
+static const double SAME_TEMPERATURE = 1.0;
+
+#ifdef _WIN32
+static const char PATH_SEPARATOR = '\\';
+#else
+static const char PATH_SEPARATOR = '/';
+#endif
+
+static void makeDirectories(const std::string &path)
+{
+	for (size_t pos = path.find_first_of("/\\", 1); pos != std::string::npos;
+	     pos = path.find_first_of("/\\", pos + 1)) {
+		std::string dir = path.substr(0, pos);
+#ifdef _WIN32
+		_mkdir(dir.c_str());
+#else
+		mkdir(dir.c_str(), 0755);
+#endif
+	}
+}
+
+std::string CalibrationCache::defaultPath()
+{
+	const char *path = std::getenv("LIBM2K_CALIBRATION_CACHE");
+	if (path) {
+		return path;
+	}
+
+	std::string dir;
+#ifdef _WIN32
+	const char *local_app_data = std::getenv("LOCALAPPDATA");
+	if (local_app_data) {
+		dir = local_app_data;
+	}
+#else
+	const char *xdg_cache = std::getenv("XDG_CACHE_HOME");
+	const char *home = std::getenv("HOME");
+	if (xdg_cache && *xdg_cache) {
+		dir = xdg_cache;
+	} else if (home && *home) {
+		dir = std::string(home) + PATH_SEPARATOR + ".cache";
+	}
+#endif
+	if (dir.empty()) {
+		return "";
+	}
+	return dir + PATH_SEPARATOR + "libm2k" + PATH_SEPARATOR + "calibration.cache";
+}
+
+CalibrationCache::CalibrationCache(std::string path) :
+	m_path(path)
+{
+}
+
+std::string CalibrationCache::getPath() const
+{
+	return m_path;
+}
+
+bool CalibrationCache::find(const std::string &serial, const std::string &firmware, double temperature,
+			    double max_difference, CALIBRATION_PARAMETERS &parameters,
+			    double &cached_temperature) const
+{
+	bool found = false;
+	double best = std::numeric_limits<double>::max();
+	for (const entry &e : load()) {
+		double difference = std::abs(e.temperature - temperature);
+		if (e.serial != serial || e.firmware != firmware || difference > max_difference) {
+			continue;
+		}
+		if (difference < best) {
+			best = difference;
+			parameters = e.parameters;
+			cached_temperature = e.temperature;
+			found = true;
+		}
+	}
+	return found;
+}
+
+bool CalibrationCache::store(const std::string &serial, const std::string &firmware, double temperature,
+			     const CALIBRATION_PARAMETERS &parameters)
+{
+	if (m_path.empty() || serial.empty()) {
+		return false;
+	}
+	std::vector<entry> entries;
+	for (const entry &e : load()) {
+		if (e.serial == serial && e.firmware == firmware &&
+				std::abs(e.temperature - temperature) < SAME_TEMPERATURE) {
+			continue;
+		}
+		entries.push_back(e);
+	}
+	entries.push_back({serial, firmware, temperature, parameters});
+	return save(entries);
+}
+
+std::vector<CalibrationCache::entry> CalibrationCache::load() const
+{
+	std::vector<entry> entries;
+	if (m_path.empty()) {
+		return entries;
+	}
+	std::ifstream file(m_path);
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		std::istringstream fields(line);
+		entry e;
+		CALIBRATION_PARAMETERS &p = e.parameters;
+		if (fields >> e.serial >> e.firmware >> e.temperature
+				>> p.adc_offset_ch_1 >> p.adc_offset_ch_2 >> p.adc_gain_ch_1 >> p.adc_gain_ch_2
+				>> p.dac_a_offset >> p.dac_b_offset >> p.dac_a_gain >> p.dac_b_gain) {
+			entries.push_back(e);
+		}
+	}
+	return entries;
+}
+
+bool CalibrationCache::save(const std::vector<entry> &entries) const
+{
+	makeDirectories(m_path);
+	/* Written next to the cache and renamed over it, so readers never see a partial file */
+	std::string tmp_path = m_path + ".tmp";
+	{
+		std::ofstream file(tmp_path, std::ios::trunc);
+		if (!file) {
+			LIBM2K_LOG(WARNING, "Cannot write the calibration cache " + tmp_path);
+			return false;
+		}
+		file.precision(std::numeric_limits<double>::max_digits10);
+		file << CACHE_HEADER << "\n";
+		for (const entry &e : entries) {
+			const CALIBRATION_PARAMETERS &p = e.parameters;
+			file << e.serial << " " << e.firmware << " " << e.temperature << " "
+			     << p.adc_offset_ch_1 << " " << p.adc_offset_ch_2 << " "
+			     << p.adc_gain_ch_1 << " " << p.adc_gain_ch_2 << " "
+			     << p.dac_a_offset << " " << p.dac_b_offset << " "
+			     << p.dac_a_gain << " " << p.dac_b_gain << "\n";
+		}
+		if (!file.flush()) {
+			LIBM2K_LOG(WARNING, "Cannot write the calibration cache " + tmp_path);
+			return false;
+		}
+	}
+#ifdef _WIN32
+	std::remove(m_path.c_str());
+#endif
+	if (std::rename(tmp_path.c_str(), m_path.c_str()) != 0) {
+		std::remove(tmp_path.c_str());
+		LIBM2K_LOG(WARNING, "Cannot replace the calibration cache " + m_path);
+		return false;
+	}
+	return true;
+}
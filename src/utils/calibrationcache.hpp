@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CALIBRATIONCACHE_HPP
+#define CALIBRATIONCACHE_HPP
+
+#include <libm2k/enums.hpp>
+#include <string>
+#include <vector>
+
+namespace libm2k {
+namespace utils {
+
+/*
+ * Calibration parameters of the boards seen on this host, stored in a text file
+ * and keyed by serial number, firmware version and board temperature.
+ */
+class CalibrationCache
+{
+public:
+	/* $LIBM2K_CALIBRATION_CACHE, or libm2k/calibration.cache in the user cache directory;
+	 * empty if neither can be determined */
+	static std::string defaultPath();
+
+	explicit CalibrationCache(std::string path = defaultPath());
+
+	/* Look up the entry of the board with the closest temperature, if it is at most
+	 * max_difference degrees away */
+	bool find(const std::string &serial, const std::string &firmware, double temperature,
+		  double max_difference, libm2k::CALIBRATION_PARAMETERS &parameters,
+		  double &cached_temperature) const;
+
+	/* Add an entry, replacing the one of the same board within 1 degree; returns false
+	 * if the file could not be written */
+	bool store(const std::string &serial, const std::string &firmware, double temperature,
+		   const libm2k::CALIBRATION_PARAMETERS &parameters);
+
+	std::string getPath() const;
+private:
+	struct entry {
+		std::string serial;
+		std::string firmware;
+		double temperature;
+		libm2k::CALIBRATION_PARAMETERS parameters;
+	};
+
+	std::vector<entry> load() const;
+	bool save(const std::vector<entry> &entries) const;
+
+	std::string m_path;
+};
+}
+}
+
+#endif //CALIBRATIONCACHE_HPP
@@ -20,6 +20,8 @@
  */
 
 #include "channel.hpp"
+#include "trace.hpp"
+#include "metrics.hpp"
 #include <libm2k/m2kexceptions.hpp>
 #include <libm2k/logger.hpp>
 #include <libm2k/utils/utils.hpp>
@@ -40,6 +42,7 @@ Channel::Channel(iio_device *device, unsigned int channel) {
 	if (!m_channel) {
 		m_channel = nullptr;
 	}
+	initializeInstrumentation();
 }
 
 Channel::Channel(iio_device *device, std::string channel_name, bool output)
@@ -51,9 +54,21 @@ Channel::Channel(iio_device *device, std::string channel_name, bool output)
 
 	if (!m_channel) {
 		m_channel = nullptr;
-
 	}
+	m_dev_name = m_device ? iio_device_get_name(m_device) : nullptr;
+	m_channel_id = m_channel ? iio_channel_get_id(m_channel) : nullptr;
+	initializeInstrumentation();
+}
 
+void Channel::initializeInstrumentation()
+{
+	std::string name = m_dev_name ? m_dev_name : "";
+	if (m_channel_id) {
+		name += std::string("/") + m_channel_id;
+	}
+	m_trace_name = trace::intern(name);
+	m_metric_read = metrics::get("attribute_read", m_dev_name ? m_dev_name : "");
+	m_metric_write = metrics::get("attribute_write", m_dev_name ? m_dev_name : "");
 }
 
 Channel::~Channel() {
@@ -265,8 +280,11 @@ double Channel::getDoubleValue(std::string attr)
 	if (!m_channel) {
 		THROW_M2K_EXCEPTION("Channel: Cannot find associated channel", libm2k::EXC_INVALID_PARAMETER);
 	}
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_read, attr);
+	metrics::Timer timer(m_metric_read);
 	double value = 0.0;
 	int ret = iio_channel_attr_read_double(m_channel, attr.c_str(), &value);
+	timer.setError(ret < 0);
 	if (ret < 0) {
 		THROW_M2K_EXCEPTION("Channel: Cannot read " + attr, libm2k::EXC_INVALID_PARAMETER, ret);
 	}
@@ -280,7 +298,10 @@ void Channel::setDoubleValue(std::string attr, double val)
 	if (!m_channel) {
 		THROW_M2K_EXCEPTION("Channel: Cannot find associated channel", libm2k::EXC_INVALID_PARAMETER);
 	}
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_write, attr);
+	metrics::Timer timer(m_metric_write);
 	int ret = iio_channel_attr_write_double(m_channel, attr.c_str(), val);
+	timer.setError(ret < 0);
 	if (ret < 0) {
 		THROW_M2K_EXCEPTION("Channel: Cannot write " + attr, libm2k::EXC_INVALID_PARAMETER, ret);
 	}
@@ -294,7 +315,10 @@ void Channel::setLongValue(std::string attr, long long val)
 	if (!m_channel) {
 		THROW_M2K_EXCEPTION("Channel: Cannot find associated channel", libm2k::EXC_INVALID_PARAMETER);
 	}
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_write, attr);
+	metrics::Timer timer(m_metric_write);
 	int ret = iio_channel_attr_write_longlong(m_channel, attr.c_str(), val);
+	timer.setError(ret < 0);
 	if (ret < 0) {
 		THROW_M2K_EXCEPTION("Channel: Cannot write " + attr, libm2k::EXC_INVALID_PARAMETER, ret);
 	}
@@ -308,8 +332,11 @@ long long Channel::getLongValue(std::string attr)
 	if (!m_channel) {
 		THROW_M2K_EXCEPTION("Channel: Cannot find associated channel", libm2k::EXC_INVALID_PARAMETER);
 	}
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_read, attr);
+	metrics::Timer timer(m_metric_read);
 	long long value = 0;
 	int ret = iio_channel_attr_read_longlong(m_channel, attr.c_str(), &value);
+	timer.setError(ret < 0);
 	if (ret < 0) {
 		THROW_M2K_EXCEPTION("Channel: Cannot write " + attr, libm2k::EXC_INVALID_PARAMETER, ret);
 	}
@@ -323,7 +350,10 @@ void Channel::setStringValue(std::string attr, std::string val)
 	if (!m_channel) {
 		THROW_M2K_EXCEPTION("Channel: Cannot find associated channel", libm2k::EXC_INVALID_PARAMETER);
 	}
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_write, attr);
+	metrics::Timer timer(m_metric_write);
 	int ret = iio_channel_attr_write(m_channel, attr.c_str(), val.c_str());
+	timer.setError(ret < 0);
 	if (ret < 0) {
 		THROW_M2K_EXCEPTION("Channel: Cannot write " + attr, libm2k::EXC_INVALID_PARAMETER, ret);
 	}
@@ -335,8 +365,11 @@ std::string Channel::getStringValue(std::string attr)
 	if (!m_channel) {
 		THROW_M2K_EXCEPTION("Channel: Cannot find associated channel", libm2k::EXC_INVALID_PARAMETER);
 	}
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_read, attr);
+	metrics::Timer timer(m_metric_read);
 	char value[1024];
 	int ret = iio_channel_attr_read(m_channel, attr.c_str(), value, sizeof(value));
+	timer.setError(ret < 0);
 	if (ret < 0) {
 		THROW_M2K_EXCEPTION("Channel: Cannot write " + attr, libm2k::EXC_INVALID_PARAMETER, ret);
 	}
@@ -349,7 +382,10 @@ void Channel::setBoolValue(std::string attr, bool val)
 	if (!m_channel) {
 		THROW_M2K_EXCEPTION("Channel: Cannot find associated channel", libm2k::EXC_INVALID_PARAMETER);
 	}
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_write, attr);
+	metrics::Timer timer(m_metric_write);
 	int ret = iio_channel_attr_write_bool(m_channel, attr.c_str(), val);
+	timer.setError(ret < 0);
 	if (ret < 0) {
 		THROW_M2K_EXCEPTION("Channel: Cannot write " + attr, libm2k::EXC_INVALID_PARAMETER, ret);
 	}
@@ -363,8 +399,11 @@ bool Channel::getBoolValue(std::string attr)
 	if (!m_channel) {
 		THROW_M2K_EXCEPTION("Channel: Cannot find associated channel", libm2k::EXC_INVALID_PARAMETER);
 	}
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_read, attr);
+	metrics::Timer timer(m_metric_read);
 	bool value;
 	int ret = iio_channel_attr_read_bool(m_channel, attr.c_str(), &value);
+	timer.setError(ret < 0);
 	if (ret < 0) {
 		THROW_M2K_EXCEPTION("Channel: Cannot write " + attr, libm2k::EXC_INVALID_PARAMETER, ret);
 	}
@@ -27,9 +27,13 @@
 #include <string>
 #include <memory>
 #include <libm2k/m2kglobal.hpp>
+#include "trace.hpp"
 
 namespace libm2k {
 namespace utils {
+namespace metrics {
+class Histogram;
+}
 class Channel
 {
 public:
@@ -82,6 +86,13 @@ private:
 
 	const char *m_dev_name;
 	const char *m_channel_id;
+	const char *m_trace_name;
+	trace::OpNames m_trace_read{"read "};
+	trace::OpNames m_trace_write{"write "};
+	metrics::Histogram *m_metric_read;
+	metrics::Histogram *m_metric_write;
+
+	void initializeInstrumentation();
 
 };
 }
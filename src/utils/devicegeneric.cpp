@@ -26,6 +26,8 @@
 #include <libm2k/m2kexceptions.hpp>
 #include <libm2k/logger.hpp>
 #include "context_impl.hpp"
+#include "trace.hpp"
+#include "metrics.hpp"
 #include <algorithm>
 #include <cstring>
 #include <sstream>
@@ -44,6 +46,10 @@ DeviceGeneric::DeviceGeneric(struct iio_context* context, std::string dev_name)
 	m_context = context;
 	m_dev = nullptr;
 	m_buffer = nullptr;
+	m_dev_name = nullptr;
+	m_trace_name = "";
+	m_metric_read = nullptr;
+	m_metric_write = nullptr;
 
 	if (dev_name != "") {
 		m_dev = iio_context_find_device(context, dev_name.c_str());
@@ -51,6 +57,9 @@ DeviceGeneric::DeviceGeneric(struct iio_context* context, std::string dev_name)
 			THROW_M2K_EXCEPTION("Device: No such device", libm2k::EXC_INVALID_PARAMETER);
 		}
 		m_dev_name = iio_device_get_name(m_dev);
+		m_trace_name = trace::intern(m_dev_name ? m_dev_name : dev_name);
+		m_metric_read = metrics::get("attribute_read", dev_name);
+		m_metric_write = metrics::get("attribute_write", dev_name);
 
 		bool is_buffer_capable = false;
 		unsigned int nb_channels = iio_device_get_channels_count(m_dev);
@@ -204,12 +213,14 @@ std::string DeviceGeneric::getBufferAttributeName(unsigned int idx)
 
 double DeviceGeneric::getDoubleValue(std::string attr)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_read, attr);
+	metrics::Timer timer(m_metric_read);
 	double value = 0;
 	std::string dev_name = getName();
 
 	if (ContextImpl::iioDevHasAttribute(m_dev, attr)) {
-		iio_device_attr_read_double(m_dev, attr.c_str(),
-					    &value);
+		ssize_t ret = iio_device_attr_read_double(m_dev, attr.c_str(), &value);
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 	}
@@ -236,10 +247,12 @@ double DeviceGeneric::getDoubleValue(unsigned int chn_idx, std::string attr, boo
 
 double DeviceGeneric::setDoubleValue(double value, std::string attr)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_write, attr);
+	metrics::Timer timer(m_metric_write);
 	std::string dev_name = iio_device_get_name(m_dev);
 	if (ContextImpl::iioDevHasAttribute(m_dev, attr)) {
-		iio_device_attr_write_double(m_dev, attr.c_str(),
-					     value);
+		ssize_t ret = iio_device_attr_write_double(m_dev, attr.c_str(), value);
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 	}
@@ -269,12 +282,14 @@ double DeviceGeneric::setDoubleValue(unsigned int chn_idx, double value, std::st
 
 int DeviceGeneric::getLongValue(std::string attr)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_read, attr);
+	metrics::Timer timer(m_metric_read);
 	long long value = 0;
 	std::string dev_name = getName();
 
 	if (ContextImpl::iioDevHasAttribute(m_dev, attr)) {
-		iio_device_attr_read_longlong(m_dev, attr.c_str(),
-					      &value);
+		ssize_t ret = iio_device_attr_read_longlong(m_dev, attr.c_str(), &value);
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 	}
@@ -301,12 +316,14 @@ int DeviceGeneric::getLongValue(unsigned int chn_idx, std::string attr, bool out
 
 int DeviceGeneric::getBufferLongValue(std::string attr)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_read_buffer, attr);
+	metrics::Timer timer(m_metric_read);
 	long long value = 0;
 	std::string dev_name = getName();
 
 	if (ContextImpl::iioDevBufferHasAttribute(m_dev, attr)) {
-		iio_device_buffer_attr_read_longlong(m_dev, attr.c_str(),
-						     &value);
+		ssize_t ret = iio_device_buffer_attr_read_longlong(m_dev, attr.c_str(), &value);
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 	}
@@ -317,10 +334,12 @@ int DeviceGeneric::getBufferLongValue(std::string attr)
 
 int DeviceGeneric::setLongValue(long long value, std::string attr)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_write, attr);
+	metrics::Timer timer(m_metric_write);
 	std::string dev_name = iio_device_get_name(m_dev);
 	if (ContextImpl::iioDevHasAttribute(m_dev, attr)) {
-		iio_device_attr_write_longlong(m_dev, attr.c_str(),
-					       value);
+		ssize_t ret = iio_device_attr_write_longlong(m_dev, attr.c_str(), value);
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 	}
@@ -350,10 +369,12 @@ int DeviceGeneric::setLongValue(unsigned int chn_idx, long long value, std::stri
 
 int DeviceGeneric::setBufferLongValue(int value, std::string attr)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_write_buffer, attr);
+	metrics::Timer timer(m_metric_write);
 	std::string dev_name = iio_device_get_name(m_dev);
 	if (ContextImpl::iioDevBufferHasAttribute(m_dev, attr)) {
-		iio_device_buffer_attr_write_longlong(m_dev, attr.c_str(),
-						      value);
+		ssize_t ret = iio_device_buffer_attr_write_longlong(m_dev, attr.c_str(), value);
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 	}
@@ -364,12 +385,14 @@ int DeviceGeneric::setBufferLongValue(int value, std::string attr)
 
 bool DeviceGeneric::getBoolValue(string attr)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_read, attr);
+	metrics::Timer timer(m_metric_read);
 	bool value = 0;
 	std::string dev_name = getName();
 
 	if (ContextImpl::iioDevHasAttribute(m_dev, attr)) {
-		iio_device_attr_read_bool(m_dev, attr.c_str(),
-					  &value);
+		ssize_t ret = iio_device_attr_read_bool(m_dev, attr.c_str(), &value);
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 	}
@@ -399,9 +422,12 @@ bool DeviceGeneric::getBoolValue(unsigned int chn_idx, string attr, bool output)
 
 bool DeviceGeneric::setBoolValue(bool value, string attr)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_write, attr);
+	metrics::Timer timer(m_metric_write);
 	std::string dev_name = iio_device_get_name(m_dev);
 	if (ContextImpl::iioDevHasAttribute(m_dev, attr)) {
-		iio_device_attr_write_bool(m_dev, attr.c_str(), value);
+		ssize_t ret = iio_device_attr_write_bool(m_dev, attr.c_str(), value);
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name +
 				    " has no " + attr +
@@ -434,9 +460,12 @@ bool DeviceGeneric::setBoolValue(unsigned int chn_idx, bool value, string attr,
 
 string DeviceGeneric::setStringValue(string attr, string value)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_write, attr);
+	metrics::Timer timer(m_metric_write);
 	std::string dev_name = iio_device_get_name(m_dev);
 	if (ContextImpl::iioDevHasAttribute(m_dev, attr)) {
-		iio_device_attr_write(m_dev, attr.c_str(), value.c_str());
+		ssize_t ret = iio_device_attr_write(m_dev, attr.c_str(), value.c_str());
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 	}
@@ -466,9 +495,12 @@ string DeviceGeneric::setStringValue(unsigned int chn_idx, string attr, string v
 
 string DeviceGeneric::setBufferStringValue(string attr, string value)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_write_buffer, attr);
+	metrics::Timer timer(m_metric_write);
 	std::string dev_name = iio_device_get_name(m_dev);
 	if (ContextImpl::iioDevBufferHasAttribute(m_dev, attr)) {
-		iio_device_buffer_attr_write(m_dev, attr.c_str(), value.c_str());
+		ssize_t ret = iio_device_buffer_attr_write(m_dev, attr.c_str(), value.c_str());
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 	}
@@ -478,12 +510,14 @@ string DeviceGeneric::setBufferStringValue(string attr, string value)
 
 string DeviceGeneric::getStringValue(string attr)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_read, attr);
+	metrics::Timer timer(m_metric_read);
 	char value[100];
 	std::string dev_name = getName();
 
 	if (ContextImpl::iioDevHasAttribute(m_dev, attr)) {
-		iio_device_attr_read(m_dev, attr.c_str(),
-				     value, sizeof(value));
+		ssize_t ret = iio_device_attr_read(m_dev, attr.c_str(), value, sizeof(value));
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(dev_name + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 
@@ -514,10 +548,12 @@ string DeviceGeneric::getStringValue(unsigned int chn_idx, string attr, bool out
 
 string DeviceGeneric::getBufferStringValue(string attr)
 {
+	trace::Scope scope(libm2k::TRACE_ATTRIBUTE, m_trace_name, m_trace_read_buffer, attr);
+	metrics::Timer timer(m_metric_read);
 	char value[100];
 	if (ContextImpl::iioDevBufferHasAttribute(m_dev, attr)) {
-		iio_device_buffer_attr_read(m_dev, attr.c_str(),
-				     value, sizeof(value));
+		ssize_t ret = iio_device_buffer_attr_read(m_dev, attr.c_str(), value, sizeof(value));
+		timer.setError(ret < 0);
 	} else {
 		THROW_M2K_EXCEPTION(std::string(m_dev_name) + " has no " + attr + " attribute", libm2k::EXC_INVALID_PARAMETER);
 
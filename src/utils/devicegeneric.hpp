@@ -28,11 +28,15 @@
 #include <functional>
 #include <memory>
 #include <libm2k/m2kglobal.hpp>
+#include "trace.hpp"
 
 namespace libm2k {
 namespace utils {
 class Channel;
 class Buffer;
+namespace metrics {
+class Histogram;
+}
 
 /**
  * The DeviceGeneric class is to be used in interacting with any IIO device (it should express a correspondent
@@ -118,6 +122,13 @@ protected:
 	std::vector<Channel*> m_channel_list_out;
 	Buffer* m_buffer;
 	const char *m_dev_name;
+	const char *m_trace_name;
+	trace::OpNames m_trace_read{"read "};
+	trace::OpNames m_trace_write{"write "};
+	trace::OpNames m_trace_read_buffer{"read buffer "};
+	trace::OpNames m_trace_write_buffer{"write buffer "};
+	metrics::Histogram *m_metric_read;
+	metrics::Histogram *m_metric_write;
 };
 }
 }
@@ -150,6 +150,54 @@ void DeviceIn::flushBuffer()
 	m_buffer->flushBuffer();
 }
 
+libm2k::STREAM_BLOCK_INFO DeviceIn::getLastBlockInfo()
+{
+	if (!m_buffer) {
+		THROW_M2K_EXCEPTION("Device: not buffer capable", libm2k::EXC_INVALID_PARAMETER);
+	}
+	return m_buffer->getLastBlockInfo();
+}
+
+unsigned long long DeviceIn::getGapCount()
+{
+	if (!m_buffer) {
+		THROW_M2K_EXCEPTION("Device: not buffer capable", libm2k::EXC_INVALID_PARAMETER);
+	}
+	return m_buffer->getGapCount();
+}
+
+void DeviceIn::resetStreamInfo()
+{
+	if (!m_buffer) {
+		THROW_M2K_EXCEPTION("Device: not buffer capable", libm2k::EXC_INVALID_PARAMETER);
+	}
+	m_buffer->resetStreamInfo();
+}
+
+void DeviceIn::setOverflowDetection(bool enable)
+{
+	if (!m_buffer) {
+		THROW_M2K_EXCEPTION("Device: not buffer capable", libm2k::EXC_INVALID_PARAMETER);
+	}
+	m_buffer->setOverflowDetection(enable);
+}
+
+bool DeviceIn::getOverflowDetection()
+{
+	if (!m_buffer) {
+		THROW_M2K_EXCEPTION("Device: not buffer capable", libm2k::EXC_INVALID_PARAMETER);
+	}
+	return m_buffer->getOverflowDetection();
+}
+
+void DeviceIn::setStreamingCheck(std::function<bool()> streaming)
+{
+	if (!m_buffer) {
+		THROW_M2K_EXCEPTION("Device: not buffer capable", libm2k::EXC_INVALID_PARAMETER);
+	}
+	m_buffer->setStreamingCheck(streaming);
+}
+
 struct libm2k::IIO_OBJECTS DeviceIn::getIioObjects()
 {
 	IIO_OBJECTS iio_object = {};
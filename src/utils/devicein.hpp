@@ -62,6 +62,13 @@ public:
 	void cancelBuffer();
 	void flushBuffer();
 	struct IIO_OBJECTS getIioObjects();
+
+	libm2k::STREAM_BLOCK_INFO getLastBlockInfo();
+	unsigned long long getGapCount();
+	void resetStreamInfo();
+	void setOverflowDetection(bool enable);
+	bool getOverflowDetection();
+	void setStreamingCheck(std::function<bool()> streaming);
 private:
 	std::vector<Channel*> m_channel_list;
 };
@@ -114,6 +114,16 @@ void DeviceOut::push(double *data, unsigned int channel, unsigned int nb_samples
 	m_buffer->push(data, channel, nb_samples, cyclic, enableFlag);
 }
 
+void DeviceOut::fillAndPush(unsigned int nb_samples, bool cyclic,
+			    const std::function<void(unsigned short *data, unsigned int nb_samples)> &fill)
+{
+	if (!m_buffer) {
+		THROW_M2K_EXCEPTION("Device: Cannot push; device not buffer capable", libm2k::EXC_RUNTIME_ERROR);
+	}
+	m_buffer->setChannels(m_channel_list);
+	m_buffer->fillAndPush(nb_samples, cyclic, fill);
+}
+
 void DeviceOut::push(short *data, unsigned int channel, unsigned int nb_samples, bool cyclic, bool enableFlag)
 {
 	if (!m_buffer) {
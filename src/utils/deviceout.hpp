@@ -54,6 +54,8 @@ public:
 	void push(std::vector<double> const &data, unsigned int channel, bool cyclic = true, bool enableFlag = false);
 	void push(double *data, unsigned int channel, unsigned int nb_samples, bool cyclic = true, bool enableFlag = false);
 	void push(short *data, unsigned int channel, unsigned int nb_samples, bool cyclic = true, bool enableFlag = false);
+	void fillAndPush(unsigned int nb_samples, bool cyclic,
+			 const std::function<void(unsigned short *data, unsigned int nb_samples)> &fill);
 	void stop();
 	void cancelBuffer();
 	struct IIO_OBJECTS getIioObjects();
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "metrics.hpp"
+#include <libm2k/metrics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+using namespace libm2k::utils;
+
+std::atomic<bool> metrics::g_enabled(true);
+
+namespace {
+struct Registry
+{
+	std::mutex lock;
+	/* Ordered by operation, so that each Prometheus family is written in one block */
+	std::map<std::pair<std::string, std::string>, std::unique_ptr<metrics::Histogram>> histograms;
+};
+
+/* Never destroyed: the devices keep pointers to their histograms */
+Registry &registry()
+{
+	static Registry *instance = new Registry();
+	return *instance;
+}
+
+const double NS_PER_SECOND = 1e9;
+
+double percentile(const uint64_t *buckets, uint64_t total, double quantile, uint64_t min, uint64_t max)
+{
+	if (total == 0) {
+		return 0;
+	}
+	uint64_t rank = static_cast<uint64_t>(std::ceil(quantile * total));
+	rank = std::max<uint64_t>(rank, 1);
+	uint64_t seen = 0;
+	for (unsigned int i = 0; i < metrics::Histogram::NB_BUCKETS; i++) {
+		seen += buckets[i];
+		if (seen >= rank) {
+			uint64_t value = metrics::Histogram::bucketLow(i) + metrics::Histogram::bucketWidth(i) / 2;
+			value = std::min(std::max(value, min), max);
+			return value / NS_PER_SECOND;
+		}
+	}
+	return max / NS_PER_SECOND;
+}
+
+std::string escapeLabel(const std::string &value)
+{
+	std::string escaped;
+	for (char c : value) {
+		if (c == '\\' || c == '"') {
+			escaped += '\\';
+			escaped += c;
+		} else if (c == '\n') {
+			escaped += "\\n";
+		} else {
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+std::string describe(const std::string &operation)
+{
+	static const std::map<std::string, std::string> descriptions = {
+		{"buffer_create", "buffer creations"},
+		{"buffer_refill", "buffer refills"},
+		{"buffer_push", "buffer pushes"},
+		{"attribute_read", "attribute reads"},
+		{"attribute_write", "attribute writes"},
+		{"conversion", "conversions of the samples"},
+		{"spi_transfer", "SPI transfers"},
+		{"i2c_transfer", "I2C transfers"},
+		{"multibus_transfer", "multi-bus transfers"},
+	};
+	auto it = descriptions.find(operation);
+	return (it != descriptions.end()) ? it->second : (operation + " operations");
+}
+}
+
+uint64_t metrics::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+metrics::Histogram::Histogram()
+{
+	reset();
+}
+
+unsigned int metrics::Histogram::bucketIndex(uint64_t value)
+{
+	if (value < SUB_BUCKETS) {
+		return static_cast<unsigned int>(value);
+	}
+	unsigned int exponent = 0;
+	uint64_t v = value;
+	for (unsigned int shift = 32; shift > 0; shift /= 2) {
+		if (v >> shift) {
+			v >>= shift;
+			exponent += shift;
+		}
+	}
+	unsigned int index = (exponent - 3) * SUB_BUCKETS +
+		static_cast<unsigned int>((value >> (exponent - 4)) & (SUB_BUCKETS - 1));
+	return std::min(index, NB_BUCKETS - 1);
+}
+
+uint64_t metrics::Histogram::bucketLow(unsigned int index)
+{
+	if (index < SUB_BUCKETS) {
+		return index;
+	}
+	unsigned int exponent = index / SUB_BUCKETS + 3;
+	return static_cast<uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << (exponent - 4);
+}
+
+uint64_t metrics::Histogram::bucketWidth(unsigned int index)
+{
+	if (index < SUB_BUCKETS) {
+		return 1;
+	}
+	return static_cast<uint64_t>(1) << (index / SUB_BUCKETS - 1);
+}
+
+void metrics::Histogram::record(uint64_t duration, uint64_t bytes, bool error)
+{
+	m_buckets[bucketIndex(duration)].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_sum.fetch_add(duration, std::memory_order_relaxed);
+	m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+	if (error) {
+		m_errors.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint64_t current = m_min.load(std::memory_order_relaxed);
+	while (duration < current && !m_min.compare_exchange_weak(current, duration, std::memory_order_relaxed)) {
+	}
+	current = m_max.load(std::memory_order_relaxed);
+	while (duration > current && !m_max.compare_exchange_weak(current, duration, std::memory_order_relaxed)) {
+	}
+}
+
+void metrics::Histogram::reset()
+{
+	for (auto &bucket : m_buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	m_count.store(0, std::memory_order_relaxed);
+	m_errors.store(0, std::memory_order_relaxed);
+	m_bytes.store(0, std::memory_order_relaxed);
+	m_sum.store(0, std::memory_order_relaxed);
+	m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+	m_max.store(0, std::memory_order_relaxed);
+}
+
+void metrics::Histogram::summarize(libm2k::METRIC_SUMMARY &summary) const
+{
+	/* The percentiles use the buckets seen here, which may lag behind the counters
+	 * while other threads record */
+	uint64_t buckets[NB_BUCKETS];
+	uint64_t total = 0;
+	for (unsigned int i = 0; i < NB_BUCKETS; i++) {
+		buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+		total += buckets[i];
+	}
+	uint64_t min = m_min.load(std::memory_order_relaxed);
+	uint64_t max = m_max.load(std::memory_order_relaxed);
+	if (total == 0) {
+		min = max = 0;
+	}
+
+	summary.count = m_count.load(std::memory_order_relaxed);
+	summary.errors = m_errors.load(std::memory_order_relaxed);
+	summary.bytes = m_bytes.load(std::memory_order_relaxed);
+	summary.sum = m_sum.load(std::memory_order_relaxed) / NS_PER_SECOND;
+	summary.min = min / NS_PER_SECOND;
+	summary.max = max / NS_PER_SECOND;
+	summary.p50 = percentile(buckets, total, 0.5, min, max);
+	summary.p90 = percentile(buckets, total, 0.9, min, max);
+	summary.p99 = percentile(buckets, total, 0.99, min, max);
+	summary.p999 = percentile(buckets, total, 0.999, min, max);
+}
+
+metrics::Histogram *metrics::get(const char *operation, const std::string &device)
+{
+	Registry &reg = registry();
+	std::lock_guard<std::mutex> lock(reg.lock);
+	auto &histogram = reg.histograms[std::make_pair(std::string(operation), device)];
+	if (!histogram) {
+		histogram.reset(new Histogram());
+	}
+	return histogram.get();
+}
+
+void libm2k::enableMetrics(bool enable)
+{
+	metrics::g_enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool libm2k::isMetricsEnabled()
+{
+	return metrics::enabled();
+}
+
+std::vector<libm2k::METRIC_SUMMARY> libm2k::getMetrics()
+{
+	Registry &reg = registry();
+	std::lock_guard<std::mutex> lock(reg.lock);
+	std::vector<libm2k::METRIC_SUMMARY> summaries;
+	for (const auto &entry : reg.histograms) {
+		libm2k::METRIC_SUMMARY summary;
+		summary.name = entry.first.first;
+		summary.device = entry.first.second;
+		entry.second->summarize(summary);
+		summaries.push_back(summary);
+	}
+	return summaries;
+}
+
+void libm2k::resetMetrics()
+{
+	Registry &reg = registry();
+	std::lock_guard<std::mutex> lock(reg.lock);
+	for (const auto &entry : reg.histograms) {
+		entry.second->reset();
+	}
+}
+
+std::string libm2k::getPrometheusMetrics()
+{
+	const std::vector<libm2k::METRIC_SUMMARY> summaries = getMetrics();
+	std::ostringstream out;
+	out.imbue(std::locale::classic());
+	out << std::setprecision(9);
+
+	size_t first = 0;
+	while (first < summaries.size()) {
+		const std::string &operation = summaries[first].name;
+		size_t last = first;
+		while (last < summaries.size() && summaries[last].name == operation) {
+			last++;
+		}
+		const std::string family = "libm2k_" + operation;
+		const std::string description = describe(operation);
+
+		out << "# HELP " << family << "_seconds Duration of the " << description << "\n";
+		out << "# TYPE " << family << "_seconds summary\n";
+		for (size_t i = first; i < last; i++) {
+			const std::string device = "device=\"" + escapeLabel(summaries[i].device) + "\"";
+			const std::pair<const char *, double> quantiles[] = {
+				{"0.5", summaries[i].p50}, {"0.9", summaries[i].p90},
+				{"0.99", summaries[i].p99}, {"0.999", summaries[i].p999},
+			};
+			for (const auto &quantile : quantiles) {
+				out << family << "_seconds{" << device << ",quantile=\"" << quantile.first << "\"} "
+				    << quantile.second << "\n";
+			}
+			out << family << "_seconds_sum{" << device << "} " << summaries[i].sum << "\n";
+			out << family << "_seconds_count{" << device << "} " << summaries[i].count << "\n";
+		}
+
+		out << "# HELP " << family << "_errors_total Number of failed " << description << "\n";
+		out << "# TYPE " << family << "_errors_total counter\n";
+		for (size_t i = first; i < last; i++) {
+			out << family << "_errors_total{device=\"" << escapeLabel(summaries[i].device) << "\"} "
+			    << summaries[i].errors << "\n";
+		}
+
+		out << "# HELP " << family << "_bytes_total Number of bytes handled by the " << description << "\n";
+		out << "# TYPE " << family << "_bytes_total counter\n";
+		for (size_t i = first; i < last; i++) {
+			out << family << "_bytes_total{device=\"" << escapeLabel(summaries[i].device) << "\"} "
+			    << summaries[i].bytes << "\n";
+		}
+		first = last;
+	}
+	return out.str();
+}
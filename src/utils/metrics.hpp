@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef METRICS_INTERNAL_HPP
+#define METRICS_INTERNAL_HPP
+
+#include <libm2k/enums.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace libm2k {
+namespace utils {
+namespace metrics {
+
+extern std::atomic<bool> g_enabled;
+
+inline bool enabled()
+{
+	return g_enabled.load(std::memory_order_relaxed);
+}
+
+/* Nanoseconds from a monotonic clock */
+uint64_t now();
+
+/*
+ * Latency histogram in nanoseconds, with 16 linear buckets for each power of
+ * two (HDR style, relative error below 1/16). Recording takes no lock.
+ */
+class Histogram
+{
+public:
+	static const unsigned int SUB_BUCKETS = 16;
+	/* Durations from 2^41 ns (~37 minutes) up fall in the last bucket */
+	static const unsigned int NB_BUCKETS = (41 - 3) * SUB_BUCKETS;
+
+	Histogram();
+
+	void record(uint64_t duration, uint64_t bytes, bool error);
+	void reset();
+	void summarize(libm2k::METRIC_SUMMARY &summary) const;
+
+	static unsigned int bucketIndex(uint64_t value);
+	static uint64_t bucketLow(unsigned int index);
+	static uint64_t bucketWidth(unsigned int index);
+
+private:
+	Histogram(const Histogram &) = delete;
+	Histogram &operator=(const Histogram &) = delete;
+
+	std::atomic<uint64_t> m_buckets[NB_BUCKETS];
+	std::atomic<uint64_t> m_count;
+	std::atomic<uint64_t> m_errors;
+	std::atomic<uint64_t> m_bytes;
+	std::atomic<uint64_t> m_sum;
+	std::atomic<uint64_t> m_min;
+	std::atomic<uint64_t> m_max;
+};
+
+/* The histogram of one operation of one device, created on first use; it lives as long as the library */
+Histogram *get(const char *operation, const std::string &device);
+
+/* Measures one operation, if the metrics are enabled when it starts */
+class Timer
+{
+public:
+	explicit Timer(Histogram *histogram, uint64_t bytes = 0) :
+		m_histogram(enabled() ? histogram : nullptr),
+		m_bytes(bytes),
+		m_error(false),
+		m_start(m_histogram ? now() : 0)
+	{
+	}
+
+	~Timer()
+	{
+		if (m_histogram) {
+			m_histogram->record(now() - m_start, m_bytes, m_error);
+		}
+	}
+
+	void setBytes(uint64_t bytes)
+	{
+		m_bytes = bytes;
+	}
+
+	void setError(bool error)
+	{
+		m_error = error;
+	}
+
+private:
+	Timer(const Timer &) = delete;
+	Timer &operator=(const Timer &) = delete;
+
+	Histogram *m_histogram;
+	uint64_t m_bytes;
+	bool m_error;
+	uint64_t m_start;
+};
+}
+}
+}
+
+#endif //METRICS_INTERNAL_HPP
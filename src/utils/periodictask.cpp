@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "periodictask.hpp"
+#include <libm2k/m2kexceptions.hpp>
+#include <libm2k/logger.hpp>
+
+using namespace libm2k::utils;
+
+PeriodicTask::PeriodicTask() :
+	m_period(0),
+	m_stop(true),
+	m_generation(0)
+{
+}
+
+PeriodicTask::~PeriodicTask()
+{
+	stop();
+}
+
+void PeriodicTask::start(std::chrono::microseconds period, std::function<void()> task)
+{
+	if (period.count() <= 0) {
+		THROW_M2K_EXCEPTION("PeriodicTask: the period must be greater than 0", libm2k::EXC_INVALID_PARAMETER);
+	}
+	stop();
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_stop = false;
+	m_period = period;
+	m_generation++;
+	m_thread = std::thread(&PeriodicTask::loop, this, m_generation, task);
+}
+
+void PeriodicTask::stop()
+{
+	std::thread thread;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stop = true;
+		thread.swap(m_thread);
+		m_cond.notify_all();
+	}
+	if (thread.joinable()) {
+		if (thread.get_id() == std::this_thread::get_id()) {
+			thread.detach();
+		} else {
+			thread.join();
+		}
+	}
+}
+
+void PeriodicTask::setPeriod(std::chrono::microseconds period)
+{
+	if (period.count() <= 0) {
+		THROW_M2K_EXCEPTION("PeriodicTask: the period must be greater than 0", libm2k::EXC_INVALID_PARAMETER);
+	}
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_period = period;
+	m_cond.notify_all();
+}
+
+bool PeriodicTask::isRunning()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return !m_stop;
+}
+
+void PeriodicTask::loop(unsigned int generation, std::function<void()> task)
+{
+	auto last = std::chrono::steady_clock::now();
+	std::unique_lock<std::mutex> lock(m_lock);
+	auto stopped = [this, generation] { return m_stop || m_generation != generation; };
+	while (!stopped()) {
+		lock.unlock();
+		__try {
+			task();
+		} __catch (exception_type &e) {
+			LIBM2K_LOG(ERROR, std::string("PeriodicTask: ") + e.what());
+		}
+		lock.lock();
+
+		/* The period may change while waiting; the next tick follows the latest one */
+		auto period = m_period;
+		auto next = last + period;
+		auto now = std::chrono::steady_clock::now();
+		if (next < now) {
+			next += ((now - next) / period + 1) * period;
+		}
+		while (!stopped() && std::chrono::steady_clock::now() < next) {
+			m_cond.wait_until(lock, next);
+			if (m_period != period) {
+				next += m_period - period;
+				period = m_period;
+			}
+		}
+		last = next;
+	}
+}
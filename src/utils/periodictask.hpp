@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PERIODICTASK_HPP
+#define PERIODICTASK_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace libm2k {
+namespace utils {
+
+/*
+ * Runs a function at a fixed rate on a background thread until stopped.
+ * Ticks missed because the function ran late are skipped, not queued up.
+ */
+class PeriodicTask
+{
+public:
+	PeriodicTask();
+	~PeriodicTask();
+
+	void start(std::chrono::microseconds period, std::function<void()> task);
+	void stop();
+	bool isRunning();
+	/* Changes the period of a running task, from its next tick on */
+	void setPeriod(std::chrono::microseconds period);
+private:
+	void loop(unsigned int generation, std::function<void()> task);
+
+	std::mutex m_lock;
+	std::condition_variable m_cond;
+	std::thread m_thread;
+	std::chrono::microseconds m_period;
+	bool m_stop;
+	/* A loop detached by stop() from its own thread exits once start() was called again */
+	unsigned int m_generation;
+};
+}
+}
+
+#endif //PERIODICTASK_HPP
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PHASETIMER_HPP
+#define PHASETIMER_HPP
+
+#include <libm2k/logger.hpp>
+#include <chrono>
+#include <string>
+
+namespace libm2k {
+namespace utils {
+
+/*
+ * Logs how long each phase of a multi step operation took, e.g.
+ * "[TIMING] Open M2K: trigger 3.2 ms", followed by the total.
+ */
+class PhaseTimer
+{
+public:
+	explicit PhaseTimer(const std::string &operation) :
+		m_operation(operation),
+		m_start(std::chrono::steady_clock::now()),
+		m_last(m_start)
+	{
+	}
+
+	void mark(const std::string &phase)
+	{
+		const auto now = std::chrono::steady_clock::now();
+		log(phase, now - m_last);
+		m_last = now;
+	}
+
+	void finish()
+	{
+		log("total", std::chrono::steady_clock::now() - m_start);
+	}
+
+private:
+	void log(const std::string &phase, std::chrono::steady_clock::duration elapsed)
+	{
+		const double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+		LIBM2K_LOG(INFO, "[TIMING] " + m_operation + ": " + phase + " " + std::to_string(ms) + " ms");
+	}
+
+	std::string m_operation;
+	std::chrono::steady_clock::time_point m_start;
+	std::chrono::steady_clock::time_point m_last;
+};
+}
+}
+
+#endif //PHASETIMER_HPP
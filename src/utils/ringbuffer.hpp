@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RINGBUFFER_HPP
+#define RINGBUFFER_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace libm2k {
+namespace utils {
+
+/*
+ * Fixed capacity FIFO which overwrites its oldest element when full.
+ * Not thread safe; the owner is expected to hold its own lock.
+ */
+template <typename T>
+class RingBuffer
+{
+public:
+	explicit RingBuffer(size_t capacity = 0) :
+		m_data(capacity),
+		m_head(0),
+		m_count(0)
+	{
+	}
+
+	void reset(size_t capacity)
+	{
+		m_data.assign(capacity, T());
+		m_head = 0;
+		m_count = 0;
+	}
+
+	void push(T value)
+	{
+		if (m_data.empty()) {
+			return;
+		}
+		m_data[m_head] = std::move(value);
+		m_head = (m_head + 1) % m_data.size();
+		if (m_count < m_data.size()) {
+			m_count++;
+		}
+	}
+
+	/* Remove and return all the elements, the oldest first */
+	std::vector<T> drain()
+	{
+		std::vector<T> values;
+		values.reserve(m_count);
+		size_t first = (m_head + m_data.size() - m_count) % (m_data.empty() ? 1 : m_data.size());
+		for (size_t i = 0; i < m_count; i++) {
+			values.push_back(std::move(m_data[(first + i) % m_data.size()]));
+		}
+		m_count = 0;
+		return values;
+	}
+
+	size_t size() const
+	{
+		return m_count;
+	}
+
+	size_t capacity() const
+	{
+		return m_data.size();
+	}
+private:
+	std::vector<T> m_data;
+	size_t m_head;
+	size_t m_count;
+};
+}
+}
+
+#endif //RINGBUFFER_HPP
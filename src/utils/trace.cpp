@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "trace.hpp"
+#include <libm2k/tracing.hpp>
+#include <libm2k/m2kexceptions.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
+using namespace libm2k::utils;
+
+std::atomic<unsigned int> trace::g_categories(libm2k::TRACE_NONE);
+
+namespace {
+/* Events kept per thread; a record is 48 bytes */
+constexpr uint64_t RING_CAPACITY = 8192;
+
+/* The fields are atomics so that the exporter may read a record while its
+ * thread overwrites it; such records are detected and dropped */
+struct Record
+{
+	std::atomic<uint64_t> start;
+	std::atomic<uint64_t> duration;
+	std::atomic<uint64_t> size;
+	std::atomic<const char *> device;
+	std::atomic<const char *> op;
+	std::atomic<unsigned int> category;
+	std::atomic<unsigned int> thread;
+};
+
+struct Ring
+{
+	Ring() : head(0), cleared(0), owned(true) {}
+
+	Record records[RING_CAPACITY];
+	/* Only the owner thread writes head */
+	std::atomic<uint64_t> head;
+	std::atomic<uint64_t> cleared;
+	std::atomic<bool> owned;
+};
+
+struct Registry
+{
+	std::mutex lock;
+	std::vector<std::unique_ptr<Ring>> rings;
+	std::unordered_set<std::string> names;
+	unsigned int next_thread = 1;
+};
+
+Registry &registry()
+{
+	/* Never destroyed, threads may record events while the library is unloaded */
+	static Registry *instance = new Registry();
+	return *instance;
+}
+
+/* The ring of a finished thread is handed to the next new thread, events included */
+struct ThreadRing
+{
+	ThreadRing() : ring(nullptr), thread(0)
+	{
+		Registry &reg = registry();
+		std::lock_guard<std::mutex> lock(reg.lock);
+		thread = reg.next_thread++;
+		for (auto &r : reg.rings) {
+			if (!r->owned.load()) {
+				r->owned.store(true);
+				ring = r.get();
+				return;
+			}
+		}
+		reg.rings.emplace_back(new Ring());
+		ring = reg.rings.back().get();
+	}
+
+	~ThreadRing()
+	{
+		ring->owned.store(false);
+	}
+
+	Ring *ring;
+	unsigned int thread;
+};
+
+std::string jsonEscape(const char *value)
+{
+	std::string escaped;
+	for (const char *c = value ? value : ""; *c; c++) {
+		if (*c == '"' || *c == '\\') {
+			escaped += '\\';
+		}
+		if (static_cast<unsigned char>(*c) >= 0x20) {
+			escaped += *c;
+		}
+	}
+	return escaped;
+}
+
+const char *categoryName(unsigned int category)
+{
+	switch (category) {
+	case libm2k::TRACE_BUFFER:
+		return "buffer";
+	case libm2k::TRACE_ATTRIBUTE:
+		return "attribute";
+	default:
+		return "other";
+	}
+}
+}
+
+uint64_t trace::now()
+{
+	static const auto epoch = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+const char *trace::intern(const std::string &name)
+{
+	Registry &reg = registry();
+	std::lock_guard<std::mutex> lock(reg.lock);
+	return reg.names.insert(name).first->c_str();
+}
+
+const char *trace::OpNames::get(const std::string &name)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto it = m_names.find(name);
+	if (it == m_names.end()) {
+		it = m_names.emplace(name, intern(m_prefix + name)).first;
+	}
+	return it->second;
+}
+
+void trace::record(unsigned int category, const char *device, const char *op,
+		   uint64_t size, uint64_t start, uint64_t duration)
+{
+	static thread_local ThreadRing local;
+	Ring *ring = local.ring;
+
+	const uint64_t index = ring->head.load(std::memory_order_relaxed);
+	Record &rec = ring->records[index % RING_CAPACITY];
+	/* An exporter which reads any of the fields below also sees the head published before */
+	std::atomic_thread_fence(std::memory_order_release);
+	rec.start.store(start, std::memory_order_relaxed);
+	rec.duration.store(duration, std::memory_order_relaxed);
+	rec.size.store(size, std::memory_order_relaxed);
+	/* Released, the strings may have just been interned */
+	rec.device.store(device, std::memory_order_release);
+	rec.op.store(op, std::memory_order_release);
+	rec.category.store(category, std::memory_order_relaxed);
+	rec.thread.store(local.thread, std::memory_order_relaxed);
+	ring->head.store(index + 1, std::memory_order_release);
+}
+
+void libm2k::enableTracing(unsigned int categories)
+{
+	trace::g_categories.store(categories & LIBM2K_TRACE_CATEGORIES);
+}
+
+unsigned int libm2k::getTracingCategories()
+{
+	return trace::g_categories.load();
+}
+
+void libm2k::clearTrace()
+{
+	Registry &reg = registry();
+	std::lock_guard<std::mutex> lock(reg.lock);
+	for (auto &ring : reg.rings) {
+		ring->cleared.store(ring->head.load(std::memory_order_acquire));
+	}
+}
+
+std::string libm2k::getChromeTrace()
+{
+	std::vector<Ring *> rings;
+	{
+		Registry &reg = registry();
+		std::lock_guard<std::mutex> lock(reg.lock);
+		for (auto &ring : reg.rings) {
+			rings.push_back(ring.get());
+		}
+	}
+
+	std::ostringstream out;
+	out << "{\"traceEvents\":[";
+	bool first = true;
+	for (Ring *ring : rings) {
+		const uint64_t head = ring->head.load(std::memory_order_acquire);
+		uint64_t begin = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+		begin = std::max(begin, ring->cleared.load());
+
+		std::vector<std::string> lines;
+		for (uint64_t i = begin; i < head; i++) {
+			const Record &rec = ring->records[i % RING_CAPACITY];
+			std::ostringstream ev;
+			ev << std::fixed << std::setprecision(3);
+			ev << "{\"name\":\"" << jsonEscape(rec.op.load(std::memory_order_acquire))
+			   << "\",\"cat\":\"" << categoryName(rec.category.load(std::memory_order_relaxed))
+			   << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << rec.thread.load(std::memory_order_relaxed)
+			   << ",\"ts\":" << rec.start.load(std::memory_order_relaxed) / 1000.0
+			   << ",\"dur\":" << rec.duration.load(std::memory_order_relaxed) / 1000.0
+			   << ",\"args\":{\"device\":\"" << jsonEscape(rec.device.load(std::memory_order_acquire))
+			   << "\",\"size\":" << rec.size.load(std::memory_order_relaxed) << "}}";
+			lines.push_back(ev.str());
+		}
+
+		/* The records the thread overwrote meanwhile are inconsistent, and so is
+		 * the one it may be writing now, in the slot of record head_after */
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64_t head_after = ring->head.load(std::memory_order_acquire);
+		if (head_after + 1 > RING_CAPACITY && head_after + 1 - RING_CAPACITY > begin) {
+			const uint64_t dropped = std::min<uint64_t>(head_after + 1 - RING_CAPACITY - begin, lines.size());
+			lines.erase(lines.begin(), lines.begin() + dropped);
+		}
+		for (const auto &line : lines) {
+			out << (first ? "" : ",") << line;
+			first = false;
+		}
+	}
+	out << "],\"displayTimeUnit\":\"ms\"}";
+	return out.str();
+}
+
+void libm2k::writeChromeTrace(const std::string &path)
+{
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+	if (!file) {
+		THROW_M2K_EXCEPTION("Cannot open the trace file " + path, libm2k::EXC_RUNTIME_ERROR);
+	}
+	file << getChromeTrace();
+	if (!file) {
+		THROW_M2K_EXCEPTION("Cannot write the trace file " + path, libm2k::EXC_RUNTIME_ERROR);
+	}
+}
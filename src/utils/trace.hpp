@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <libm2k/enums.hpp>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/* Categories compiled in; the others reduce to a constant false test */
+#ifndef LIBM2K_TRACE_CATEGORIES
+#define LIBM2K_TRACE_CATEGORIES libm2k::TRACE_ALL
+#endif
+
+namespace libm2k {
+namespace utils {
+namespace trace {
+
+extern std::atomic<unsigned int> g_categories;
+
+inline bool enabled(unsigned int category)
+{
+	return (LIBM2K_TRACE_CATEGORIES & category) &&
+		(g_categories.load(std::memory_order_relaxed) & category);
+}
+
+/* Nanoseconds since the first use of the tracer */
+uint64_t now();
+
+/* Return a copy of name which lives as long as the library, usable in the records */
+const char *intern(const std::string &name);
+
+/* Append one event to the ring of the calling thread */
+void record(unsigned int category, const char *device, const char *op,
+	    uint64_t size, uint64_t start, uint64_t duration);
+
+/*
+ * Operation names made of a fixed prefix and a variable name, such as
+ * "read " and an attribute. Each name is interned once, on its first
+ * traced use; the later uses only look it up here.
+ */
+class OpNames
+{
+public:
+	explicit OpNames(const char *prefix) : m_prefix(prefix) {}
+
+	const char *get(const std::string &name);
+
+private:
+	OpNames(const OpNames &) = delete;
+	OpNames &operator=(const OpNames &) = delete;
+
+	std::string m_prefix;
+	std::mutex m_lock;
+	std::unordered_map<std::string, const char *> m_names;
+};
+
+/*
+ * Records one event covering its lifetime, if its category is traced when it
+ * is created. device and op must be interned, or string literals.
+ */
+class Scope
+{
+public:
+	Scope(unsigned int category, const char *device, const char *op, uint64_t size = 0) :
+		m_active(enabled(category)),
+		m_category(category),
+		m_device(device),
+		m_op(op),
+		m_size(size),
+		m_start(m_active ? now() : 0)
+	{
+	}
+
+	/* The operation name is only looked up when the event is recorded */
+	Scope(unsigned int category, const char *device, OpNames &ops, const std::string &name) :
+		m_active(enabled(category)),
+		m_category(category),
+		m_device(device),
+		m_op(m_active ? ops.get(name) : nullptr),
+		m_size(0),
+		m_start(m_active ? now() : 0)
+	{
+	}
+
+	~Scope()
+	{
+		if (m_active) {
+			record(m_category, m_device, m_op, m_size, m_start, now() - m_start);
+		}
+	}
+
+	void setSize(uint64_t size)
+	{
+		m_size = size;
+	}
+
+private:
+	Scope(const Scope &) = delete;
+	Scope &operator=(const Scope &) = delete;
+
+	bool m_active;
+	unsigned int m_category;
+	const char *m_device;
+	const char *m_op;
+	uint64_t m_size;
+	uint64_t m_start;
+};
+}
+}
+}
+
+#endif //TRACE_HPP
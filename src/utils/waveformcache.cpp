@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "waveformcache.hpp"
+#include <cstring>
+
+using namespace libm2k;
+using namespace libm2k::utils;
+
+static inline uint64_t rotate(uint64_t value, unsigned int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t round(uint64_t h, const double *sample)
+{
+	uint64_t bits;
+	memcpy(&bits, sample, sizeof(bits));
+	h += bits * 0xC2B2AE3D27D4EB4Full;
+	return rotate(h, 31) * 0x9E3779B97F4A7C15ull;
+}
+
+uint64_t WaveformCache::hash(const double *data, size_t nb_samples, size_t stride, uint64_t seed)
+{
+	// the rounds and the finalizer of xxHash64, on four independent lanes
+	uint64_t lanes[4] = {seed + 0x60EA27EEADC0B5D6ull, seed + 0xC2B2AE3D27D4EB4Full, seed,
+			     seed - 0x9E3779B97F4A7C15ull};
+	size_t i = 0;
+	for (; i + 4 <= nb_samples; i += 4) {
+		for (unsigned int lane = 0; lane < 4; lane++) {
+			lanes[lane] = round(lanes[lane], data + (i + lane) * stride);
+		}
+	}
+	for (; i < nb_samples; i++) {
+		lanes[0] = round(lanes[0], data + i * stride);
+	}
+
+	uint64_t h = rotate(lanes[0], 1) + rotate(lanes[1], 7) + rotate(lanes[2], 12) + rotate(lanes[3], 18);
+	h ^= nb_samples * 0x9E3779B97F4A7C15ull;
+	h ^= h >> 33;
+	h *= 0xC2B2AE3D27D4EB4Full;
+	h ^= h >> 29;
+	h *= 0x165667B19E3779F9ull;
+	h ^= h >> 32;
+	return h;
+}
+
+WaveformCache::WaveformCache(size_t max_bytes) :
+	m_max_bytes(max_bytes),
+	m_bytes(0),
+	m_hits(0),
+	m_misses(0),
+	m_evictions(0)
+{
+}
+
+std::shared_ptr<const std::vector<short>> WaveformCache::find(const key &k)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+		if (it->k.hash == k.hash && it->k.nb_samples == k.nb_samples &&
+				it->k.sample_rate == k.sample_rate && it->k.vlsb == k.vlsb) {
+			m_entries.splice(m_entries.begin(), m_entries, it);
+			m_hits++;
+			return it->data;
+		}
+	}
+	m_misses++;
+	return nullptr;
+}
+
+void WaveformCache::store(const key &k, std::shared_ptr<const std::vector<short>> data)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	size_t bytes = data->size() * sizeof(short);
+	if (bytes > m_max_bytes) {
+		return;
+	}
+	m_entries.push_front({k, data});
+	m_bytes += bytes;
+	evict();
+}
+
+void WaveformCache::setMaxSize(size_t max_bytes)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_max_bytes = max_bytes;
+	evict();
+}
+
+size_t WaveformCache::getMaxSize() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return m_max_bytes;
+}
+
+void WaveformCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_entries.clear();
+	m_bytes = 0;
+	m_hits = 0;
+	m_misses = 0;
+	m_evictions = 0;
+}
+
+WAVEFORM_CACHE_STATS WaveformCache::getStats() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	WAVEFORM_CACHE_STATS stats;
+	stats.hits = m_hits;
+	stats.misses = m_misses;
+	stats.evictions = m_evictions;
+	stats.entries = m_entries.size();
+	stats.bytes = m_bytes;
+	return stats;
+}
+
+void WaveformCache::evict()
+{
+	while (m_bytes > m_max_bytes && !m_entries.empty()) {
+		m_bytes -= m_entries.back().data->size() * sizeof(short);
+		m_entries.pop_back();
+		m_evictions++;
+	}
+}
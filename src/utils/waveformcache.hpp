@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WAVEFORMCACHE_HPP
+#define WAVEFORMCACHE_HPP
+
+#include <libm2k/enums.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace libm2k {
+namespace utils {
+
+/*
+ * Raw buffers of the waveforms pushed recently, keyed by a hash of their content
+ * and by everything their conversion depends on. The least recently used buffers
+ * are dropped once the total size exceeds the limit.
+ */
+class WaveformCache
+{
+public:
+	struct key {
+		uint64_t hash;
+		size_t nb_samples;
+		double sample_rate;
+		double vlsb;
+	};
+
+	/* 64-bit hash of nb_samples doubles, stride elements apart */
+	static uint64_t hash(const double *data, size_t nb_samples, size_t stride = 1, uint64_t seed = 0);
+
+	explicit WaveformCache(size_t max_bytes);
+
+	/* The buffer stored under the key, or null; counted as a hit or a miss */
+	std::shared_ptr<const std::vector<short>> find(const key &k);
+	void store(const key &k, std::shared_ptr<const std::vector<short>> data);
+
+	/* A limit of 0 disables the cache */
+	void setMaxSize(size_t max_bytes);
+	size_t getMaxSize() const;
+	void clear();
+	libm2k::WAVEFORM_CACHE_STATS getStats() const;
+private:
+	struct entry {
+		key k;
+		std::shared_ptr<const std::vector<short>> data;
+	};
+
+	void evict();
+
+	mutable std::mutex m_lock;
+	std::list<entry> m_entries; // the most recently used first
+	size_t m_max_bytes;
+	size_t m_bytes;
+	unsigned long long m_hits;
+	unsigned long long m_misses;
+	unsigned long long m_evictions;
+};
+}
+}
+
+#endif //WAVEFORMCACHE_HPP
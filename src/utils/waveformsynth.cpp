@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "waveformsynth.hpp"
+#include <libm2k/m2kexceptions.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+using namespace libm2k;
+using namespace libm2k::analog;
+using namespace libm2k::utils;
+
+/* The samples are synthesized in blocks of this length */
+static const unsigned int BLOCK_SIZE = 256;
+/* The cyclic length search stops at the first length this close to every frequency */
+static const double MAX_FREQUENCY_ERROR = 1e-6;
+
+/* A fraction of a cycle as a 64-bit phase */
+static uint64_t toPhase(double cycles)
+{
+	double phase = std::ldexp(cycles - std::floor(cycles), 64);
+	if (phase >= std::ldexp(1.0, 64)) {
+		return 0;
+	}
+	return (uint64_t)phase;
+}
+
+/* The top 32 bits of a phase, as a fraction of a cycle in [-0.5, 0.5) */
+static inline double toCycles(uint32_t phase)
+{
+	return (int32_t)phase * (1.0 / 4294967296.0);
+}
+
+/* Fold a fraction of a cycle in [-0.5, 0.5) into [-0.25, 0.25], where the sine and the
+ * triangle rise; both are symmetric around a quarter of a cycle */
+static inline double fold(double x)
+{
+	double y = (x > 0.25) ? 0.5 - x : x;
+	return (y < -0.25) ? -0.5 - y : y;
+}
+
+static bool isPeriodic(WAVEFORM_TYPE type)
+{
+	return type != WAVEFORM_NOISE && type != WAVEFORM_DC;
+}
+
+unsigned int WaveformSynth::getCyclicLength(const WAVEFORM &waveform, double sample_rate,
+					    unsigned int min_length, unsigned int max_length)
+{
+	std::vector<double> ratios;
+	for (const WAVEFORM_TONE &tone : waveform.tones) {
+		if (isPeriodic(tone.type) && tone.frequency > 0) {
+			ratios.push_back(tone.frequency / sample_rate);
+		}
+	}
+
+	unsigned int first = (std::max(min_length, 4u) + 3) & ~3u;
+	if (ratios.empty()) {
+		return first;
+	}
+
+	unsigned int best_length = first;
+	double best_error = HUGE_VAL;
+	for (unsigned int length = first; length <= max_length; length += 4) {
+		double error = 0;
+		for (double ratio : ratios) {
+			double cycles = ratio * length;
+			double whole = std::round(cycles);
+			error = std::max(error, (whole > 0) ? std::fabs(whole - cycles) / cycles : 1.0);
+		}
+		if (error < best_error) {
+			best_error = error;
+			best_length = length;
+			if (error <= MAX_FREQUENCY_ERROR) {
+				break;
+			}
+		}
+	}
+	return best_length;
+}
+
+WaveformSynth::WaveformSynth(const WAVEFORM &waveform, double sample_rate, unsigned int period) :
+	m_waveform(waveform),
+	m_sample_rate(sample_rate),
+	m_level(waveform.offset),
+	m_gain(1),
+	m_bias(0)
+{
+	if (!(sample_rate > 0)) {
+		THROW_M2K_EXCEPTION("Waveform: The sample rate must be positive", libm2k::EXC_INVALID_PARAMETER);
+	}
+
+	for (unsigned int i = 0; i < waveform.tones.size(); i++) {
+		const WAVEFORM_TONE &tone = waveform.tones.at(i);
+		if (tone.type == WAVEFORM_DC) {
+			m_level += tone.amplitude;
+			continue;
+		}
+
+		oscillator osc = {};
+		osc.type = tone.type;
+		osc.amplitude = tone.amplitude;
+		// distinct, non-zero seeds, so that the noise components are not correlated
+		osc.initial_seed = 0x9E3779B97F4A7C15ull * (i + 1);
+
+		if (isPeriodic(tone.type)) {
+			if (!(tone.frequency > 0)) {
+				THROW_M2K_EXCEPTION("Waveform: The frequency must be positive", libm2k::EXC_INVALID_PARAMETER);
+			}
+			if (tone.duty_cycle < 0 || tone.duty_cycle > 1) {
+				THROW_M2K_EXCEPTION("Waveform: The duty cycle must be between 0 and 1",
+						    libm2k::EXC_INVALID_PARAMETER);
+			}
+
+			double cycles = tone.frequency / sample_rate;
+			if (period) {
+				double whole = std::round(cycles * period);
+				if (whole < 1) {
+					THROW_M2K_EXCEPTION("Waveform: " + std::to_string(tone.frequency) +
+							    " Hz does not fit in " + std::to_string(period) +
+							    " samples; lower the sample rate", libm2k::EXC_OUT_OF_RANGE);
+				}
+				cycles = whole / period;
+			}
+			osc.increment = toPhase(cycles);
+			osc.initial_phase = toPhase(tone.phase / 360);
+			osc.duty = (tone.duty_cycle >= 1) ? UINT64_MAX : toPhase(tone.duty_cycle);
+		}
+		m_oscillators.push_back(osc);
+	}
+	reset();
+}
+
+void WaveformSynth::setConversion(double gain, double bias)
+{
+	m_gain = gain;
+	m_bias = bias;
+}
+
+void WaveformSynth::reset()
+{
+	for (oscillator &osc : m_oscillators) {
+		osc.phase = osc.initial_phase;
+		osc.seed = osc.initial_seed;
+	}
+}
+
+bool WaveformSynth::matches(const WAVEFORM &waveform, double sample_rate) const
+{
+	if (sample_rate != m_sample_rate || waveform.offset != m_waveform.offset ||
+			waveform.tones.size() != m_waveform.tones.size()) {
+		return false;
+	}
+	for (unsigned int i = 0; i < waveform.tones.size(); i++) {
+		const WAVEFORM_TONE &a = waveform.tones.at(i);
+		const WAVEFORM_TONE &b = m_waveform.tones.at(i);
+		if (a.type != b.type || a.frequency != b.frequency || a.amplitude != b.amplitude ||
+				a.phase != b.phase || a.duty_cycle != b.duty_cycle) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void WaveformSynth::generate(short *data, unsigned int nb_samples)
+{
+	m_block.resize(BLOCK_SIZE);
+	m_phases.resize(BLOCK_SIZE);
+	double *block = m_block.data();
+
+	while (nb_samples > 0) {
+		unsigned int n = std::min(nb_samples, BLOCK_SIZE);
+		std::fill(block, block + n, m_level);
+
+		for (oscillator &osc : m_oscillators) {
+			switch (osc.type) {
+			case WAVEFORM_SINE:
+				addSine(osc, block, n);
+				break;
+			case WAVEFORM_SQUARE:
+				addSquare(osc, block, n);
+				break;
+			case WAVEFORM_TRIANGLE:
+				addTriangle(osc, block, n);
+				break;
+			case WAVEFORM_SAWTOOTH:
+				addSawtooth(osc, block, n);
+				break;
+			case WAVEFORM_NOISE:
+				addNoise(osc, block, n);
+				break;
+			default:
+				break;
+			}
+		}
+
+		for (unsigned int i = 0; i < n; i++) {
+			double code = block[i] * m_gain + m_bias;
+			code = std::min(std::max(code, -2048.0), 2047.0);
+			data[i] = (short)((int)code * 16);
+		}
+		data += n;
+		nb_samples -= n;
+	}
+}
+
+const uint32_t *WaveformSynth::advance(oscillator &osc, unsigned int n)
+{
+	uint32_t *phases = m_phases.data();
+	uint64_t phase = osc.phase;
+	for (unsigned int i = 0; i < n; i++) {
+		phases[i] = (uint32_t)(phase >> 32);
+		phase += osc.increment;
+	}
+	osc.phase = phase;
+	return phases;
+}
+
+void WaveformSynth::addSine(oscillator &osc, double *block, unsigned int n)
+{
+	// Taylor series of the sine up to the 11th power, within 6e-8 on a quarter of a cycle
+	const double c1 = 6.283185307179586, c3 = -41.341702240399755, c5 = 81.60524927607504,
+		c7 = -76.70585975306136, c9 = 42.058693944897634, c11 = -15.094642576822984;
+	const uint32_t *phases = advance(osc, n);
+	for (unsigned int i = 0; i < n; i++) {
+		double x = fold(toCycles(phases[i]));
+		double x2 = x * x;
+		block[i] += osc.amplitude * x * (c1 + x2 * (c3 + x2 * (c5 + x2 * (c7 + x2 * (c9 + x2 * c11)))));
+	}
+}
+
+void WaveformSynth::addSquare(oscillator &osc, double *block, unsigned int n)
+{
+	const uint32_t duty = (uint32_t)(osc.duty >> 32);
+	const uint32_t *phases = advance(osc, n);
+	for (unsigned int i = 0; i < n; i++) {
+		block[i] += (phases[i] < duty) ? osc.amplitude : -osc.amplitude;
+	}
+}
+
+void WaveformSynth::addTriangle(oscillator &osc, double *block, unsigned int n)
+{
+	const uint32_t *phases = advance(osc, n);
+	for (unsigned int i = 0; i < n; i++) {
+		block[i] += osc.amplitude * 4 * fold(toCycles(phases[i]));
+	}
+}
+
+void WaveformSynth::addSawtooth(oscillator &osc, double *block, unsigned int n)
+{
+	const uint32_t *phases = advance(osc, n);
+	for (unsigned int i = 0; i < n; i++) {
+		block[i] += osc.amplitude * 2 * toCycles(phases[i]);
+	}
+}
+
+void WaveformSynth::addNoise(oscillator &osc, double *block, unsigned int n)
+{
+	// xorshift64*, uniform in [-1, 1)
+	uint64_t seed = osc.seed;
+	for (unsigned int i = 0; i < n; i++) {
+		seed ^= seed >> 12;
+		seed ^= seed << 25;
+		seed ^= seed >> 27;
+		block[i] += osc.amplitude * (std::ldexp((double)((seed * 0x2545F4914F6CDD1Dull) >> 11), -52) - 1);
+	}
+	osc.seed = seed;
+}
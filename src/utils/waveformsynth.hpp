@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WAVEFORMSYNTH_HPP
+#define WAVEFORMSYNTH_HPP
+
+#include <libm2k/analog/enums.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace libm2k {
+namespace utils {
+
+/*
+ * Synthesizes a WAVEFORM directly as raw DAC codes. Every periodic component runs
+ * a 64-bit phase accumulator; the samples are produced one block and one component
+ * at a time, from the top 32 bits of the phase, in loops simple enough for the
+ * compiler to vectorize.
+ */
+class WaveformSynth
+{
+public:
+	/* The length, a multiple of 4 between min_length and max_length, holding the closest
+	 * to a whole number of periods of every component; the shortest one within 1 ppm
+	 * of the requested frequencies, otherwise the most accurate one */
+	static unsigned int getCyclicLength(const libm2k::analog::WAVEFORM &waveform, double sample_rate,
+					    unsigned int min_length, unsigned int max_length);
+
+	/* With a non-zero period, the frequencies are rounded to a whole number of cycles
+	 * in period samples, so that the period repeats without a phase jump */
+	WaveformSynth(const libm2k::analog::WAVEFORM &waveform, double sample_rate, unsigned int period = 0);
+
+	/* The raw code of a voltage v is (short)(v * gain + bias) << 4, clamped to 12 bits */
+	void setConversion(double gain, double bias);
+
+	/* Write the next nb_samples codes; the phase continues from the previous call */
+	void generate(short *data, unsigned int nb_samples);
+
+	/* Restart from the initial phase of every component */
+	void reset();
+
+	bool matches(const libm2k::analog::WAVEFORM &waveform, double sample_rate) const;
+private:
+	struct oscillator {
+		libm2k::analog::WAVEFORM_TYPE type;
+		double amplitude;
+		uint64_t initial_phase;
+		uint64_t phase;
+		uint64_t increment;
+		uint64_t duty; // the square is high while the phase is below this
+		uint64_t initial_seed;
+		uint64_t seed;
+	};
+
+	/* The top 32 bits of the next n phases, in m_phases */
+	const uint32_t *advance(oscillator &osc, unsigned int n);
+	void addSine(oscillator &osc, double *block, unsigned int n);
+	void addSquare(oscillator &osc, double *block, unsigned int n);
+	void addTriangle(oscillator &osc, double *block, unsigned int n);
+	void addSawtooth(oscillator &osc, double *block, unsigned int n);
+	void addNoise(oscillator &osc, double *block, unsigned int n);
+
+	libm2k::analog::WAVEFORM m_waveform;
+	double m_sample_rate;
+	std::vector<oscillator> m_oscillators;
+	double m_level;
+	double m_gain;
+	double m_bias;
+	std::vector<double> m_block;
+	std::vector<uint32_t> m_phases;
+};
+}
+}
+
+#endif //WAVEFORMSYNTH_HPP
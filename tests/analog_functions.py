@@ -27,6 +27,10 @@ import libm2k
 import time
 from multiprocessing.pool import ThreadPool
 import os
+import shutil
+import tempfile
+import json
+import threading
 from pathlib import Path
 import pandas
 import random
@@ -141,6 +145,160 @@ def test_calibration(ctx):
     return adc_calib, dac_calib
 
 
+def test_calibration_cache(ctx):
+    # Calibrates the board, then restores the same parameters from the calibration cache
+    # Arguments:
+    #    ctx  -- M2k context
+    # Returns:
+    #    loaded -- True if the parameters were restored from the cache
+    #    restored -- True if the restored parameters match the calibrated ones
+
+    cache_dir = tempfile.mkdtemp()
+    os.environ['LIBM2K_CALIBRATION_CACHE'] = os.path.join(cache_dir, 'calibration.cache')
+    try:
+        ctx.calibrateADC()
+        ctx.calibrateDAC()
+        calibrated = [(ctx.getAdcCalibrationOffset(ch), ctx.getDacCalibrationOffset(ch)) for ch in range(2)]
+        ctx.resetCalibration()
+        start = time.time()
+        loaded = ctx.calibrateFromCache()
+        # a cache hit does not run the calibration
+        loaded = loaded and (time.time() - start) < 0.5
+        restored = calibrated == [(ctx.getAdcCalibrationOffset(ch), ctx.getDacCalibrationOffset(ch)) for ch in range(2)]
+    finally:
+        del os.environ['LIBM2K_CALIBRATION_CACHE']
+        shutil.rmtree(cache_dir, ignore_errors=True)
+    return loaded, restored
+
+
+def test_temperature_tracking(ctx):
+    # Applies the calibration interpolated from the context lookup table, then follows the board temperature
+    # Arguments:
+    #    ctx  -- M2k context
+    # Returns:
+    #    calibrated -- True if the interpolated calibration was applied
+    #    tracking -- True while the temperature is followed, then False after it was stopped
+
+    ctx.resetCalibration()
+    ctx.calibrateFromContextInterpolated()
+    calibrated = ctx.isCalibrated()
+
+    ctx.startTemperatureTracking(0.5, 100)
+    time.sleep(0.5)
+    tracking = [ctx.isTemperatureTracking()]
+    ctx.stopTemperatureTracking()
+    tracking.append(ctx.isTemperatureTracking())
+    return calibrated, tracking
+
+
+def test_metrics(ain, n):
+    # Acquires one buffer and reads the metrics collected for the ADC
+    # Arguments:
+    #    ain  -- AnalogIn object
+    #    n  -- Number of samples in the input buffer
+    # Returns:
+    #    refills -- Number of buffer refills measured for the ADC
+    #    errors -- Number of failed buffer refills
+    #    prometheus -- True if the refills are listed in the Prometheus text
+
+    libm2k.resetMetrics()
+    ain.enableChannel(libm2k.ANALOG_IN_CHANNEL_1, True)
+    ain.getSamples(n)
+
+    refills = 0
+    errors = 0
+    for metric in libm2k.getMetrics():
+        if metric.name == "buffer_refill" and metric.device == "m2k-adc":
+            refills = metric.count
+            errors = metric.errors
+    prometheus = 'libm2k_buffer_refill_seconds_count{device="m2k-adc"}' in libm2k.getPrometheusMetrics()
+    return refills, errors, prometheus
+
+
+def test_trace_export(ain, n, nb_refills=10000):
+    # Exports the trace repeatedly while another thread records more events than a thread ring holds
+    # Arguments:
+    #    ain  -- AnalogIn object
+    #    n  -- Number of samples in the input buffer
+    #    nb_refills  -- Number of buffers acquired by the tracing thread, more than the 8192 events of a ring
+    # Returns:
+    #    exports -- Number of traces exported while the other thread was recording
+    #    valid -- True if every exported trace is valid JSON
+    #    consistent -- True if the events of each thread end in the order they were recorded;
+    #                  an event mixing the fields of two records breaks that order
+
+    trig = ain.getTrigger()
+    previous_streaming = trig.getAnalogStreamingFlag()
+    trig.setAnalogStreamingFlag(True)
+    ain.enableChannel(libm2k.ANALOG_IN_CHANNEL_1, True)
+    libm2k.clearTrace()
+    libm2k.enableTracing(libm2k.TRACE_ALL)
+
+    def acquire():
+        for _ in range(nb_refills):
+            ain.getSamples(n)
+
+    tracer = threading.Thread(target=acquire)
+    tracer.start()
+    exports = 0
+    valid = True
+    consistent = True
+    while tracer.is_alive():
+        try:
+            events = json.loads(libm2k.getChromeTrace())["traceEvents"]
+        except ValueError:
+            valid = False
+            continue
+        exports += 1
+        last_end = {}
+        for event in events:
+            end = event["ts"] + event["dur"]
+            # the timestamps are printed with a precision of 1 ns
+            if end < last_end.get(event["tid"], 0) - 0.002:
+                consistent = False
+            last_end[event["tid"]] = end
+    tracer.join()
+
+    libm2k.enableTracing(libm2k.TRACE_NONE)
+    libm2k.clearTrace()
+    ain.stopAcquisition()
+    trig.setAnalogStreamingFlag(previous_streaming)
+    return exports, valid, consistent
+
+
+def test_stream_info(ain, n, streaming=True):
+    # Acquires consecutive buffers, then a buffer of another size, and reads the information of each block
+    # Arguments:
+    #    ain  -- AnalogIn object
+    #    n  -- Number of samples in the input buffer
+    #    streaming  -- Value of the analog streaming flag during the acquisition
+    # Returns:
+    #    sequences -- Sequence numbers of the blocks
+    #    first_samples -- Index of the first sample of each block
+    #    gaps -- Gap flag of each block; when streaming, only the block after the size change should be a gap
+    #    gap_count -- Number of gaps counted by the AnalogIn
+
+    trig = ain.getTrigger()
+    previous_streaming = trig.getAnalogStreamingFlag()
+    trig.setAnalogStreamingFlag(streaming)
+    ain.enableChannel(libm2k.ANALOG_IN_CHANNEL_1, True)
+    ain.stopAcquisition()
+    ain.resetStreamInfo()
+    sequences = []
+    first_samples = []
+    gaps = []
+    for size in [n, n, n, 2 * n]:
+        ain.getSamples(size)
+        block = ain.getLastBlockInfo()
+        sequences.append(block.sequence)
+        first_samples.append(block.first_sample)
+        gaps.append(block.gap)
+    gap_count = ain.getGapCount()
+    ain.stopAcquisition()
+    trig.setAnalogStreamingFlag(previous_streaming)
+    return sequences, first_samples, gaps, gap_count
+
+
 def test_amplitude(out_data, ref_data, n, ain, aout, channel, trig):
     # Sends signals with different amplitudes and verify if the received data is as expected.
     # The amplitude multiplier is defined locally.
@@ -1997,4 +2155,158 @@ def test_dual_channel_sync(
         f"all triangle minima within {tolerance} samples tolerance, and exactly "
         f"{EXPECTED_PERIODS_BEFORE_FIRST_EDGE} triangle periods before the first "
         f"falling edge",
-    )
\ No newline at end of file
+    )
+
+
+def test_samples_array(ain, aout, trig, nb_samples=4096):
+    # Pushes DC levels as numpy arrays (volts through push(), raw codes through pushRaw()) and acquires them
+    # through getSamplesArray() and getSamplesRawArray(); returns whether the arrays have the (channels, samples)
+    # layout and dtype and whether they carry the same values as the lists returned by getSamples()/getSamplesRaw()
+    reset.analog_in(ain)
+    reset.analog_out(aout)
+    reset.trigger(trig)
+    ain.setSampleRate(1000000)
+    aout.setSampleRate(0, 750000)
+    aout.setSampleRate(1, 750000)
+    aout.setCyclic(True)
+    aout.enableChannel(0, True)
+    aout.enableChannel(1, True)
+    trig.setAnalogMode(libm2k.ANALOG_IN_CHANNEL_1, libm2k.ALWAYS)
+
+    level = np.full((2, 1024), 1.5)
+    aout.push(level)
+    data = ain.getSamplesArray(nb_samples)
+    ref = ain.getSamples(nb_samples)
+    shape_ok = data.shape == (2, nb_samples) and data.dtype == np.float64
+    values_ok = all(abs(np.mean(data[ch]) - np.mean(ref[ch])) < 0.1 for ch in range(2))
+    push_ok = all(abs(np.mean(data[ch]) - 1.5) < 0.1 for ch in range(2))
+
+    raw_level = np.array([np.full(1024, aout.convertVoltsToRaw(ch, -1.0), dtype=np.int16) for ch in range(2)])
+    aout.pushRaw(raw_level)
+    raw = ain.getSamplesRawArray(nb_samples)
+    raw_ref = ain.getSamplesRaw(nb_samples)
+    raw_shape_ok = raw.shape == (2, nb_samples) and raw.dtype == np.int16
+    raw_values_ok = all(abs(np.mean(raw[ch]) - np.mean(raw_ref[ch])) < 20 for ch in range(2))
+    volts = [ain.convertRawToVolts(ch, int(np.mean(raw[ch]))) for ch in range(2)]
+    push_raw_ok = all(abs(v + 1.0) < 0.1 for v in volts)
+
+    aout.stop()
+    return shape_ok, values_ok, push_ok, raw_shape_ok, raw_values_ok, push_raw_ok
+
+
+def test_waveform(ain, aout, trig, channel, frequency=1000, amplitude=2, offset=0.5, nb_samples=8192):
+    # Generates a sine with pushWaveform() on the given channel and measures it through the loopback;
+    # returns the peak to peak amplitude, the mean and the frequency of the acquired signal
+    reset.analog_in(ain)
+    reset.analog_out(aout)
+    reset.trigger(trig)
+    ain.setSampleRate(1000000)
+    ain.enableChannel(channel, True)
+    aout.setSampleRate(channel, 7500000)
+    aout.setCyclic(True)
+    aout.enableChannel(channel, True)
+
+    tone = libm2k.WAVEFORM_TONE()
+    tone.type = libm2k.WAVEFORM_SINE
+    tone.frequency = frequency
+    tone.amplitude = amplitude
+    tone.phase = 0
+    tone.duty_cycle = 0.5
+    waveform = libm2k.WAVEFORM()
+    waveform.tones = libm2k.WaveformTones([tone])
+    waveform.offset = offset
+    aout.pushWaveform(channel, waveform)
+    trig.setAnalogMode(channel, libm2k.ALWAYS)
+
+    data = np.asarray(ain.getSamples(nb_samples)[channel])
+    aout.stop()
+    spectrum = np.abs(np.fft.rfft(data - np.mean(data)))
+    measured_frequency = np.argmax(spectrum) * ain.getSampleRate() / nb_samples
+    return np.max(data) - np.min(data), np.mean(data), measured_frequency
+
+
+def test_waveform_cache(aout, nb_samples=4096):
+    # Alternates between two cyclic waveforms on channel 0 and returns the hits and misses of the waveform
+    # cache, before and after changing the sample rate
+    reset.analog_out(aout)
+    aout.setSampleRate(0, 750000)
+    aout.setCyclic(True)
+    aout.enableChannel(0, True)
+    aout.clearWaveformCache()
+    first = np.linspace(-1, 1, nb_samples)
+    second = np.linspace(1, -1, nb_samples)
+    for data in [first, second, first, second]:
+        aout.push(0, data)
+    stats = aout.getWaveformCacheStats()
+    same_rate = (stats.hits, stats.misses)
+
+    aout.setSampleRate(0, 7500000)
+    aout.push(0, first)
+    stats = aout.getWaveformCacheStats()
+    aout.stop()
+    return same_rate, (stats.hits, stats.misses)
+
+
+def test_sequence(aout, buffer_size=4096):
+    # Streams a short sequence of two DC levels on channel 0, then a long one which is stopped early;
+    # returns whether the first one finished and whether the second one stopped well before its end
+    reset.analog_out(aout)
+    aout.setSampleRate(0, 750000)
+    aout.enableChannel(0, True)
+
+    def segment(level, repeat):
+        s = libm2k.SEQUENCE_SEGMENT()
+        s.samples = libm2k.VectorD([level] * 1024)
+        s.repeat = repeat
+        s.wait_trigger = False
+        return s
+
+    short = aout.runSequence(0, libm2k.SequenceSegments([segment(1, 10), segment(-1, 10)]), buffer_size)
+    finished = short.waitFor(5000)
+
+    # about 28 seconds of samples
+    start = time.time()
+    long = aout.runSequence(0, libm2k.SequenceSegments([segment(1, 10000), segment(-1, 10000)]), buffer_size)
+    time.sleep(0.5)
+    aout.stopSequence()
+    stopped = long.waitFor(5000) and time.time() - start < 10
+    aout.stop()
+    return finished, stopped
+
+
+def test_segments(ain, aout, trig, channel, nb_segments=8, nb_samples=1000, frequency=100):
+    # Generates a square wave and acquires segments triggered on its rising edges; returns the number of
+    # segments, whether each segment starts high, whether the timestamps increase and whether the blocks
+    # of the segments follow each other
+    reset.analog_in(ain)
+    reset.analog_out(aout)
+    reset.trigger(trig)
+    ain.setSampleRate(100000)
+    ain.enableChannel(channel, True)
+    ain.setKernelBuffersCount(4)
+    aout.setSampleRate(channel, 750000)
+    aout.setCyclic(True)
+    aout.enableChannel(channel, True)
+
+    tone = libm2k.WAVEFORM_TONE()
+    tone.type = libm2k.WAVEFORM_SQUARE
+    tone.frequency = frequency
+    tone.amplitude = 2
+    tone.phase = 0
+    tone.duty_cycle = 0.5
+    waveform = libm2k.WAVEFORM()
+    waveform.tones = libm2k.WaveformTones([tone])
+    waveform.offset = 0
+    aout.pushWaveform(channel, waveform)
+    set_trig(trig, channel, 0, libm2k.RISING_EDGE_ANALOG, 0)
+
+    segments = ain.getSegments(nb_segments, nb_samples)
+    aout.stop()
+    reset.trigger(trig)
+
+    starts_high = all(np.mean(np.asarray(s.samples[channel])[10:100]) > 0.5 for s in segments)
+    timestamps = np.array([s.info.timestamp for s in segments])
+    increasing = bool(np.all(np.diff(timestamps) >= 0))
+    sequences = np.array([s.info.sequence for s in segments])
+    consecutive = bool(np.all(np.diff(sequences) == 1))
+    return len(segments), starts_high, increasing, consecutive
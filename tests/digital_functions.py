@@ -582,4 +582,154 @@ def test_last_sample_hold(dig: libm2k.M2kDigital, trig: libm2k.M2kHardwareTrigge
             filename=f"last_sample_hold_DIO_{chn_str}_step{2}.png",
             xlabel='Samples', ylabel='DIO channel'
         )
-    return result_step1 and result_step2
\ No newline at end of file
+    return result_step1 and result_step2
+
+def test_digital_pattern(dig, channel, nb_samples=4096):
+    # Pushes a cyclic square wave given as a pattern of two steps and returns the fraction of samples read high
+    # on the channel and the number of rising edges
+    reset.digital(dig)
+    dig.setDirection(channel, libm2k.DIO_OUTPUT)
+    dig.enableChannel(channel, True)
+    dig.setCyclic(True)
+    dig.setSampleRateOut(1000000)
+    dig.setSampleRateIn(1000000)
+
+    high = libm2k.DIGITAL_PATTERN_STEP()
+    high.value = 1 << channel
+    high.duration = 512
+    low = libm2k.DIGITAL_PATTERN_STEP()
+    low.value = 0
+    low.duration = 512
+    dig.pushPattern(libm2k.DigitalPatternSteps([high, low]))
+
+    data = np.asarray(dig.getSamples(nb_samples))
+    dig.stopBufferOut()
+    dig.stopAcquisition()
+    ch = (data >> channel) & 1
+    rising_edges = np.count_nonzero(np.diff(ch) == 1)
+    return np.mean(ch), rising_edges
+
+
+def test_digital_transitions(dig, channel, nb_samples=4096):
+    # Pushes a cyclic square wave and captures it as a list of transitions; returns the number of rising edges
+    # found on the channel, the number found by scanning the raw samples and whether the expanded capture matches
+    # the raw samples
+    reset.digital(dig)
+    dig.setDirection(channel, libm2k.DIO_OUTPUT)
+    dig.enableChannel(channel, True)
+    dig.setCyclic(True)
+    dig.setSampleRateOut(1000000)
+    dig.setSampleRateIn(1000000)
+
+    high = libm2k.DIGITAL_PATTERN_STEP()
+    high.value = 1 << channel
+    high.duration = 256
+    low = libm2k.DIGITAL_PATTERN_STEP()
+    low.value = 0
+    low.duration = 256
+    dig.pushPattern(libm2k.DigitalPatternSteps([high, low]))
+
+    transitions = dig.getTransitions(nb_samples)
+    dig.stopBufferOut()
+    dig.stopAcquisition()
+    data = np.asarray(transitions.getSamples(0, transitions.getNbSamples()))
+    ch = (data >> channel) & 1
+    rising_edges = len(transitions.getEdges(channel, libm2k.RISING_EDGE_DIGITAL))
+    expected_edges = np.count_nonzero(np.diff(ch) == 1)
+    values_match = all(transitions.getValue(t.sample) == data[t.sample] for t in transitions.getTransitions())
+    return rising_edges, expected_edges, values_match
+
+
+def test_digital_bit_planes(dig, value=0xA53C, nb_samples=4096):
+    # Pushes a constant value on all the channels and reads it back split per channel; returns whether the
+    # channel arrays, the packed bit planes and the planes extracted from the raw samples hold the value
+    reset.digital(dig)
+    for i in range(16):
+        dig.setDirection(i, libm2k.DIO_OUTPUT)
+        dig.enableChannel(i, True)
+    dig.setCyclic(True)
+    dig.setSampleRateOut(1000000)
+    dig.setSampleRateIn(1000000)
+
+    step = libm2k.DIGITAL_PATTERN_STEP()
+    step.value = value
+    step.duration = 1024
+    dig.pushPattern(libm2k.DigitalPatternSteps([step]))
+
+    expected = np.array([(value >> i) & 1 for i in range(16)], dtype=np.uint8)
+    channels = dig.getChannelsArray(nb_samples)
+    channels_ok = channels.shape == (16, nb_samples) and np.array_equal(channels, np.repeat(expected[:, None], nb_samples, axis=1))
+
+    planes = dig.getBitPlanesArray(nb_samples)
+    bits = np.unpackbits(planes.view(np.uint8), axis=1, bitorder='little')[:, :nb_samples]
+    planes_ok = np.array_equal(bits, np.repeat(expected[:, None], nb_samples, axis=1))
+
+    samples = dig.getSamplesArray(nb_samples)
+    extracted = libm2k.extractChannelsArray(samples)
+    masked = np.array([(samples >> i) & 1 for i in range(16)], dtype=np.uint8)
+    extract_ok = np.array_equal(extracted, masked)
+
+    dig.stopBufferOut()
+    dig.stopAcquisition()
+    return channels_ok, planes_ok, extract_ok
+
+
+def test_digital_segments(dig, channel, nb_segments=8, nb_samples=256):
+    # Pushes a cyclic square wave and acquires segments triggered on its rising edges; returns the number of
+    # segments, whether each segment starts high on the channel, whether the timestamps increase and whether
+    # the blocks of the segments follow each other
+    reset.digital(dig)
+    dig.setDirection(channel, libm2k.DIO_OUTPUT)
+    dig.enableChannel(channel, True)
+    dig.setCyclic(True)
+    dig.setSampleRateOut(1000000)
+    dig.setSampleRateIn(1000000)
+    d_trig = dig.getTrigger()
+    d_trig.reset()
+    d_trig.setDigitalMode(0)
+    for j in range(16):
+        d_trig.setDigitalCondition(j, libm2k.NO_TRIGGER_DIGITAL)
+    d_trig.setDigitalCondition(channel, libm2k.RISING_EDGE_DIGITAL)
+    d_trig.setDigitalDelay(0)
+
+    high = libm2k.DIGITAL_PATTERN_STEP()
+    high.value = 1 << channel
+    high.duration = 512
+    low = libm2k.DIGITAL_PATTERN_STEP()
+    low.value = 0
+    low.duration = 512
+    dig.pushPattern(libm2k.DigitalPatternSteps([high, low]))
+
+    segments = dig.getSegments(nb_segments, nb_samples)
+    dig.stopBufferOut()
+    dig.stopAcquisition()
+    d_trig.setDigitalCondition(channel, libm2k.NO_TRIGGER_DIGITAL)
+
+    starts_high = all(np.all((np.asarray(s.samples)[8:200] >> channel) & 1) for s in segments)
+    timestamps = np.array([s.info.timestamp for s in segments])
+    increasing = bool(np.all(np.diff(timestamps) >= 0))
+    sequences = np.array([s.info.sequence for s in segments])
+    consecutive = bool(np.all(np.diff(sequences) == 1))
+    return len(segments), starts_high, increasing, consecutive
+
+
+def test_digital_samples_array(dig, nb_samples=4096):
+    # Pushes a numpy array alternating between two values on all the channels and reads it back through
+    # getSamplesArray(); returns whether the array is a uint16 array of nb_samples values and whether it only
+    # holds the pushed values, both of them
+    reset.digital(dig)
+    for i in range(16):
+        dig.setDirection(i, libm2k.DIO_OUTPUT)
+        dig.enableChannel(i, True)
+    dig.setCyclic(True)
+    dig.setSampleRateOut(1000000)
+    dig.setSampleRateIn(1000000)
+
+    values = np.repeat(np.array([0xA53C, 0x5AC3], dtype=np.uint16), 512)
+    dig.push(values)
+    data = dig.getSamplesArray(nb_samples)
+    dig.stopBufferOut()
+    dig.stopAcquisition()
+    shape_ok = data.shape == (nb_samples,) and data.dtype == np.uint16
+    values_ok = set(np.unique(data)) == {0xA53C, 0x5AC3}
+    return shape_ok, values_ok
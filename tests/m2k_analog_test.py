@@ -42,6 +42,16 @@ from analog_functions import (
     set_samplerates_for_shapetest,
     set_trig_for_cyclicbuffer_test,
     test_calibration,
+    test_calibration_cache,
+    test_temperature_tracking,
+    test_metrics,
+    test_trace_export,
+    test_stream_info,
+    test_samples_array,
+    test_waveform,
+    test_waveform_cache,
+    test_sequence,
+    test_segments,
 )
 from analog_functions import (
     compare_in_out_frequency,
@@ -90,6 +100,70 @@ class A_AnalogTests(unittest.TestCase):
         calibration = test_calibration(ctx)
         with self.subTest(msg='Test if ADC and DAC were succesfully calibrated'):
             self.assertEqual(calibration, (True, True), 'Calibration failed')
+        phases = [timing.phase for timing in ctx.getCalibrationTimings()]
+        with self.subTest(msg='Test if the DAC calibration phases were timed'):
+            self.assertEqual(phases, ['dac_setup', 'dac_offset', 'dac_gain', 'total'], 'Calibration timing report')
+
+    def test_calibration_cache(self):
+        # Verify through test_calibration_cache() if the calibration parameters are restored from the cache.
+
+        loaded, restored = test_calibration_cache(ctx)
+        with self.subTest(msg='Test if the calibration was loaded from the cache'):
+            self.assertEqual(loaded, True, 'Calibration not loaded from the cache')
+        with self.subTest(msg='Test if the cached calibration parameters were restored'):
+            self.assertEqual(restored, True, 'Cached calibration parameters differ')
+
+    @unittest.skipIf(not ctx.hasContextCalibration(), 'The board has no calibration lookup table')
+    def test_temperature_tracking(self):
+        # Verify through test_temperature_tracking() if the interpolated calibration is applied and followed.
+
+        calibrated, tracking = test_temperature_tracking(ctx)
+        with self.subTest(msg='Test if the interpolated calibration was applied'):
+            self.assertEqual(calibrated, True, 'Interpolated calibration not applied')
+        with self.subTest(msg='Test if the temperature tracking starts and stops'):
+            self.assertEqual(tracking, [True, False], 'Temperature tracking state')
+
+    def test_metrics(self):
+        # Verify through test_metrics() if the buffer refills of the ADC are measured.
+
+        refills, errors, prometheus = test_metrics(ain, 1024)
+        with self.subTest(msg='Test if the buffer refill was measured'):
+            self.assertEqual(refills, 1, 'Buffer refills measured')
+        with self.subTest(msg='Test if the buffer refill succeeded'):
+            self.assertEqual(errors, 0, 'Buffer refill errors measured')
+        with self.subTest(msg='Test if the refills are exported in the Prometheus text'):
+            self.assertEqual(prometheus, True, 'Buffer refills not exported')
+
+    def test_trace_export(self):
+        # Verify through test_trace_export() if an export while another thread wraps its ring has no mixed events.
+
+        exports, valid, consistent = test_trace_export(ain, 64)
+        with self.subTest(msg='Test if the trace was exported while the other thread recorded'):
+            self.assertGreater(exports, 0, 'Traces exported')
+        with self.subTest(msg='Test if the exported traces are valid JSON'):
+            self.assertEqual(valid, True, 'Invalid trace')
+        with self.subTest(msg='Test if no exported event mixes two records'):
+            self.assertEqual(consistent, True, 'Inconsistent trace events')
+
+    def test_stream_info(self):
+        # Verify through test_stream_info() if the acquired blocks are numbered and the restart is flagged.
+
+        n = 1024
+        sequences, first_samples, gaps, gap_count = test_stream_info(ain, n)
+        with self.subTest(msg='Test the sequence numbers of the blocks'):
+            self.assertEqual(sequences, [0, 1, 2, 3], 'Block sequence numbers')
+        with self.subTest(msg='Test the index of the first sample of each block'):
+            self.assertEqual(first_samples, [0, n, 2 * n, 3 * n], 'Block first samples')
+        with self.subTest(msg='Test if only the restarted acquisition is a gap'):
+            self.assertEqual(gaps, [False, False, False, True], 'Block gaps')
+            self.assertEqual(gap_count, 1, 'Gap count')
+
+        sequences, first_samples, gaps, gap_count = test_stream_info(ain, n, streaming=False)
+        with self.subTest(msg='Test if each triggered block starts its own count of samples'):
+            self.assertEqual(first_samples, [0, 0, 0, 0], 'Triggered block first samples')
+        with self.subTest(msg='Test if the triggered blocks do not follow each other'):
+            self.assertEqual(gaps, [False, True, True, True], 'Triggered block gaps')
+            self.assertEqual(gap_count, 3, 'Triggered gap count')
 
     def test_kernel_buffers(self):
         # Verifies if the kernel buffer count can be set without throwing runtime error (busy retry works)
@@ -98,6 +172,59 @@ class A_AnalogTests(unittest.TestCase):
             msg='Set kernel buffers count on AIN without raising an error '):
             self.assertEqual(test_err, False, 'Error occured')
 
+    def test_samples_array(self):
+        # Verifies that the numpy based acquisition and push methods behave like their list based counterparts
+        shape_ok, values_ok, push_ok, raw_shape_ok, raw_values_ok, push_raw_ok = test_samples_array(ain, aout, trig)
+        with self.subTest(msg='getSamplesArray returns a (channels, samples) float64 array'):
+            self.assertEqual(shape_ok, True, 'Unexpected array shape or dtype')
+        with self.subTest(msg='getSamplesArray matches getSamples'):
+            self.assertEqual(values_ok, True, 'Array values differ from list values')
+        with self.subTest(msg='push with a numpy array'):
+            self.assertEqual(push_ok, True, 'Level pushed as a numpy array not read back')
+        with self.subTest(msg='getSamplesRawArray returns a (channels, samples) int16 array'):
+            self.assertEqual(raw_shape_ok, True, 'Unexpected raw array shape or dtype')
+        with self.subTest(msg='getSamplesRawArray matches getSamplesRaw'):
+            self.assertEqual(raw_values_ok, True, 'Raw array values differ from list values')
+        with self.subTest(msg='pushRaw with a numpy array'):
+            self.assertEqual(push_raw_ok, True, 'Raw level pushed as a numpy array not read back')
+
+    def test_waveform(self):
+        # Verifies the amplitude, offset and frequency of a sine synthesized by pushWaveform()
+        for channel in [libm2k.ANALOG_IN_CHANNEL_1, libm2k.ANALOG_IN_CHANNEL_2]:
+            peak_to_peak, mean, frequency = test_waveform(ain, aout, trig, channel)
+            with self.subTest(msg='Waveform amplitude on channel ' + str(channel)):
+                self.assertAlmostEqual(peak_to_peak, 4, delta=0.2, msg='Peak to peak amplitude')
+            with self.subTest(msg='Waveform offset on channel ' + str(channel)):
+                self.assertAlmostEqual(mean, 0.5, delta=0.1, msg='Offset')
+            with self.subTest(msg='Waveform frequency on channel ' + str(channel)):
+                self.assertAlmostEqual(frequency, 1000, delta=250, msg='Frequency')
+
+    def test_waveform_cache(self):
+        # Verifies that pushing a cyclic waveform again reuses its raw buffer, unless the sample rate changed
+        same_rate, new_rate = test_waveform_cache(aout)
+        with self.subTest(msg='Waveforms pushed again are cache hits'):
+            self.assertEqual(same_rate, (2, 2), 'Hits and misses')
+        with self.subTest(msg='A new sample rate is a cache miss'):
+            self.assertEqual(new_rate, (2, 3), 'Hits and misses')
+
+    def test_sequence(self):
+        # Verifies that a sequence streams in the background and that it can be stopped
+        finished, stopped = test_sequence(aout)
+        with self.subTest(msg='The sequence finishes'):
+            self.assertEqual(finished, True, 'Sequence still running')
+        with self.subTest(msg='The sequence stops early when requested'):
+            self.assertEqual(stopped, True, 'Sequence not stopped')
+
+    def test_segments(self):
+        # Verifies that a segmented acquisition returns one segment for each trigger event, in order
+        for i in [libm2k.ANALOG_IN_CHANNEL_1, libm2k.ANALOG_IN_CHANNEL_2]:
+            nb_segments, starts_high, increasing, consecutive = test_segments(ain, aout, trig, i)
+            with self.subTest(i):
+                self.assertEqual(nb_segments, 8, 'Number of segments')
+                self.assertEqual(starts_high, True, 'Segments not aligned on the rising edges')
+                self.assertEqual(increasing, True, 'Timestamps not increasing')
+                self.assertEqual(consecutive, True, 'Blocks not consecutive')
+
     def test_shapes_ch0(self):
         # Verifies that all the elements of a correlation vector  returned by test_shape() are greater than 0.85. A
         # correlation coefficient greater 0.7 indicates that there is a strong positive linear relationship between
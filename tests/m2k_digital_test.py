@@ -29,6 +29,11 @@ from digital_functions import (
     test_kernel_buffers,
     test_last_sample_hold,
     test_pattern_generator_pulse,
+    test_digital_pattern,
+    test_digital_transitions,
+    test_digital_bit_planes,
+    test_digital_segments,
+    test_digital_samples_array,
 )
 from digital_functions import test_digital_cyclic_buffer
 import reset_def_values as reset
@@ -73,6 +78,51 @@ class D_DigitalTests(unittest.TestCase):
             with self.subTest(i):
                 self.assertEqual(test_digital_cyclic_buffer(dig, d_trig, i), 0, "Channel: " + str(i))
 
+    def test_digital_samples_array(self):
+        # Verifies that push() with a numpy array and getSamplesArray() carry the samples unchanged
+        shape_ok, values_ok = test_digital_samples_array(dig)
+        with self.subTest("shape"):
+            self.assertTrue(shape_ok, "getSamplesArray returns a uint16 array of nb_samples values")
+        with self.subTest("values"):
+            self.assertTrue(values_ok, "Values pushed as a numpy array not read back")
+
+    def test_digital_pattern(self):
+        # Verifies that a pattern of values and durations is expanded into the expected square wave
+        for i in range(16):
+            duty, rising_edges = test_digital_pattern(dig, i)
+            with self.subTest(i):
+                self.assertAlmostEqual(duty, 0.5, delta=0.05, msg="Duty cycle on channel: " + str(i))
+                self.assertIn(rising_edges, [3, 4, 5], "Rising edges on channel: " + str(i))
+
+    def test_digital_transitions(self):
+        # Verifies that a capture stored as a list of transitions reports the edges of the pushed square wave
+        for i in range(16):
+            rising_edges, expected_edges, values_match = test_digital_transitions(dig, i)
+            with self.subTest(i):
+                self.assertIn(rising_edges, [7, 8, 9], "Rising edges on channel: " + str(i))
+                self.assertEqual(rising_edges, expected_edges, "Edges of the expanded capture on channel: " + str(i))
+                self.assertTrue(values_match, "Values at the transitions on channel: " + str(i))
+
+    def test_digital_bit_planes(self):
+        # Verifies that the samples split per channel, as bytes or packed bit planes, hold the value read back
+        channels_ok, planes_ok, extract_ok = test_digital_bit_planes(dig)
+        with self.subTest("channels"):
+            self.assertTrue(channels_ok, "getChannelsArray")
+        with self.subTest("planes"):
+            self.assertTrue(planes_ok, "getBitPlanesArray")
+        with self.subTest("extract"):
+            self.assertTrue(extract_ok, "extractChannelsArray")
+
+    def test_digital_segments(self):
+        # Verifies that a segmented acquisition returns one segment for each trigger event, in order
+        for i in range(16):
+            nb_segments, starts_high, increasing, consecutive = test_digital_segments(dig, i)
+            with self.subTest(i):
+                self.assertEqual(nb_segments, 8, "Number of segments on channel: " + str(i))
+                self.assertTrue(starts_high, "Segments not aligned on the rising edges on channel: " + str(i))
+                self.assertTrue(increasing, "Timestamps not increasing on channel: " + str(i))
+                self.assertTrue(consecutive, "Blocks not consecutive on channel: " + str(i))
+
     def test_kernel_buffers(self):
         # Verifies if the kernel buffer count can be set without throwing runtime error (busy retry works)
         test_err = test_kernel_buffers(dig, 4)
@@ -22,7 +22,7 @@ import unittest
 import sys
 from open_context import ain, aout, ctx, ps
 import reset_def_values as reset
-from ps_functions import ps_test_negative, ps_test_positive, config_for_ps_test
+from ps_functions import ps_test_negative, ps_test_positive, ps_test_monitor, ps_test_sequence, config_for_ps_test
 import logger
 import main
 from repeat_test import repeat
@@ -68,3 +68,17 @@ class C_PowerSupplyTests(unittest.TestCase):
         neg_supply = ps_test_negative(ps, ain)
         with self.subTest(msg='Test the negative  Power Supply'):
             self.assertEqual(all(neg_supply), 1, 'negative power supply')
+
+    def test_power_supply_monitor(self):
+        #  Verifies the background monitor of the Power supply through ps_test_monitor().
+
+        monitor = ps_test_monitor(ps)
+        with self.subTest(msg='Test the Power Supply monitor'):
+            self.assertEqual(all(monitor), 1, 'power supply monitor')
+
+    def test_power_supply_sequence(self):
+        #  Verifies the ramp and sequence engine of the Power supply through ps_test_sequence().
+
+        sequence = ps_test_sequence(ps, ain)
+        with self.subTest(msg='Test the Power Supply sequence'):
+            self.assertEqual(all(sequence), 1, 'power supply sequence')
@@ -125,6 +125,88 @@ def ps_test_negative(ps, ain):
     return neg_supply
 
 
+def ps_test_monitor(ps):
+    # Tests the power supply monitor: samples, statistics and threshold callbacks
+    # Arguments:
+    #    ps -- Power Supply object
+    # Returns:
+    #    result-- Vector that holds 1 for each check that passed
+
+    t = 0.1  # threshold value
+    voltage = 2.5
+    result = []
+    triggered = []
+    ps.pushChannel(libm2k.ANALOG_IN_CHANNEL_1, voltage)
+    time.sleep(0.2)
+    ps.setMonitorThreshold(libm2k.ANALOG_IN_CHANNEL_1, voltage - t, voltage + t,
+                           lambda chn, value: triggered.append((chn, value)))
+    ps.startMonitoring(10, 256)
+    time.sleep(0.5)
+    stats = ps.getMonitorStatistics(libm2k.ANALOG_IN_CHANNEL_1)
+    result = np.append(result, 1 if stats.count > 0 else 0)
+    result = np.append(result, 1 if (voltage - t) <= stats.min <= stats.mean <= stats.max <= (voltage + t) else 0)
+    result = np.append(result, 1 if len(triggered) == 0 else 0)
+
+    # leaving the window calls the callback once
+    ps.pushChannel(libm2k.ANALOG_IN_CHANNEL_1, voltage + 1)
+    time.sleep(0.5)
+    ps.stopMonitoring()
+    result = np.append(result, 1 if len(triggered) == 1 and triggered[0][0] == libm2k.ANALOG_IN_CHANNEL_1 else 0)
+
+    samples = ps.readMonitorSamples()
+    timestamps = [sample.timestamp for sample in samples]
+    result = np.append(result, 1 if len(samples) > 0 and timestamps == sorted(timestamps) else 0)
+    result = np.append(result, 1 if len(ps.readMonitorSamples()) == 0 else 0)
+    ps.clearMonitorThreshold(libm2k.ANALOG_IN_CHANNEL_1)
+    return result
+
+
+def ps_test_sequence(ps, ain):
+    # Tests the power supply sequence engine: ramp timing, readback and cancellation
+    # Arguments:
+    #    ps -- Power Supply object
+    #    ain -- AnalogIn object
+    # Returns:
+    #    result-- Vector that holds 1 for each check that passed
+
+    t = 0.1  # threshold value
+    result = []
+    ain.setRange(libm2k.ANALOG_IN_CHANNEL_1, libm2k.PLUS_MINUS_25V)
+    ain.setRange(libm2k.ANALOG_IN_CHANNEL_2, libm2k.PLUS_MINUS_25V)
+    ps.pushChannel(libm2k.ANALOG_IN_CHANNEL_1, 0)
+    ps.pushChannel(libm2k.ANALOG_IN_CHANNEL_2, 0)
+    time.sleep(0.2)
+
+    # V+ ramps to 3V at 10V/s, then V- jumps to -3V once V+ is within the tolerance
+    pos = libm2k.POWER_SUPPLY_STEP()
+    pos.channel, pos.target, pos.slew_rate, pos.dwell, pos.tolerance, pos.settle_timeout = 0, 3, 10, 0.1, t, 1
+    neg = libm2k.POWER_SUPPLY_STEP()
+    neg.channel, neg.target, neg.slew_rate, neg.dwell, neg.tolerance, neg.settle_timeout = 1, -3, 0, 0, t, 1
+    start = time.time()
+    ps.runSequence([pos, neg]).wait()
+    duration = time.time() - start
+    result = np.append(result, 1 if 0.3 <= duration <= 1 else 0)
+    voltages = ain.getVoltage()
+    result = np.append(result, 1 if (3 - t) <= voltages[libm2k.ANALOG_IN_CHANNEL_1] <= (3 + t) else 0)
+    result = np.append(result, 1 if (-3 - t) <= voltages[libm2k.ANALOG_IN_CHANNEL_2] <= (-3 + t) else 0)
+
+    # a cancelled ramp stops on the way and its handle reports an error
+    operation = ps.rampChannel(libm2k.ANALOG_IN_CHANNEL_1, 0, 1)
+    time.sleep(0.5)
+    ps.cancelSequence()
+    try:
+        operation.wait()
+        result = np.append(result, 0)
+    except Exception:
+        result = np.append(result, 1)
+    time.sleep(0.1)
+    voltage = ain.getVoltage()[libm2k.ANALOG_IN_CHANNEL_1]
+    result = np.append(result, 1 if 1 < voltage < 3 else 0)
+    ps.pushChannel(libm2k.ANALOG_IN_CHANNEL_1, 0)
+    ps.pushChannel(libm2k.ANALOG_IN_CHANNEL_2, 0)
+    return result
+
+
 def write_file(file, read_voltages, sent_voltages,positive ):
     if positive:
         file.write("\n\nPositive power supply test:\n")
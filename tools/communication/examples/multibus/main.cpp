@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <libm2k/m2k.hpp>
+#include <libm2k/contextbuilder.hpp>
+#include <libm2k/analog/m2kpowersupply.hpp>
+#include <libm2k/tools/i2c.hpp>
+#include <libm2k/tools/i2c_extra.hpp>
+#include <libm2k/tools/multibus.hpp>
+#include <iostream>
+
+
+/*
+ * This example reads two EVAL-ADT7420-PMDZ boards at the same time, each one on its own I2C bus
+ * Hardware configuration, for the first board:
+ * 	(ADALM2000) DIO_0 <---> Pin 1 (ADT7420) <--->  10 kilohms resistor <--- V+ (ADALM2000)
+ * 	(ADALM2000) DIO_1 <---> Pin 3 (ADT7420) <---> 10 kilohms resistor <--- V+ (ADALM2000)
+ * 	(ADALM2000) GND <---> Pin 5 (ADT7420)
+ * 	(ADALM2000) V+ ---> Pin 7 (ADT7420)
+ * and the same for the second board, using DIO_2 as SCL and DIO_3 as SDA
+*/
+
+#define NB_BUSES 2
+
+
+float convertTemperature(uint8_t *data)
+{
+	uint16_t temp = ((uint16_t)data[0] << 8u) + data[1];
+	if (temp & 0x8000) {
+		/*! Negative temperature */
+		return (float) ((int32_t) temp - 65536) / 128;
+	}
+	/*! Positive temperature */
+	return (float) temp / 128;
+}
+
+int main()
+{
+	libm2k::context::M2k *context = libm2k::context::m2kOpen("ip:192.168.2.1");
+	if (!context) {
+		std::cout << "Connection Error: No ADALM2000 device available/connected to your PC.\n";
+		return -1;
+	}
+
+	libm2k::analog::M2kPowerSupply *powerSupply = context->getPowerSupply();
+	powerSupply->enableChannel(0, true);
+	powerSupply->pushChannel(0, 3.3);
+
+	m2k_i2c_init m2KI2CInit[NB_BUSES];
+	i2c_init_param i2CInitParam[NB_BUSES];
+	i2c_desc *desc[NB_BUSES];
+	for (unsigned int i = 0; i < NB_BUSES; i++) {
+		m2KI2CInit[i].scl = 2 * i;
+		m2KI2CInit[i].sda = 2 * i + 1;
+		m2KI2CInit[i].context = context;
+
+		i2CInitParam[i].max_speed_hz = 100000;
+		i2CInitParam[i].slave_address = 0x48;
+		i2CInitParam[i].extra = (void*)&m2KI2CInit[i];
+
+		if (i2c_init(&desc[i], &i2CInitParam[i]) == -1) {
+			std::cout << "I2C Error: Could not configure I2C bus " << i << "\n";
+			return -1;
+		}
+	}
+
+	uint8_t dataWrite[NB_BUSES][1] = {{0}, {0}};
+	uint8_t dataRead[NB_BUSES][2] = {{0, 0}, {0, 0}};
+	multibus_transfer writes[NB_BUSES];
+	multibus_transfer reads[NB_BUSES];
+	for (unsigned int i = 0; i < NB_BUSES; i++) {
+		//select the temperature register; 7-bit addressing and repeated start
+		writes[i] = multibus_transfer();
+		writes[i].protocol = MULTIBUS_I2C;
+		writes[i].operation = MULTIBUS_WRITE;
+		writes[i].i2c = desc[i];
+		writes[i].data = dataWrite[i];
+		writes[i].bytes_number = sizeof(dataWrite[i]);
+		writes[i].option = i2c_general_call | i2c_repeated_start;
+
+		//read the temperature; only 7-bit addressing
+		reads[i] = multibus_transfer();
+		reads[i].protocol = MULTIBUS_I2C;
+		reads[i].operation = MULTIBUS_READ;
+		reads[i].i2c = desc[i];
+		reads[i].data = dataRead[i];
+		reads[i].bytes_number = sizeof(dataRead[i]);
+		reads[i].option = i2c_general_call;
+	}
+
+	std::cout << "Reading the temperatures . . .\n";
+	multibus_run(writes, NB_BUSES);
+	multibus_run(reads, NB_BUSES);
+
+	for (unsigned int i = 0; i < NB_BUSES; i++) {
+		if (reads[i].status != 0) {
+			std::cout << "Bus " << i << ": I2C Error: Could not read the temperature\n";
+			continue;
+		}
+		std::cout << "Bus " << i << ": Temperature: " << convertTemperature(dataRead[i]) << "\u2103\n";
+	}
+
+	for (unsigned int i = 0; i < NB_BUSES; i++) {
+		i2c_remove(desc[i]);
+	}
+	libm2k::context::contextClose(context, true);
+	return 0;
+}
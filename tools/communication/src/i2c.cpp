@@ -33,13 +33,16 @@
 #include <libm2k/tools/i2c.hpp>
 #include <libm2k/tools/i2c_extra.hpp>
 #include "utils/util.h"
+#include "utils/codec.h"
 #include <libm2k/m2k.hpp>
 #include <libm2k/contextbuilder.hpp>
 #include <libm2k/m2khardwaretrigger.hpp>
-#include <thread>
-#include <atomic>
+#include "utils/metrics.hpp"
 
 constexpr unsigned int samplesPerCycle = 4;
+//more samples per cycle are used only when the clock would otherwise run over 10% slower than requested
+constexpr unsigned int maxSamplesPerCycle = 64;
+constexpr double maxSpeedError = 0.1;
 constexpr uint8_t condition10BitAddressing = 0x1E;
 
 typedef struct i2c_data {
@@ -175,11 +178,11 @@ static void writeAddress(struct i2c_desc *desc, std::vector<unsigned short> &buf
 
 }
 
-static std::vector<unsigned short> createBuffer(struct i2c_desc *desc,
-						uint8_t *data,
-						uint8_t bytesNumber,
-						uint8_t option,
-						bool operation)
+std::vector<unsigned short> i2c_create_buffer(struct i2c_desc *desc,
+					      uint8_t *data,
+					      uint8_t bytesNumber,
+					      uint8_t option,
+					      bool operation)
 {
 	std::vector<unsigned short> bufferOut;
 	writeStartCondition(desc, bufferOut);
@@ -203,25 +206,21 @@ static std::vector<unsigned short> createBuffer(struct i2c_desc *desc,
 	return bufferOut;
 }
 
-static void processSamples(struct i2c_desc *desc,
-			   std::atomic<bool> &acquisition_started,
-			   std::vector<i2c_data> *data,
-			   uint8_t bytesNumber)
+static libm2k::utils::metrics::Histogram *transferMetric()
 {
-	auto *m2KI2CDesc = (m2k_i2c_desc *) desc->extra;
-	auto samplesPerBit = (unsigned int) (m2KI2CDesc->sample_rate / desc->max_speed_hz);
-	libm2k::M2kHardwareTrigger *trigger = m2KI2CDesc->digital->getTrigger();
-	trigger->setDigitalCondition(m2KI2CDesc->sda, libm2k::FALLING_EDGE_DIGITAL);
-	trigger->setDigitalDelay(-samplesPerCycle);
-
-	m2KI2CDesc->digital->startAcquisition((bytesNumber + 1) * 8 * samplesPerBit + bytesNumber *samplesPerBit);
-
-	acquisition_started = true;
-	std::vector<unsigned short> samples = m2KI2CDesc->digital->getSamples(
-		(bytesNumber + 1) * 8 * samplesPerBit + bytesNumber *samplesPerBit);
+	static libm2k::utils::metrics::Histogram *histogram =
+			libm2k::utils::metrics::get("i2c_transfer", "m2k-logic-analyzer");
+	return histogram;
+}
 
+static void decodeSamples(struct i2c_desc *desc,
+			  std::vector<i2c_data> *data,
+			  unsigned int bytesNumber,
+			  std::vector<unsigned short> &samples)
+{
+	auto *m2KI2CDesc = (m2k_i2c_desc *) desc->extra;
 	int cnt = 7;
-	int dataIndex = 0;
+	unsigned int dataIndex = 0;
 	bool started = false;
 
 	if (data->size() != bytesNumber) {
@@ -264,6 +263,79 @@ static void processSamples(struct i2c_desc *desc,
 	}
 }
 
+static unsigned int getNumberAddressBytes(uint8_t option)
+{
+	if (option & i2c_10_bit_transfer) {
+		return 2;
+	}
+	return 1;
+}
+
+static unsigned int getSamplesNumber(struct i2c_desc *desc, uint8_t bytesNumber, uint8_t option)
+{
+	auto *m2KI2CDesc = (m2k_i2c_desc *) desc->extra;
+	auto samplesPerBit = (unsigned int) (m2KI2CDesc->sample_rate / desc->max_speed_hz);
+	unsigned int totalNumberOfBytes = bytesNumber + getNumberAddressBytes(option);
+	return (totalNumberOfBytes + 1) * 8 * samplesPerBit + totalNumberOfBytes * samplesPerBit;
+}
+
+void i2c_process_samples(struct i2c_desc *desc,
+			 uint8_t *data,
+			 uint8_t bytesNumber,
+			 uint8_t option,
+			 bool operation,
+			 std::vector<unsigned short> &samples)
+{
+	unsigned int numberAddressBytes = getNumberAddressBytes(option);
+	unsigned int totalNumberOfBytes = bytesNumber + numberAddressBytes;
+	std::vector<i2c_data> i2c_data_vector(totalNumberOfBytes);
+
+	decodeSamples(desc, &i2c_data_vector, totalNumberOfBytes, samples);
+
+	//validate data
+	for (unsigned int i = 0; i < numberAddressBytes; ++i) {
+		if (i2c_data_vector[i].acknowledge) {
+			throw std::runtime_error("Unable to find slave device - invalid address\n");
+		}
+	}
+	if (operation) {
+		for (unsigned int i = numberAddressBytes; i < totalNumberOfBytes; ++i) {
+			data[i - numberAddressBytes] = i2c_data_vector[i].data;
+		}
+	} else {
+		for (unsigned int i = numberAddressBytes; i < bytesNumber; ++i) {
+			if (i2c_data_vector[i].acknowledge) {
+				throw std::runtime_error("Slave device is unable to receive the data\n");
+			}
+		}
+	}
+}
+
+static void transfer(struct i2c_desc *desc,
+		     const std::vector<unsigned short> &bufferOut,
+		     uint8_t *data,
+		     uint8_t bytesNumber,
+		     uint8_t option,
+		     bool operation)
+{
+	auto *m2KI2CDesc = (m2k_i2c_desc *) desc->extra;
+	unsigned int nbSamples = getSamplesNumber(desc, bytesNumber, option);
+	//another bus may have changed the sample rates since
+	updateSampleRateOut(m2KI2CDesc->digital, m2KI2CDesc->sample_rate);
+	updateSampleRateIn(m2KI2CDesc->digital, m2KI2CDesc->sample_rate);
+
+	libm2k::M2kHardwareTrigger *trigger = m2KI2CDesc->digital->getTrigger();
+	trigger->setDigitalCondition(m2KI2CDesc->sda, libm2k::FALLING_EDGE_DIGITAL);
+	trigger->setDigitalDelay(-samplesPerCycle);
+
+	//arm the capture before the start condition; the samples wait in the kernel buffer until they are read
+	m2KI2CDesc->digital->startAcquisition(nbSamples);
+	m2KI2CDesc->digital->push(bufferOut);
+
+	std::vector<unsigned short> samples = m2KI2CDesc->digital->getSamples(nbSamples);
+	i2c_process_samples(desc, data, bytesNumber, option, operation, samples);
+}
+
 int32_t i2c_init(struct i2c_desc **desc,
 		 const struct i2c_init_param *param)
 {
@@ -279,7 +351,7 @@ int32_t i2c_init(struct i2c_desc **desc,
 		m2KI2CDesc->digital->stopAcquisition();
 		m2KI2CDesc->digital->setKernelBuffersCountIn(1);
 
-		m2KI2CDesc->digital->setSampleRateIn(m2KI2CDesc->sample_rate);
+		updateSampleRateIn(m2KI2CDesc->digital, m2KI2CDesc->sample_rate);
 
 		libm2k::M2kHardwareTrigger *trigger = m2KI2CDesc->digital->getTrigger();
 		trigger->setDigitalCondition(m2KI2CDesc->scl, libm2k::NO_TRIGGER_DIGITAL);
@@ -313,47 +385,14 @@ int32_t i2c_write(struct i2c_desc *desc,
 		  uint8_t bytes_number,
 		  uint8_t option)
 {
+	libm2k::utils::metrics::Timer timer(transferMetric(), bytes_number);
 	try {
-		auto *m2KI2CDesc = (m2k_i2c_desc *) desc->extra;
-		unsigned int totalNumberOfBytes = 0;
-		if (option & i2c_10_bit_transfer) {
-			totalNumberOfBytes += bytes_number + 2;
-		} else {
-			totalNumberOfBytes += bytes_number + 1;
-		}
-		auto *i2c_data_vector = new std::vector<i2c_data>(totalNumberOfBytes);
-
-		std::atomic<bool> acquisition_started(false);
-		std::thread thread_read(processSamples, desc, std::ref(acquisition_started), i2c_data_vector, totalNumberOfBytes);
-
-		//make sure the reading thread is waiting
-		while (!acquisition_started.load()) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(2));
-		}
-
 		//create buffer
-		auto bufferOut = createBuffer(desc, data, bytes_number, option, false);
-		m2KI2CDesc->digital->push(bufferOut);
-		//process samples
-		thread_read.join();
-		//validate data
-		unsigned int numberAddressBytes = 0;
-		if (option & i2c_10_bit_transfer) {
-			numberAddressBytes = 2;
-		} else {
-			numberAddressBytes = 1;
-		}
-		for (unsigned int i = 0; i < numberAddressBytes; ++i) {
-			if ((*i2c_data_vector)[i].acknowledge) {
-				throw std::runtime_error("Unable to find slave device - invalid address\n");
-			}
-		}
-		for (unsigned int i = numberAddressBytes; i < bytes_number; ++i) {
-			if ((*i2c_data_vector)[i].acknowledge) {
-				throw std::runtime_error("Slave device is unable to receive the data\n");
-			}
-		}
+		auto bufferOut = i2c_create_buffer(desc, data, bytes_number, option, false);
+		//send it, process the captured samples and validate the acknowledges
+		transfer(desc, bufferOut, data, bytes_number, option, false);
 	} catch (std::exception &e) {
+		timer.setError(true);
 		std::cout << e.what();
 		return -1;
 	}
@@ -365,45 +404,14 @@ int32_t i2c_read(struct i2c_desc *desc,
 		 uint8_t bytes_number,
 		 uint8_t option)
 {
+	libm2k::utils::metrics::Timer timer(transferMetric(), bytes_number);
 	try {
-		auto *m2KI2CDesc = (m2k_i2c_desc *) desc->extra;
-		unsigned int totalNumberOfBytes = 0;
-		if (option & i2c_10_bit_transfer) {
-			totalNumberOfBytes += bytes_number + 2;
-		} else {
-			totalNumberOfBytes += bytes_number + 1;
-		}
-		auto *i2c_data_vector = new std::vector<i2c_data>(totalNumberOfBytes);
-
-		std::atomic<bool> acquisition_started(false);
-		std::thread thread_read(processSamples, desc, std::ref(acquisition_started), i2c_data_vector, totalNumberOfBytes);
-
-		//make sure the reading thread is waiting
-		while (!acquisition_started.load()) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(2));
-		}
-
 		//create buffer
-		auto bufferOut = createBuffer(desc, data, bytes_number, option, true);
-		m2KI2CDesc->digital->push(bufferOut);
-		//process samples
-		thread_read.join();
-		//validate data
-		unsigned int numberAddressBytes = 0;
-		if (option & i2c_10_bit_transfer) {
-			numberAddressBytes = 2;
-		} else {
-			numberAddressBytes = 1;
-		}
-		for (unsigned int i = 0; i < numberAddressBytes; ++i) {
-			if ((*i2c_data_vector)[i].acknowledge) {
-				throw std::runtime_error("Unable to find slave device - invalid address\n");
-			}
-		}
-		for (unsigned int i = numberAddressBytes; i < totalNumberOfBytes; ++i) {
-			data[i - numberAddressBytes] = (*i2c_data_vector)[i].data;
-		}
+		auto bufferOut = i2c_create_buffer(desc, data, bytes_number, option, true);
+		//send it and copy the received bytes into data
+		transfer(desc, bufferOut, data, bytes_number, option, true);
 	} catch (std::exception &e) {
+		timer.setError(true);
 		std::cout << e.what();
 		return -1;
 	}
@@ -419,8 +427,10 @@ int32_t i2c_init_write_only(struct i2c_desc **desc,
 		m2k_i2c_init *m2KI2CInit;
 
 		// initialize the attributes
-		unsigned int sampleRate = getValidSampleRate(param->max_speed_hz, samplesPerCycle);
-		i2cDesc->max_speed_hz = sampleRate / samplesPerCycle;
+		//the bits are encoded in quarters
+		SampleRatePlan plan = planSampleRate(param->max_speed_hz, samplesPerCycle, maxSamplesPerCycle, 4,
+						     maxSpeedError);
+		i2cDesc->max_speed_hz = plan.sampleRate / plan.samplesPerBit;
 		i2cDesc->slave_address = param->slave_address;
 
 		m2KI2CInit = (m2k_i2c_init *) param->extra;
@@ -429,10 +439,11 @@ int32_t i2c_init_write_only(struct i2c_desc **desc,
 		m2KI2CDesc->sda = m2KI2CInit->sda;
 		m2KI2CDesc->context = m2KI2CInit->context;
 		m2KI2CDesc->digital = m2KI2CDesc->context->getDigital();
-		m2KI2CDesc->sample_rate = sampleRate;
+		forgetSampleRates(m2KI2CDesc->digital);
+		m2KI2CDesc->sample_rate = plan.sampleRate;
 
 		//set sampling frequencies
-		m2KI2CDesc->digital->setSampleRateOut(m2KI2CDesc->sample_rate);
+		updateSampleRateOut(m2KI2CDesc->digital, m2KI2CDesc->sample_rate);
 
 		//enable the channels
 		setOutputChannel(m2KI2CDesc->scl, m2KI2CDesc->digital);
@@ -463,7 +474,8 @@ int32_t i2c_write_only(struct i2c_desc *desc,
 {
 	try {
 		auto *m2KI2CDesc = (m2k_i2c_desc *) desc->extra;
-		auto bufferOut = createBuffer(desc, data, bytes_number, option, false);
+		auto bufferOut = i2c_create_buffer(desc, data, bytes_number, option, false);
+		updateSampleRateOut(m2KI2CDesc->digital, m2KI2CDesc->sample_rate);
 		m2KI2CDesc->digital->push(bufferOut);
 	} catch (std::exception &e) {
 		std::cout << e.what();
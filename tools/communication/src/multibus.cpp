@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <libm2k/tools/multibus.hpp>
+#include <libm2k/tools/spi_extra.hpp>
+#include <libm2k/tools/i2c_extra.hpp>
+#include <libm2k/tools/uart_extra.hpp>
+#include "utils/util.h"
+#include "utils/codec.h"
+#include <libm2k/m2k.hpp>
+#include <libm2k/m2khardwaretrigger.hpp>
+#include "utils/metrics.hpp"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+//samples captured before the trigger, as for a single I2C transfer
+constexpr unsigned int pretriggerSamples = 4;
+
+typedef struct multibus_bus {
+	struct multibus_transfer *transfer;
+	libm2k::digital::M2kDigital *digital;
+	unsigned int tx_rate; //sample rate of the encoded waveform
+	unsigned int rx_rate; //sample rate expected by the decoder
+	unsigned short mask; //DIO pins used by the bus
+	unsigned int trigger_pin;
+	libm2k::M2K_TRIGGER_CONDITION_DIGITAL trigger_condition;
+	bool trigger_idle; //level of the trigger pin while the bus is idle
+	unsigned int rx_samples; //samples needed by the decoder, at rx_rate, besides the waveform
+	bool decode;
+	std::vector<unsigned short> waveform;
+} multibus_bus;
+
+
+static unsigned short getPinMask(unsigned int pin)
+{
+	unsigned short mask = 0;
+	setBit(mask, pin);
+	return mask;
+}
+
+static void createBus(struct multibus_transfer *transfer, multibus_bus &bus)
+{
+	bool read = (transfer->operation == MULTIBUS_READ);
+	if (!transfer->data && transfer->bytes_number) {
+		throw std::runtime_error("Invalid data buffer\n");
+	}
+	bus.transfer = transfer;
+	bus.trigger_condition = libm2k::NO_TRIGGER_DIGITAL;
+	bus.rx_samples = 0;
+	bus.decode = read;
+
+	switch (transfer->protocol) {
+	case MULTIBUS_SPI: {
+		if (!transfer->spi) {
+			throw std::runtime_error("Invalid SPI descriptor\n");
+		}
+		auto *m2KSpiDesc = (m2k_spi_desc *) transfer->spi->extra;
+		bus.digital = m2KSpiDesc->digital;
+		bus.tx_rate = m2KSpiDesc->sample_rate;
+		bus.rx_rate = m2KSpiDesc->sample_rate;
+		bus.mask = getPinMask(transfer->spi->chip_select) | getPinMask(m2KSpiDesc->clock) |
+			   getPinMask(m2KSpiDesc->mosi);
+		if (read) {
+			bus.mask |= getPinMask(m2KSpiDesc->miso);
+		}
+		bus.trigger_pin = transfer->spi->chip_select;
+		if (m2KSpiDesc->cs_polarity == ACTIVE_HIGH) {
+			bus.trigger_condition = libm2k::RISING_EDGE_DIGITAL;
+			bus.trigger_idle = false;
+		} else {
+			bus.trigger_condition = libm2k::FALLING_EDGE_DIGITAL;
+			bus.trigger_idle = true;
+		}
+		bus.waveform = spi_create_buffer(transfer->spi, transfer->data, transfer->bytes_number);
+		break;
+	}
+	case MULTIBUS_I2C: {
+		if (!transfer->i2c) {
+			throw std::runtime_error("Invalid I2C descriptor\n");
+		}
+		auto *m2KI2CDesc = (m2k_i2c_desc *) transfer->i2c->extra;
+		bus.digital = m2KI2CDesc->digital;
+		bus.tx_rate = m2KI2CDesc->sample_rate;
+		bus.rx_rate = m2KI2CDesc->sample_rate;
+		bus.mask = getPinMask(m2KI2CDesc->scl) | getPinMask(m2KI2CDesc->sda);
+		bus.trigger_pin = m2KI2CDesc->sda;
+		bus.trigger_condition = libm2k::FALLING_EDGE_DIGITAL;
+		bus.trigger_idle = true;
+		//writes are decoded as well, to validate the acknowledges
+		bus.decode = true;
+		bus.waveform = i2c_create_buffer(transfer->i2c, transfer->data, transfer->bytes_number,
+						 transfer->option, read);
+		break;
+	}
+	case MULTIBUS_UART: {
+		if (!transfer->uart) {
+			throw std::runtime_error("Invalid UART descriptor\n");
+		}
+		auto *m2KUartDesc = (m2k_uart_desc *) transfer->uart->extra;
+		bus.digital = m2KUartDesc->digital;
+		bus.tx_rate = m2KUartDesc->sample_rate;
+		bus.rx_rate = m2KUartDesc->sample_rate;
+		bus.mask = getPinMask(transfer->uart->device_id);
+		if (read) {
+			//the line is driven by the peripheral; nothing to transmit
+			bus.rx_samples = uart_get_samples_number(transfer->uart, transfer->bytes_number);
+		} else {
+			SampleRatePlan plan = uart_get_write_plan(transfer->uart);
+			bus.tx_rate = plan.sampleRate;
+			bus.trigger_pin = transfer->uart->device_id;
+			bus.trigger_condition = libm2k::FALLING_EDGE_DIGITAL;
+			bus.trigger_idle = true;
+			bus.waveform = uart_create_buffer(transfer->uart, transfer->data, transfer->bytes_number,
+							  plan.samplesPerBit);
+		}
+		break;
+	}
+	default:
+		throw std::runtime_error("Invalid protocol\n");
+	}
+}
+
+static std::vector<unsigned short> mergeWaveforms(std::vector<multibus_bus> &buses, unsigned int sampleRate)
+{
+	//each waveform is stretched to the common sample rate and holds its last sample once it ends
+	size_t length = 0;
+	for (auto &bus : buses) {
+		size_t busLength = (size_t) (((unsigned long long) bus.waveform.size() * sampleRate + bus.tx_rate - 1) / bus.tx_rate);
+		length = std::max(length, busLength);
+	}
+
+	std::vector<unsigned short> merged(length, 0);
+	for (auto &bus : buses) {
+		if (bus.waveform.empty()) {
+			continue;
+		}
+		for (size_t i = 0; i < length; ++i) {
+			auto index = (size_t) ((unsigned long long) i * bus.tx_rate / sampleRate);
+			if (index >= bus.waveform.size()) {
+				index = bus.waveform.size() - 1;
+			}
+			merged[i] |= (bus.waveform[index] & bus.mask);
+		}
+	}
+	return merged;
+}
+
+static std::vector<unsigned short> resampleCapture(const std::vector<unsigned short> &samples,
+						   unsigned int sampleRate, unsigned int busRate)
+{
+	auto length = (size_t) ((unsigned long long) samples.size() * busRate / sampleRate);
+	std::vector<unsigned short> busSamples(length);
+	for (size_t i = 0; i < length; ++i) {
+		busSamples[i] = samples[(size_t) ((unsigned long long) i * sampleRate / busRate)];
+	}
+	return busSamples;
+}
+
+static void decodeBus(multibus_bus &bus, std::vector<unsigned short> &samples)
+{
+	struct multibus_transfer *transfer = bus.transfer;
+	bool read = (transfer->operation == MULTIBUS_READ);
+
+	switch (transfer->protocol) {
+	case MULTIBUS_SPI:
+		spi_process_samples(transfer->spi, transfer->data, transfer->bytes_number, samples);
+		break;
+	case MULTIBUS_I2C:
+		i2c_process_samples(transfer->i2c, transfer->data, transfer->bytes_number, transfer->option,
+				    read, samples);
+		break;
+	case MULTIBUS_UART:
+		uart_process_samples(transfer->uart, transfer->data, transfer->bytes_number, samples);
+		break;
+	}
+}
+
+static libm2k::utils::metrics::Histogram *transferMetric()
+{
+	static libm2k::utils::metrics::Histogram *histogram =
+			libm2k::utils::metrics::get("multibus_transfer", "m2k-logic-analyzer");
+	return histogram;
+}
+
+int32_t multibus_run(struct multibus_transfer *transfers, uint8_t transfers_number)
+{
+	unsigned int bytesNumber = 0;
+	for (unsigned int i = 0; transfers && i < transfers_number; ++i) {
+		bytesNumber += transfers[i].bytes_number;
+		transfers[i].status = -1;
+	}
+	libm2k::utils::metrics::Timer timer(transferMetric(), bytesNumber);
+
+	libm2k::digital::M2kDigital *digital = nullptr;
+	double sampleRateIn = 0, sampleRateOut = 0;
+	std::vector<unsigned short> samples;
+	std::vector<multibus_bus> buses(transfers_number);
+
+	try {
+		if (!transfers || transfers_number == 0) {
+			throw std::runtime_error("No transfer to run\n");
+		}
+
+		//encode each bus and check that the buses can share the pattern generator
+		unsigned short usedPins = 0;
+		unsigned int sampleRate = 0;
+		for (unsigned int i = 0; i < transfers_number; ++i) {
+			createBus(&transfers[i], buses[i]);
+			if (digital && buses[i].digital != digital) {
+				throw std::runtime_error("The buses must be initialized on the same context\n");
+			}
+			if (usedPins & buses[i].mask) {
+				throw std::runtime_error("The buses must use different DIO pins\n");
+			}
+			digital = buses[i].digital;
+			usedPins |= buses[i].mask;
+			sampleRate = std::max(sampleRate, std::max(buses[i].tx_rate, buses[i].rx_rate));
+		}
+
+		std::vector<unsigned short> bufferOut = mergeWaveforms(buses, sampleRate);
+		size_t nbSamples = bufferOut.size();
+		for (auto &bus : buses) {
+			size_t busSamples = (size_t) ((unsigned long long) bus.rx_samples * sampleRate / bus.rx_rate);
+			nbSamples = std::max(nbSamples, busSamples);
+		}
+		nbSamples += pretriggerSamples;
+
+		//UART lines are not set by uart_init() for either direction
+		for (auto &bus : buses) {
+			if (bus.transfer->protocol != MULTIBUS_UART) {
+				continue;
+			}
+			if (bus.transfer->operation == MULTIBUS_READ) {
+				setInputChannel(bus.transfer->uart->device_id, digital);
+			} else {
+				setOutputChannel(bus.transfer->uart->device_id, digital);
+			}
+		}
+
+		//trigger on the first transition of the first bus which has one
+		libm2k::M2kHardwareTrigger *trigger = digital->getTrigger();
+		for (unsigned int pin = 0; pin < 16; ++pin) {
+			if (getBit(usedPins, pin)) {
+				trigger->setDigitalCondition(pin, libm2k::NO_TRIGGER_DIGITAL);
+			}
+		}
+		trigger->setDigitalMode(libm2k::digital::DIO_OR);
+		trigger->setDigitalDelay(0);
+		for (auto &bus : buses) {
+			if (bus.trigger_condition == libm2k::NO_TRIGGER_DIGITAL) {
+				continue;
+			}
+			size_t event = 0;
+			while (event < bufferOut.size() && getBit(bufferOut[event], bus.trigger_pin) == bus.trigger_idle) {
+				event++;
+			}
+			if (event == bufferOut.size()) {
+				continue;
+			}
+			trigger->setDigitalCondition(bus.trigger_pin, bus.trigger_condition);
+			trigger->setDigitalDelay(-(int) (event + pretriggerSamples));
+			break;
+		}
+
+		sampleRateIn = cachedSampleRateIn(digital);
+		sampleRateOut = cachedSampleRateOut(digital);
+		updateSampleRateIn(digital, sampleRate);
+		updateSampleRateOut(digital, sampleRate);
+
+		//arm the capture before the buses start; the samples wait in the kernel buffer until they are read
+		digital->startAcquisition(nbSamples);
+		digital->push(bufferOut);
+		samples = digital->getSamples(nbSamples);
+
+		//demultiplex the capture
+		for (auto &bus : buses) {
+			if (!bus.decode) {
+				bus.transfer->status = 0;
+				continue;
+			}
+			try {
+				std::vector<unsigned short> busSamples = resampleCapture(samples, sampleRate, bus.rx_rate);
+				decodeBus(bus, busSamples);
+				bus.transfer->status = 0;
+			} catch (std::exception &e) {
+				std::cout << e.what();
+			}
+		}
+	} catch (std::exception &e) {
+		std::cout << e.what();
+	}
+
+	//give the buses back the sample rates they were running at
+	if (sampleRateIn != 0) {
+		try {
+			updateSampleRateIn(digital, sampleRateIn);
+			updateSampleRateOut(digital, sampleRateOut);
+		} catch (std::exception &e) {
+			std::cout << e.what();
+		}
+	}
+
+	bool failed = (!transfers || transfers_number == 0);
+	for (unsigned int i = 0; transfers && i < transfers_number; ++i) {
+		failed = failed || (transfers[i].status != 0);
+	}
+	if (failed) {
+		timer.setError(true);
+		return -1;
+	}
+	return 0;
+}
@@ -39,13 +39,16 @@
 #include <libm2k/tools/spi.hpp>
 #include <libm2k/tools/spi_extra.hpp>
 #include "utils/util.h"
+#include "utils/codec.h"
 #include <libm2k/m2k.hpp>
 #include <libm2k/contextbuilder.hpp>
 #include <libm2k/m2khardwaretrigger.hpp>
-#include <thread>
-#include <atomic>
+#include "utils/metrics.hpp"
 
 constexpr unsigned int samplesPerCycle = 4;
+//more samples per cycle are used only when the clock would otherwise run over 10% slower than requested
+constexpr unsigned int maxSamplesPerCycle = 64;
+constexpr double maxSpeedError = 0.1;
 
 
 std::vector<unsigned short> spi_create_buffer(struct spi_desc *desc,
@@ -151,10 +154,10 @@ std::vector<unsigned short> spi_create_buffer(struct spi_desc *desc,
 	return bufferOut;
 }
 
-static void processSamples(struct spi_desc *desc,
-			   uint8_t *data,
-			   uint8_t bytesNumber,
-			   std::vector<unsigned short> &samples)
+void spi_process_samples(struct spi_desc *desc,
+			 uint8_t *data,
+			 uint8_t bytesNumber,
+			 std::vector<unsigned short> &samples)
 {
 	auto *m2KSpiDesc = (m2k_spi_desc *) desc->extra;
 	int cnt = 0;
@@ -205,13 +208,25 @@ static void processSamples(struct spi_desc *desc,
 	}
 }
 
-static void read(struct spi_desc *desc,
-		 std::atomic<bool> &acquisition_started,
-		 uint8_t *data,
-		 uint8_t bytes_number)
+static libm2k::utils::metrics::Histogram *transferMetric()
+{
+	static libm2k::utils::metrics::Histogram *histogram =
+			libm2k::utils::metrics::get("spi_transfer", "m2k-logic-analyzer");
+	return histogram;
+}
+
+static void transfer(struct spi_desc *desc,
+		     const std::vector<unsigned short> &bufferOut,
+		     uint8_t *data,
+		     uint8_t bytes_number)
 {
 	auto *m2KSpiDesc = (m2k_spi_desc *) desc->extra;
 	auto samplesPerBit = (unsigned int) (m2KSpiDesc->sample_rate / desc->max_speed_hz);
+	unsigned int nbSamples = (bytes_number + 1) * samplesPerBit * 8;
+
+	//another bus may have changed the sample rates since
+	updateSampleRateOut(m2KSpiDesc->digital, m2KSpiDesc->sample_rate);
+	updateSampleRateIn(m2KSpiDesc->digital, m2KSpiDesc->sample_rate);
 
 	//set the trigger on CS
 	libm2k::M2kHardwareTrigger *trigger = m2KSpiDesc->digital->getTrigger();
@@ -222,14 +237,15 @@ static void read(struct spi_desc *desc,
 		trigger->setDigitalCondition(desc->chip_select, libm2k::FALLING_EDGE_DIGITAL);
 	}
 
-	m2KSpiDesc->digital->startAcquisition((bytes_number + 1) * samplesPerBit * 8);
+	//arm the capture before CS toggles; the samples wait in the kernel buffer until they are read
+	m2KSpiDesc->digital->startAcquisition(nbSamples);
+	m2KSpiDesc->digital->push(bufferOut);
 
 	//capture samples
-	acquisition_started = true;
-	std::vector<unsigned short> samples = m2KSpiDesc->digital->getSamples((bytes_number + 1) * samplesPerBit * 8);
+	std::vector<unsigned short> samples = m2KSpiDesc->digital->getSamples(nbSamples);
 
 	//process samples
-	processSamples(desc, data, bytes_number, samples);
+	spi_process_samples(desc, data, bytes_number, samples);
 }
 
 int32_t spi_init(struct spi_desc **desc,
@@ -247,7 +263,7 @@ int32_t spi_init(struct spi_desc **desc,
 		m2KSpiDesc->miso = m2KSpiInit->miso;
 		m2KSpiDesc->digital->stopAcquisition();
 		m2KSpiDesc->digital->setKernelBuffersCountIn(1);
-		m2KSpiDesc->digital->setSampleRateIn(m2KSpiDesc->sample_rate);
+		updateSampleRateIn(m2KSpiDesc->digital, m2KSpiDesc->sample_rate);
 		setInputChannel(m2KSpiDesc->miso, m2KSpiDesc->digital);
 		m2KSpiDesc->digital->setOutputMode(m2KSpiDesc->miso, libm2k::digital::DIO_PUSHPULL);
 
@@ -285,21 +301,12 @@ int32_t spi_write_and_read(struct spi_desc *desc,
 			   uint8_t *data,
 			   uint8_t bytes_number)
 {
+	libm2k::utils::metrics::Timer timer(transferMetric(), bytes_number);
 	try {
-		auto *m2KSpiDesc = (m2k_spi_desc *) desc->extra;
-		//start reading - wait until buffer is pushed
-		std::atomic<bool> acquisition_started(false);
-		std::thread thread_read(read, desc, std::ref(acquisition_started), data, bytes_number);
-
-		//make sure the reading thread is waiting
-		while (!acquisition_started.load()) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(2));
-		}
-
 		std::vector<unsigned short> buffer = spi_create_buffer(desc, data, bytes_number);
-		m2KSpiDesc->digital->push(buffer);
-		thread_read.join();
+		transfer(desc, buffer, data, bytes_number);
 	} catch (std::exception &e) {
+		timer.setError(true);
 		std::cout << e.what();
 		return -1;
 	}
@@ -315,8 +322,9 @@ int32_t spi_init_write_only(struct spi_desc **desc,
 		m2k_spi_init *m2KSpiInit;
 
 		// initialize the attributes
-		unsigned int sampleRate = getValidSampleRate(param->max_speed_hz, samplesPerCycle);
-		spiDesc->max_speed_hz = sampleRate / samplesPerCycle;
+		SampleRatePlan plan = planSampleRate(param->max_speed_hz, samplesPerCycle, maxSamplesPerCycle, 2,
+						     maxSpeedError);
+		spiDesc->max_speed_hz = plan.sampleRate / plan.samplesPerBit;
 		spiDesc->mode = param->mode;
 		spiDesc->chip_select = param->chip_select;
 
@@ -328,10 +336,11 @@ int32_t spi_init_write_only(struct spi_desc **desc,
 		m2KSpiDesc->cs_polarity = m2KSpiInit->cs_polarity;
 		m2KSpiDesc->context = m2KSpiInit->context;
 		m2KSpiDesc->digital = m2KSpiDesc->context->getDigital();
-		m2KSpiDesc->sample_rate = sampleRate;
+		forgetSampleRates(m2KSpiDesc->digital);
+		m2KSpiDesc->sample_rate = plan.sampleRate;
 
 		//set sampling frequencies
-		m2KSpiDesc->digital->setSampleRateOut(m2KSpiDesc->sample_rate);
+		updateSampleRateOut(m2KSpiDesc->digital, m2KSpiDesc->sample_rate);
 
 		//enable the channels
 		setOutputChannel(spiDesc->chip_select, m2KSpiDesc->digital);
@@ -374,6 +383,7 @@ int32_t spi_write_only(struct spi_desc *desc,
 	try {
 		auto *m2KSpiDesc = (m2k_spi_desc *) desc->extra;
 		std::vector<unsigned short> buffer = spi_create_buffer(desc, data, bytes_number);
+		updateSampleRateOut(m2KSpiDesc->digital, m2KSpiDesc->sample_rate);
 		m2KSpiDesc->digital->push(buffer);
 	} catch (std::exception &e) {
 		std::cout << e.what();
@@ -385,19 +395,11 @@ int32_t spi_write_only(struct spi_desc *desc,
 int32_t spi_write_and_read_samples(struct spi_desc *desc, std::vector<unsigned short> samples,
 	uint8_t *data, uint8_t bytes_number)
 {
+	libm2k::utils::metrics::Timer timer(transferMetric(), bytes_number);
 	try {
-		auto *m2KSpiDesc = (m2k_spi_desc *) desc->extra;
-		std::atomic<bool> acquisition_started(false);
-		std::thread thread_read(read, desc, std::ref(acquisition_started), data, bytes_number);
-
-		//make sure the reading thread is waiting
-		while (!acquisition_started.load()) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(2));
-		}
-
-		m2KSpiDesc->digital->push(samples);
-		thread_read.join();
+		transfer(desc, samples, data, bytes_number);
 	} catch (std::exception &e) {
+		timer.setError(true);
 		std::cout << e.what();
 		return -1;
 	}
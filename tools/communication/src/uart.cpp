@@ -33,6 +33,7 @@
 #include <libm2k/tools/uart.hpp>
 #include <libm2k/tools/uart_extra.hpp>
 #include "utils/util.h"
+#include "utils/codec.h"
 #include <libm2k/m2k.hpp>
 #include <libm2k/contextbuilder.hpp>
 #include <libm2k/m2khardwaretrigger.hpp>
@@ -40,6 +41,9 @@
 
 
 constexpr unsigned int samplesPerCycle = 8;
+//the transmitted bits are stretched only when the baud rate would otherwise be over 2% off
+constexpr unsigned int maxSamplesPerCycle = 64;
+constexpr double maxBaudRateError = 0.02;
 
 static bool getParityBit(struct uart_desc *desc, uint8_t byte)
 {
@@ -59,17 +63,45 @@ static bool getParityBit(struct uart_desc *desc, uint8_t byte)
 
 }
 
-static void processSamples(struct uart_desc *desc,
-			   uint8_t *data,
-			   uint8_t bytesNumber,
-			   std::vector<unsigned short> &samples)
+static unsigned int getFrameSamples(struct uart_desc *desc)
+{
+	auto *m2KUartDesc = (m2k_uart_desc *) desc->extra;
+	//start and data bits
+	unsigned int nbBits = 1 + m2KUartDesc->bits_number;
+	//parity
+	if (m2KUartDesc->parity != NO_PARITY) {
+		nbBits++;
+	}
+	//stop bits are counted in half bits
+	return nbBits * samplesPerCycle + (samplesPerCycle / 2) * m2KUartDesc->stop_bits;
+}
+
+unsigned int uart_get_samples_number(struct uart_desc *desc, uint32_t bytesNumber)
+{
+	return bytesNumber * getFrameSamples(desc);
+}
+
+void uart_process_samples(struct uart_desc *desc,
+			  uint8_t *data,
+			  uint32_t bytesNumber,
+			  std::vector<unsigned short> &samples)
 {
 	auto *m2KUartDesc = (m2k_uart_desc *) desc->extra;
 	unsigned int currentIndex = 0;
-	for (int i = 0; i < bytesNumber; ++i) {
-		while (getBit(samples[currentIndex], desc->device_id)) {
+	size_t nbSamples = samples.size();
+	//getAverageValue() looks past the bit it averages; pad the end with idle samples
+	unsigned short idle = 0;
+	setBit(idle, desc->device_id);
+	samples.resize(nbSamples + getFrameSamples(desc), idle);
+
+	for (unsigned int i = 0; i < bytesNumber; ++i) {
+		while (currentIndex < nbSamples && getBit(samples[currentIndex], desc->device_id)) {
 			currentIndex++;
 		}
+		//allow the stop bits to end up to one bit past the capture
+		if (currentIndex + getFrameSamples(desc) > nbSamples + samplesPerCycle) {
+			throw std::runtime_error("Not enough samples to decode the UART frame\n");
+		}
 		//start
 		if (getAverageValue(samples, currentIndex, samplesPerCycle, desc->device_id)) {
 			m2KUartDesc->total_error_count++;
@@ -93,6 +125,64 @@ static void processSamples(struct uart_desc *desc,
 	}
 }
 
+SampleRatePlan uart_get_write_plan(struct uart_desc *desc)
+{
+	//stop bits are written in half bits
+	return planSampleRate(desc->baud_rate, samplesPerCycle, maxSamplesPerCycle, 2, maxBaudRateError);
+}
+
+std::vector<unsigned short> uart_create_buffer(struct uart_desc *desc,
+					       const uint8_t *data,
+					       uint32_t bytesNumber,
+					       unsigned int samplesPerBit)
+{
+	auto *m2KUartDesc = (m2k_uart_desc *) desc->extra;
+	std::vector<unsigned short> bufferOut;
+
+	for (unsigned int i = 0; i < bytesNumber; ++i) {
+
+		//start
+		for (unsigned int j = 0; j < samplesPerBit; ++j) {
+			unsigned short sample = 0;
+			setBit(sample, desc->device_id);
+			bufferOut.push_back(sample);
+		}
+		for (unsigned int j = 0; j < samplesPerBit; ++j) {
+			bufferOut.push_back(0);
+		}
+
+		//data
+		for (unsigned int j = 0; j < m2KUartDesc->bits_number; ++j) {
+			for (unsigned int k = 0; k < samplesPerBit; ++k) {
+				unsigned short sample = 0;
+				if (getBit(data[i], j)) {
+					setBit(sample, desc->device_id);
+				}
+				bufferOut.push_back(sample);
+			}
+		}
+		//parity
+		if (m2KUartDesc->parity != NO_PARITY) {
+			for (unsigned int j = 0; j < samplesPerBit; ++j) {
+				unsigned short sample = 0;
+				if (getParityBit(desc, data[i])) {
+					setBit(sample, desc->device_id);
+				}
+				bufferOut.push_back(sample);
+			}
+		}
+		//stop bits
+		for (unsigned int j = 0; j < m2KUartDesc->stop_bits; ++j) {
+			for (unsigned int k = 0; k < samplesPerBit / 2; ++k) {
+				unsigned short sample = 0;
+				setBit(sample, desc->device_id);
+				bufferOut.push_back(sample);
+			}
+		}
+	}
+	return bufferOut;
+}
+
 int32_t uart_init(struct uart_desc **desc, const struct uart_init_param *param)
 {
 	try {
@@ -101,7 +191,9 @@ int32_t uart_init(struct uart_desc **desc, const struct uart_init_param *param)
 		m2k_uart_init *m2KUartInit;
 
 		// initialize the attributes
-		unsigned int sampleRate = getValidSampleRate(param->baud_rate, samplesPerCycle);
+		//the receiver decodes exactly samplesPerCycle samples per bit
+		SampleRatePlan plan = planSampleRate(param->baud_rate, samplesPerCycle, samplesPerCycle, 1,
+						     maxBaudRateError);
 		uartDesc->baud_rate = param->baud_rate;
 		uartDesc->device_id = param->device_id;
 
@@ -115,15 +207,16 @@ int32_t uart_init(struct uart_desc **desc, const struct uart_init_param *param)
 		m2KUartDesc->stop_bits = m2KUartInit->stop_bits;
 		m2KUartDesc->context = m2KUartInit->context;
 		m2KUartDesc->digital = m2KUartDesc->context->getDigital();
-		m2KUartDesc->sample_rate = sampleRate;
+		forgetSampleRates(m2KUartDesc->digital);
+		m2KUartDesc->sample_rate = plan.sampleRate;
 		m2KUartDesc->total_error_count = 0;
 
 		m2KUartDesc->digital->stopAcquisition();
 		m2KUartDesc->digital->setKernelBuffersCountIn(1);
 
 		//set sampling frequencies
-		m2KUartDesc->digital->setSampleRateOut(m2KUartDesc->sample_rate);
-		m2KUartDesc->digital->setSampleRateIn(m2KUartDesc->sample_rate);
+		updateSampleRateOut(m2KUartDesc->digital, m2KUartDesc->sample_rate);
+		updateSampleRateIn(m2KUartDesc->digital, m2KUartDesc->sample_rate);
 
 		//enable the channels
 		m2KUartDesc->digital->setOutputMode(uartDesc->device_id, libm2k::digital::DIO_PUSHPULL);
@@ -167,23 +260,14 @@ int32_t uart_read(struct uart_desc *desc, uint8_t *data, uint32_t bytes_number)
 {
 	try {
 		auto *m2KUartDesc = (m2k_uart_desc *) desc->extra;
-		desc->baud_rate = m2KUartDesc->sample_rate / samplesPerCycle;
-		auto samplesPerBit = (unsigned int) (m2KUartDesc->sample_rate / desc->baud_rate);
+		unsigned int nb_samples = uart_get_samples_number(desc, bytes_number);
 
-		//start
-		unsigned int nb_samples = samplesPerBit;
-		//data size
-		nb_samples += samplesPerBit * (bytes_number * m2KUartDesc->bits_number);
-		//stop
-		nb_samples += samplesPerBit/2 * m2KUartDesc->stop_bits;
-		//parity
-		if (m2KUartDesc->parity != NO_PARITY) {
-			nb_samples += samplesPerBit;
-		}
+		//another bus may have changed the sample rate since
+		updateSampleRateIn(m2KUartDesc->digital, m2KUartDesc->sample_rate);
 
 		//capture samples
 		std::vector<unsigned short> samples = m2KUartDesc->digital->getSamples(nb_samples);
-		processSamples(desc, data, bytes_number, samples);
+		uart_process_samples(desc, data, bytes_number, samples);
 
 	} catch (std::exception &e){
 		std::cout << e.what();
@@ -197,55 +281,12 @@ int32_t uart_write(struct uart_desc *desc, const uint8_t *data,
 {
 	try {
 		auto *m2KUartDesc = (m2k_uart_desc *) desc->extra;
-		double sampleRate = 10000000;
-		m2KUartDesc->sample_rate = sampleRate;
-		m2KUartDesc->digital->setSampleRateOut(sampleRate);
+		SampleRatePlan plan = uart_get_write_plan(desc);
+		updateSampleRateOut(m2KUartDesc->digital, plan.sampleRate);
 
-		std::vector<unsigned short> bufferOut;
-		auto samplesPerBit = (unsigned int) (m2KUartDesc->sample_rate / desc->baud_rate);
 		setOutputChannel(desc->device_id, m2KUartDesc->digital);
 
-		for (unsigned int i = 0; i < bytes_number; ++i) {
-
-			//start
-			for (unsigned int j = 0; j < samplesPerBit; ++j) {
-				unsigned short sample = 0;
-				setBit(sample, desc->device_id);
-				bufferOut.push_back(sample);
-			}
-			for (unsigned int j = 0; j < samplesPerBit; ++j) {
-				bufferOut.push_back(0);
-			}
-
-			//data
-			for (unsigned int j = 0; j < m2KUartDesc->bits_number; ++j) {
-				for (unsigned int k = 0; k < samplesPerBit; ++k) {
-					unsigned short sample = 0;
-					if (getBit(data[i], j)) {
-						setBit(sample, desc->device_id);
-					}
-					bufferOut.push_back(sample);
-				}
-			}
-			//parity
-			if (m2KUartDesc->parity != NO_PARITY) {
-				for (unsigned int j = 0; j < samplesPerBit; ++j) {
-					unsigned short sample = 0;
-					if (getParityBit(desc, data[i])) {
-						setBit(sample, desc->device_id);
-					}
-					bufferOut.push_back(sample);
-				}
-			}
-			//stop bits
-			for (unsigned int j = 0; j < m2KUartDesc->stop_bits; ++j) {
-				for (unsigned int k = 0; k < samplesPerBit / 2; ++k) {
-					unsigned short sample = 0;
-					setBit(sample, desc->device_id);
-					bufferOut.push_back(sample);
-				}
-			}
-		}
+		std::vector<unsigned short> bufferOut = uart_create_buffer(desc, data, bytes_number, plan.samplesPerBit);
 		m2KUartDesc->digital->push(bufferOut);
 	} catch (std::exception &e) {
 		std::cout << e.what();
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Analog Devices Inc.
+ *
+ * This file is part of libm2k
+ * (see http://www.github.com/analogdevicesinc/libm2k).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef LIBM2K_CODEC_H
+#define LIBM2K_CODEC_H
+
+#include <libm2k/tools/spi.hpp>
+#include <libm2k/tools/spi_extra.hpp>
+#include <libm2k/tools/i2c.hpp>
+#include <libm2k/tools/uart.hpp>
+#include "util.h"
+#include <vector>
+
+/*
+ * Waveform encoders and decoders of the communication protocols. The
+ * samples are 16-bit DIO words at the sample rate of the descriptor and
+ * each protocol only touches the bits of its own pins, which lets the
+ * multi-bus scheduler merge several buses into the same buffer.
+ */
+
+/* spi_create_buffer() is declared in spi_extra.hpp */
+
+void spi_process_samples(struct spi_desc *desc, uint8_t *data, uint8_t bytesNumber,
+			 std::vector<unsigned short> &samples);
+
+std::vector<unsigned short> i2c_create_buffer(struct i2c_desc *desc, uint8_t *data, uint8_t bytesNumber,
+					      uint8_t option, bool operation);
+
+void i2c_process_samples(struct i2c_desc *desc, uint8_t *data, uint8_t bytesNumber, uint8_t option,
+			 bool operation, std::vector<unsigned short> &samples);
+
+SampleRatePlan uart_get_write_plan(struct uart_desc *desc);
+
+std::vector<unsigned short> uart_create_buffer(struct uart_desc *desc, const uint8_t *data, uint32_t bytesNumber,
+					       unsigned int samplesPerBit);
+
+void uart_process_samples(struct uart_desc *desc, uint8_t *data, uint32_t bytesNumber,
+			  std::vector<unsigned short> &samples);
+
+unsigned int uart_get_samples_number(struct uart_desc *desc, uint32_t bytesNumber);
+
+
+#endif //LIBM2K_CODEC_H
@@ -22,6 +22,10 @@
 
 #include "util.h"
 #include <libm2k/digital/m2kdigital.hpp>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
 
 
 void setOutputChannel(unsigned int channelIndex, libm2k::digital::M2kDigital *m2KDigital)
@@ -36,30 +40,93 @@ void setInputChannel(unsigned int channelIndex, libm2k::digital::M2kDigital *m2K
 	m2KDigital->enableChannel(channelIndex, true);
 }
 
-unsigned int getValidSampleRate(unsigned int frequency, unsigned int samplesPerCycle)
+SampleRatePlan planSampleRate(unsigned int frequency, unsigned int minSamplesPerBit,
+			      unsigned int maxSamplesPerBit, unsigned int stepSamplesPerBit, double maxError)
 {
-	unsigned int maxSampleRate = 100000000;
-	if (frequency >= maxSampleRate) {
-		return maxSampleRate;
+	//the digital sample rates are obtained by dividing this clock by an integer
+	const unsigned int maxSampleRate = 100000000;
+	if (frequency == 0) {
+		throw std::runtime_error("Invalid bus frequency\n");
 	}
-	unsigned int tempSampleRate = frequency * samplesPerCycle;
-	unsigned int sampleRateOut = maxSampleRate;
-	unsigned int pow2 = 1, pow5;
-	for (int i = 1; i <= 8; ++i) {
-		pow2 *= 2;
-		pow5 = 1;
-		for (int j = 0; j <= 8; ++j) {
-			unsigned int divisor = pow2 * pow5;
-
-			unsigned int distance = (divisor > tempSampleRate) ? divisor - tempSampleRate : tempSampleRate -divisor;
-			if (distance < maxSampleRate) {
-				maxSampleRate = distance;
-				sampleRateOut = divisor;
-			}
-			pow5 *= 5;
+
+	SampleRatePlan best = {maxSampleRate, minSamplesPerBit, 1.0};
+	for (unsigned int samplesPerBit = minSamplesPerBit; samplesPerBit <= maxSamplesPerBit;
+	     samplesPerBit += stepSamplesPerBit) {
+		//round the divider up, so the bus never runs faster than requested
+		unsigned long long bitDivider = (unsigned long long) frequency * samplesPerBit;
+		unsigned long long divider = (maxSampleRate + bitDivider - 1) / bitDivider;
+		double error = 1 - (double) maxSampleRate / (divider * bitDivider);
+		SampleRatePlan plan = {(unsigned int) (maxSampleRate / divider), samplesPerBit, error};
+
+		//the first accurate enough rate is the lowest one
+		if (error <= maxError) {
+			return plan;
 		}
+		if (error < best.error) {
+			best = plan;
+		}
+	}
+	return best;
+}
+
+//the sample rates last read or written by the buses, so a transfer does not read them back from the device
+static std::mutex sampleRatesLock;
+static std::map<libm2k::digital::M2kDigital *, double> sampleRatesIn;
+static std::map<libm2k::digital::M2kDigital *, double> sampleRatesOut;
+
+static double cachedSampleRate(std::map<libm2k::digital::M2kDigital *, double> &cache,
+			       libm2k::digital::M2kDigital *m2KDigital,
+			       double (libm2k::digital::M2kDigital::*getSampleRate)())
+{
+	auto it = cache.find(m2KDigital);
+	if (it == cache.end()) {
+		it = cache.emplace(m2KDigital, (m2KDigital->*getSampleRate)()).first;
 	}
-	return sampleRateOut;
+	return it->second;
+}
+
+static void updateSampleRate(std::map<libm2k::digital::M2kDigital *, double> &cache,
+			     libm2k::digital::M2kDigital *m2KDigital,
+			     double (libm2k::digital::M2kDigital::*getSampleRate)(),
+			     double (libm2k::digital::M2kDigital::*setSampleRate)(double),
+			     double sampleRate)
+{
+	if (std::fabs(cachedSampleRate(cache, m2KDigital, getSampleRate) - sampleRate) >= 1) {
+		cache[m2KDigital] = (m2KDigital->*setSampleRate)(sampleRate);
+	}
+}
+
+double cachedSampleRateIn(libm2k::digital::M2kDigital *m2KDigital)
+{
+	std::lock_guard<std::mutex> lock(sampleRatesLock);
+	return cachedSampleRate(sampleRatesIn, m2KDigital, &libm2k::digital::M2kDigital::getSampleRateIn);
+}
+
+double cachedSampleRateOut(libm2k::digital::M2kDigital *m2KDigital)
+{
+	std::lock_guard<std::mutex> lock(sampleRatesLock);
+	return cachedSampleRate(sampleRatesOut, m2KDigital, &libm2k::digital::M2kDigital::getSampleRateOut);
+}
+
+void updateSampleRateIn(libm2k::digital::M2kDigital *m2KDigital, double sampleRate)
+{
+	std::lock_guard<std::mutex> lock(sampleRatesLock);
+	updateSampleRate(sampleRatesIn, m2KDigital, &libm2k::digital::M2kDigital::getSampleRateIn,
+			 &libm2k::digital::M2kDigital::setSampleRateIn, sampleRate);
+}
+
+void updateSampleRateOut(libm2k::digital::M2kDigital *m2KDigital, double sampleRate)
+{
+	std::lock_guard<std::mutex> lock(sampleRatesLock);
+	updateSampleRate(sampleRatesOut, m2KDigital, &libm2k::digital::M2kDigital::getSampleRateOut,
+			 &libm2k::digital::M2kDigital::setSampleRateOut, sampleRate);
+}
+
+void forgetSampleRates(libm2k::digital::M2kDigital *m2KDigital)
+{
+	std::lock_guard<std::mutex> lock(sampleRatesLock);
+	sampleRatesIn.erase(m2KDigital);
+	sampleRatesOut.erase(m2KDigital);
 }
 
 bool getAverageValue(std::vector<unsigned short> &samples, unsigned int &start, unsigned int numberOfSamples,
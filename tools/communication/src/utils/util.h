@@ -29,7 +29,36 @@ void setOutputChannel(unsigned int channelIndex, libm2k::digital::M2kDigital *m2
 
 void setInputChannel(unsigned int channelIndex, libm2k::digital::M2kDigital *m2KDigital);
 
-unsigned int getValidSampleRate(unsigned int frequency, unsigned int samplesPerCycle);
+typedef struct SampleRatePlan {
+	unsigned int sampleRate;
+	unsigned int samplesPerBit;
+	double error; //how much slower than requested the bus runs, relative to its frequency
+} SampleRatePlan;
+
+/*
+ * Lowest digital sample rate for a bus running at frequency, with at least
+ * minSamplesPerBit samples per bit. The samples per bit are increased by
+ * stepSamplesPerBit, up to maxSamplesPerBit, until the bus runs at most
+ * maxError slower than requested; otherwise the most accurate rate is used.
+ */
+SampleRatePlan planSampleRate(unsigned int frequency, unsigned int minSamplesPerBit,
+			      unsigned int maxSamplesPerBit, unsigned int stepSamplesPerBit, double maxError);
+
+/*
+ * The digital sample rates are cached per device: they are read once, then
+ * only written when a bus needs a different rate. The init functions call
+ * forgetSampleRates(), so a rate changed outside the buses is read again.
+ */
+double cachedSampleRateIn(libm2k::digital::M2kDigital *m2KDigital);
+
+double cachedSampleRateOut(libm2k::digital::M2kDigital *m2KDigital);
+
+//set the sample rate only if the device runs at a different one
+void updateSampleRateIn(libm2k::digital::M2kDigital *m2KDigital, double sampleRate);
+
+void updateSampleRateOut(libm2k::digital::M2kDigital *m2KDigital, double sampleRate);
+
+void forgetSampleRates(libm2k::digital::M2kDigital *m2KDigital);
 
 bool getAverageValue(std::vector<unsigned short> &samples, unsigned int &start, unsigned int numberOfSamples,
 		     unsigned int bitIndex);